@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/LzsFile.h"
+#include "data/VGearsLZSDataStream.h"
+
+/**
+ * Generates text-like data, similar to field dialogs and scripts.
+ *
+ * @param[in] size Size of the data, in bytes.
+ * @return The generated data.
+ */
+static std::vector<VGears::uint8> GenerateText(const size_t size){
+    std::mt19937 random(1);
+    const std::string words[] = {
+      "Cloud ", "Tifa ", "Barret ", "script ", "entity ", "walkmesh ", "background ", "the ",
+      "of ", "and ", "{NEW}\n", "..."
+    };
+    std::vector<VGears::uint8> data;
+    data.reserve(size);
+    while (data.size() < size)
+        for (char c : words[random() % 12]) data.push_back(static_cast<VGears::uint8>(c));
+    data.resize(size);
+    return data;
+}
+
+/**
+ * Generates structured binary data, similar to field walkmeshes and backgrounds.
+ *
+ * Records of 16-bit coordinates that change slowly, with some noise.
+ *
+ * @param[in] size Size of the data, in bytes.
+ * @return The generated data.
+ */
+static std::vector<VGears::uint8> GenerateRecords(const size_t size){
+    std::mt19937 random(2);
+    std::vector<VGears::uint8> data;
+    data.reserve(size);
+    int x = 0, y = 0, z = 0;
+    while (data.size() < size){
+        x += static_cast<int>(random() % 5) - 2;
+        y += static_cast<int>(random() % 3) - 1;
+        z += static_cast<int>(random() % 9) - 4;
+        for (int value : {x, y, z, 0}){
+            data.push_back(static_cast<VGears::uint8>(value & 0xFF));
+            data.push_back(static_cast<VGears::uint8>((value >> 8) & 0xFF));
+        }
+    }
+    data.resize(size);
+    return data;
+}
+
+/**
+ * Generates random, incompressible, data.
+ *
+ * @param[in] size Size of the data, in bytes.
+ * @return The generated data.
+ */
+static std::vector<VGears::uint8> GenerateNoise(const size_t size){
+    std::mt19937 random(3);
+    std::vector<VGears::uint8> data(size);
+    for (VGears::uint8& byte : data) byte = static_cast<VGears::uint8>(random());
+    return data;
+}
+
+/**
+ * Runs a function repeatedly and measures it.
+ *
+ * @param[in] bytes Bytes processed on each run.
+ * @param[in] function The function to measure.
+ * @return Throughput, in MB/s.
+ */
+template<typename Function> static double Measure(const size_t bytes, Function function){
+    const int runs = 5;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r ++) function();
+    const double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+    return (bytes * runs) / seconds / (1024.0 * 1024.0);
+}
+
+/**
+ * LZS benchmark main function.
+ *
+ * Compresses synthetic data, and any file passed as argument, with each compression mode, and
+ * reports compression ratio, compression throughput, and decompression throughput with
+ * {@see LzsBuffer} and {@see VGears::LZSDataStream}.
+ *
+ * @param[in] argc Number of arguments passed to the application.
+ * @param[in] argv Paths to additional uncompressed files to benchmark.
+ * @return The application return code. 0 is OK, 1 if any round trip fails.
+ */
+int main(int argc, char *argv[]){
+    const size_t size = 4 * 1024 * 1024;
+    std::vector<std::pair<std::string, std::vector<VGears::uint8>>> inputs = {
+      {"text", GenerateText(size)},
+      {"records", GenerateRecords(size)},
+      {"noise", GenerateNoise(size)}
+    };
+    for (int a = 1; a < argc; a ++){
+        std::ifstream file(argv[a], std::ios::binary);
+        inputs.push_back(std::make_pair(std::string(argv[a]), std::vector<VGears::uint8>(
+          (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()
+        )));
+    }
+
+    const std::pair<std::string, LzsBuffer::CompressionMode> modes[] = {
+      {"greedy", LzsBuffer::CompressionMode::GREEDY},
+      {"hash_chain", LzsBuffer::CompressionMode::HASH_CHAIN}
+    };
+    std::cout << std::left << std::setw(16) << "input" << std::setw(12) << "mode"
+      << std::right << std::setw(10) << "ratio" << std::setw(14) << "comp MB/s"
+      << std::setw(14) << "buffer MB/s" << std::setw(14) << "stream MB/s" << std::endl;
+    int result = 0;
+    for (const auto& input : inputs){
+        if (input.second.empty()) continue;
+        for (const auto& mode : modes){
+            std::vector<VGears::uint8> compressed;
+            const double compress_speed = Measure(input.second.size(), [&](){
+                compressed = LzsBuffer::Compress(input.second, mode.second);
+            });
+            std::vector<VGears::uint8> decompressed;
+            const double buffer_speed = Measure(input.second.size(), [&](){
+                decompressed = LzsBuffer::Decompress(compressed);
+            });
+            if (decompressed != input.second) result = 1;
+            const double stream_speed = Measure(input.second.size(), [&](){
+                Ogre::DataStreamPtr compressed_stream(
+                  new Ogre::MemoryDataStream(compressed.data(), compressed.size(), false, true)
+                );
+                VGears::LZSDataStream stream(compressed_stream);
+                decompressed.assign(input.second.size(), 0);
+                stream.read(decompressed.data(), decompressed.size());
+            });
+            if (decompressed != input.second) result = 1;
+            std::cout << std::left << std::setw(16) << input.first << std::setw(12) << mode.first
+              << std::right << std::fixed << std::setprecision(3) << std::setw(10)
+              << static_cast<double>(compressed.size()) / input.second.size()
+              << std::setprecision(1) << std::setw(14) << compress_speed
+              << std::setw(14) << buffer_speed << std::setw(14) << stream_speed << std::endl;
+        }
+    }
+    if (result != 0) std::cerr << "Round trip failed!" << std::endl;
+    return result;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <OgreLogManager.h>
+#include "core/ScriptManagerFfiBinds.h"
+#include "core/Timer.h"
+#include "LuaIncludes.h"
+
+/**
+ * Script that reads the game time through luabind, as battle.lua did every frame.
+ */
+static const char* LUABIND_SCRIPT = R"(
+local sum = 0
+for i = 1, calls do sum = sum + timer:get_game_time_total() end
+return sum
+)";
+
+/**
+ * Script that reads the game time through the FFI binds.
+ */
+static const char* FFI_SCRIPT = R"(
+local sum = 0
+for i = 1, calls do sum = sum + fast_binds.timer_get_game_time_total() end
+return sum
+)";
+
+/**
+ * Runs a script repeatedly and measures it.
+ *
+ * @param[in] state The Lua state.
+ * @param[in] script The script to run.
+ * @param[out] result The value returned by the last run of the script.
+ * @return Time per run, in milliseconds, or a negative value if the script failed.
+ */
+static double Measure(lua_State* state, const char* script, double& result){
+    const int runs = 5;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r ++){
+        if (luaL_dostring(state, script) != 0){
+            std::cerr << lua_tostring(state, -1) << std::endl;
+            lua_pop(state, 1);
+            return -1;
+        }
+        result = lua_tonumber(state, -1);
+        lua_pop(state, 1);
+    }
+    return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start
+    ).count() / runs;
+}
+
+/**
+ * Script binds benchmark main function.
+ *
+ * Reports the time scripts take to read the game time through luabind and through the FFI
+ * binds, in a Lua state set up as the script manager does.
+ *
+ * @param[in] argc Number of arguments passed to the application.
+ * @param[in] argv The first argument, if any, is the number of calls on each run.
+ * @return The application return code. 0 is OK, 1 if a script failed or both binds give
+ * different results.
+ */
+int main(int argc, char *argv[]){
+    const int calls = argc > 1 ? std::stoi(argv[1]) : 1000000;
+    Ogre::LogManager log_manager;
+    log_manager.createLog("v-gears-benchmark.log", true, false, true);
+    Timer timer;
+    timer.AddTime(0.5f);
+
+    lua_State* state = lua_open();
+    luabind::open(state);
+    luaopen_base(state);
+    luabind::module(state)[
+        luabind::class_<Timer>("Timer")
+          .def("get_game_time_total", (float(Timer::*)()) &Timer::GetGameTimeTotal)
+    ];
+    luabind::globals(state)["timer"] = boost::ref(timer);
+    luabind::globals(state)["calls"] = calls;
+    if (!OpenFfiBinds(state)){
+        lua_close(state);
+        return 1;
+    }
+
+    double luabind_result = 0, ffi_result = 0;
+    const double luabind_time = Measure(state, LUABIND_SCRIPT, luabind_result);
+    const double ffi_time = Measure(state, FFI_SCRIPT, ffi_result);
+    lua_close(state);
+    if (luabind_time < 0 || ffi_time < 0) return 1;
+
+    std::cout << calls << " calls to get the game time" << std::endl;
+    std::cout << std::left << std::setw(12) << "test" << std::right << std::setw(16)
+      << "luabind ms" << std::setw(16) << "ffi ms" << std::setw(10) << "speedup"
+      << std::endl << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(12) << "timer" << std::right << std::setw(16)
+      << luabind_time << std::setw(16) << ffi_time << std::setw(10)
+      << luabind_time / ffi_time << std::endl;
+    if (luabind_result != ffi_result){
+        std::cerr << "Binds gave different results!" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include "core/Walkmesh.h"
+
+/**
+ * Walkmesh access through the checked accessors.
+ */
+struct CheckedAccess{
+    static const Ogre::Vector3& A(const Walkmesh& walkmesh, int t){return walkmesh.GetA(t);}
+    static const Ogre::Vector3& B(const Walkmesh& walkmesh, int t){return walkmesh.GetB(t);}
+    static const Ogre::Vector3& C(const Walkmesh& walkmesh, int t){return walkmesh.GetC(t);}
+    static int Side(const Walkmesh& walkmesh, int t, unsigned char side){
+        return walkmesh.GetAccessSide(t, side);
+    }
+    static bool Locked(const Walkmesh& walkmesh, int t){return walkmesh.IsLocked(t);}
+};
+
+/**
+ * Walkmesh access through the unchecked accessors.
+ */
+struct UncheckedAccess{
+    static const Ogre::Vector3& A(const Walkmesh& walkmesh, int t){
+        return walkmesh.GetAUnchecked(t);
+    }
+    static const Ogre::Vector3& B(const Walkmesh& walkmesh, int t){
+        return walkmesh.GetBUnchecked(t);
+    }
+    static const Ogre::Vector3& C(const Walkmesh& walkmesh, int t){
+        return walkmesh.GetCUnchecked(t);
+    }
+    static int Side(const Walkmesh& walkmesh, int t, unsigned char side){
+        return walkmesh.GetAccessSideUnchecked(t, side);
+    }
+    static bool Locked(const Walkmesh& walkmesh, int t){return walkmesh.IsLockedUnchecked(t);}
+};
+
+/**
+ * Builds a walkmesh as a grid of squares, each split in two triangles.
+ *
+ * Triangles are counter clockwise. Side 0 goes from a to b, side 1 from b to c and side 2 from
+ * c to a.
+ *
+ * @param[in] size Number of squares on each side of the grid.
+ * @param[out] walkmesh The walkmesh to fill.
+ */
+static void BuildGrid(const int size, Walkmesh& walkmesh){
+    auto lower = [size](int x, int y){
+        return (x < 0 || y < 0 || x >= size || y >= size) ? -1 : (y * size + x) * 2;
+    };
+    auto upper = [size](int x, int y){
+        return (x < 0 || y < 0 || x >= size || y >= size) ? -1 : (y * size + x) * 2 + 1;
+    };
+    std::mt19937 random(1);
+    for (int y = 0; y < size; y ++){
+        for (int x = 0; x < size; x ++){
+            const float z00 = static_cast<float>(random() % 16);
+            WalkmeshTriangle triangle;
+            triangle.a = Ogre::Vector3(x, y, z00);
+            triangle.b = Ogre::Vector3(x + 1, y, z00);
+            triangle.c = Ogre::Vector3(x, y + 1, z00);
+            triangle.access_side[0] = upper(x, y - 1);
+            triangle.access_side[1] = upper(x, y);
+            triangle.access_side[2] = upper(x - 1, y);
+            walkmesh.AddTriangle(triangle);
+            triangle.a = Ogre::Vector3(x + 1, y, z00);
+            triangle.b = Ogre::Vector3(x + 1, y + 1, z00);
+            triangle.c = Ogre::Vector3(x, y + 1, z00);
+            triangle.access_side[0] = lower(x + 1, y);
+            triangle.access_side[1] = lower(x, y + 1);
+            triangle.access_side[2] = lower(x, y);
+            walkmesh.AddTriangle(triangle);
+        }
+    }
+}
+
+/**
+ * Checks on which side of a line a point is.
+ *
+ * @param[in] point The point.
+ * @param[in] start Start of the line.
+ * @param[in] end End of the line.
+ * @return Positive if the point is on the left, negative if it's on the right.
+ */
+static float SideOfLine(
+  const Ogre::Vector2& point, const Ogre::Vector3& start, const Ogre::Vector3& end
+){
+    return (end.x - start.x) * (point.y - start.y) - (end.y - start.y) * (point.x - start.x);
+}
+
+/**
+ * Finds every triangle containing a set of points, by scanning the whole walkmesh.
+ *
+ * This is what placing an entity on the walkmesh does.
+ *
+ * @param[in] walkmesh The walkmesh.
+ * @param[in] points Points to look for.
+ * @return Sum of the IDs of the triangles found, to compare both accessors.
+ */
+template<typename Access> static long long Scan(
+  const Walkmesh& walkmesh, const std::vector<Ogre::Vector2>& points
+){
+    long long sum = 0;
+    const int count = walkmesh.GetNumberOfTriangles();
+    for (const Ogre::Vector2& point : points){
+        for (int t = 0; t < count; t ++){
+            const Ogre::Vector3& a = Access::A(walkmesh, t);
+            const Ogre::Vector3& b = Access::B(walkmesh, t);
+            const Ogre::Vector3& c = Access::C(walkmesh, t);
+            if (
+              SideOfLine(point, a, b) >= 0 && SideOfLine(point, b, c) >= 0
+              && SideOfLine(point, c, a) >= 0
+            ){
+                sum += t;
+            }
+        }
+    }
+    return sum;
+}
+
+/**
+ * Moves a point across the walkmesh, following the access sides.
+ *
+ * This is what moving an entity on the walkmesh does every frame.
+ *
+ * @param[in] walkmesh The walkmesh.
+ * @param[in] size Number of squares on each side of the grid.
+ * @param[in] steps Number of steps to move.
+ * @return Sum of the IDs of the triangles visited, to compare both accessors.
+ */
+template<typename Access> static long long Walk(
+  const Walkmesh& walkmesh, const int size, const int steps
+){
+    long long sum = 0;
+    int triangle = 0;
+    Ogre::Vector2 position(0.25f, 0.25f);
+    Ogre::Vector2 direction(0.37f, 0.21f);
+    for (int s = 0; s < steps; s ++){
+        Ogre::Vector2 next = position + direction;
+        if (next.x <= 0 || next.x >= size) direction.x = -direction.x;
+        if (next.y <= 0 || next.y >= size) direction.y = -direction.y;
+        next = position + direction;
+        for (;;){
+            const Ogre::Vector3& a = Access::A(walkmesh, triangle);
+            const Ogre::Vector3& b = Access::B(walkmesh, triangle);
+            const Ogre::Vector3& c = Access::C(walkmesh, triangle);
+            int next_triangle = -1;
+            if (SideOfLine(next, a, b) < 0) next_triangle = Access::Side(walkmesh, triangle, 0);
+            else if (SideOfLine(next, b, c) < 0)
+                next_triangle = Access::Side(walkmesh, triangle, 1);
+            else if (SideOfLine(next, c, a) < 0)
+                next_triangle = Access::Side(walkmesh, triangle, 2);
+            else break;
+            if (next_triangle < 0 || Access::Locked(walkmesh, next_triangle)) break;
+            triangle = next_triangle;
+        }
+        position = next;
+        sum += triangle;
+    }
+    return sum;
+}
+
+/**
+ * Runs a function repeatedly and measures it.
+ *
+ * @param[in] function The function to measure.
+ * @return Time per run, in milliseconds.
+ */
+template<typename Function> static double Measure(Function function){
+    const int runs = 5;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r ++) function();
+    return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start
+    ).count() / runs;
+}
+
+/**
+ * Walkmesh benchmark main function.
+ *
+ * Builds a large walkmesh and reports the time to locate points by scanning all triangles and
+ * to move a point across it, with the checked and the unchecked accessors.
+ *
+ * @param[in] argc Number of arguments passed to the application.
+ * @param[in] argv The first argument, if any, is the number of squares on each side of the
+ * walkmesh grid.
+ * @return The application return code. 0 is OK, 1 if both accessors give different results.
+ */
+int main(int argc, char *argv[]){
+    const int size = argc > 1 ? std::stoi(argv[1]) : 128;
+    Walkmesh walkmesh;
+    BuildGrid(size, walkmesh);
+    std::mt19937 random(2);
+    std::vector<Ogre::Vector2> points(64);
+    for (Ogre::Vector2& point : points){
+        point.x = (random() % (size * 100)) / 100.0f + 0.005f;
+        point.y = (random() % (size * 100)) / 100.0f + 0.003f;
+    }
+    const int steps = 1000000;
+
+    long long checked_result = 0, unchecked_result = 0;
+    const double checked_scan = Measure([&](){
+        checked_result = Scan<CheckedAccess>(walkmesh, points);
+    });
+    const double unchecked_scan = Measure([&](){
+        unchecked_result = Scan<UncheckedAccess>(walkmesh, points);
+    });
+    int result = checked_result == unchecked_result ? 0 : 1;
+    const double checked_walk = Measure([&](){
+        checked_result = Walk<CheckedAccess>(walkmesh, size, steps);
+    });
+    const double unchecked_walk = Measure([&](){
+        unchecked_result = Walk<UncheckedAccess>(walkmesh, size, steps);
+    });
+    if (checked_result != unchecked_result) result = 1;
+
+    std::cout << walkmesh.GetNumberOfTriangles() << " triangles, " << points.size()
+      << " point scans, " << steps << " walk steps" << std::endl;
+    std::cout << std::left << std::setw(12) << "test" << std::right << std::setw(16)
+      << "checked ms" << std::setw(16) << "unchecked ms" << std::setw(10) << "speedup"
+      << std::endl << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(12) << "scan" << std::right << std::setw(16)
+      << checked_scan << std::setw(16) << unchecked_scan << std::setw(10)
+      << checked_scan / unchecked_scan << std::endl;
+    std::cout << std::left << std::setw(12) << "walk" << std::right << std::setw(16)
+      << checked_walk << std::setw(16) << unchecked_walk << std::setw(10)
+      << checked_walk / unchecked_walk << std::endl;
+    if (result != 0) std::cerr << "Accessors gave different results!" << std::endl;
+    return result;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "core/particles/ParticleVisual.h"
+#include "core/particles/emitters/BoxEmitter.h"
+#include "core/particles/emitters/CircleEmitter.h"
+#include "core/particles/emitters/LineEmitter.h"
+#include "core/particles/emitters/PointEmitter.h"
+#include "core/particles/emitters/SphereEmitter.h"
+
+/**
+ * Result of running an emitter.
+ */
+struct EmitterResult{
+
+    /**
+     * Number of particles emitted.
+     */
+    long long particles;
+
+    /**
+     * Particles emitted per second of real time.
+     */
+    double rate;
+
+    /**
+     * Indicates if every particle was emitted inside the emitter shape.
+     */
+    bool valid;
+};
+
+/**
+ * Runs an emitter for a number of frames, as a technique does, and measures it.
+ *
+ * @param[in] emitter The emitter to run.
+ * @param[in] frames Number of frames to run, at 60 frames per second.
+ * @param[in] particles Particles to initialize. They are reused in a circle, as the pool does.
+ * @param[in] inside Function that checks if a particle position is inside the emitter shape.
+ * @return The results.
+ */
+template<typename Inside> static EmitterResult Run(
+  ParticleEmitter& emitter, const int frames, std::vector<VisualParticle>& particles,
+  Inside inside
+){
+    EmitterResult result = {0, 0, true};
+    const Ogre::Real time_elapsed = 1.0f / 60;
+    size_t next = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f ++){
+        const int requested = emitter.CalculateRequestedParticles(time_elapsed);
+        for (int p = 0; p < requested; p ++){
+            VisualParticle& particle = particles[next];
+            particle.InitForEmission();
+            emitter.InitParticleForEmission(&particle);
+            if (!inside(particle.position)) result.valid = false;
+            next = next + 1 == particles.size() ? 0 : next + 1;
+        }
+        result.particles += requested;
+    }
+    const double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+    result.rate = result.particles / seconds;
+    return result;
+}
+
+/**
+ * Prints the results of an emitter.
+ *
+ * @param[in] name Name of the emitter.
+ * @param[in] result The emitter results.
+ */
+static void Print(const std::string& name, const EmitterResult& result){
+    std::cout << std::left << std::setw(16) << name << std::right << std::setw(14)
+      << result.particles << std::setw(18) << std::fixed << std::setprecision(2)
+      << result.rate / 1000000 << std::setw(8) << (result.valid ? "yes" : "NO") << std::endl;
+}
+
+/**
+ * Emitters benchmark main function.
+ *
+ * Runs each emitter type at a high emission rate, and the point emitter with bursts only, and
+ * reports how many particles each one initializes per second. It also checks that every
+ * particle is emitted inside the emitter shape.
+ *
+ * @param[in] argc Number of arguments passed to the application.
+ * @param[in] argv The first argument, if any, is the number of frames to run.
+ * @return The application return code. 0 is OK, 1 if a particle was emitted out of its shape.
+ */
+int main(int argc, char *argv[]){
+    const int frames = argc > 1 ? std::stoi(argv[1]) : 6000;
+    const Ogre::Real epsilon = 0.001f;
+    std::vector<VisualParticle> particles(4096);
+    int result = 0;
+
+    std::cout << frames << " frames at 60 fps" << std::endl;
+    std::cout << std::left << std::setw(16) << "emitter" << std::right << std::setw(14)
+      << "particles" << std::setw(18) << "Mparticles/s" << std::setw(8) << "valid" << std::endl;
+
+    PointEmitter point;
+    point.SetEmissionRate(600000);
+    EmitterResult point_result = Run(point, frames, particles, [](const Ogre::Vector3& p){
+        return p == Ogre::Vector3::ZERO;
+    });
+    Print("point", point_result);
+
+    PointEmitter burst;
+    burst.SetEmissionRate(0);
+    burst.SetBurst(100000);
+    burst.SetBurstInterval(1.0f / 6);
+    EmitterResult burst_result = Run(burst, frames, particles, [](const Ogre::Vector3& p){
+        return p == Ogre::Vector3::ZERO;
+    });
+    Print("point (burst)", burst_result);
+
+    BoxEmitter box;
+    box.SetEmissionRate(600000);
+    box.SetSize(Ogre::Vector3(4, 2, 1));
+    EmitterResult box_result = Run(box, frames, particles, [](const Ogre::Vector3& p){
+        return Ogre::Math::Abs(p.x) <= 2 && Ogre::Math::Abs(p.y) <= 1
+          && Ogre::Math::Abs(p.z) <= 0.5f;
+    });
+    Print("box", box_result);
+
+    SphereEmitter sphere;
+    sphere.SetEmissionRate(600000);
+    sphere.SetRadius(3);
+    EmitterResult sphere_result = Run(sphere, frames, particles, [&](const Ogre::Vector3& p){
+        return Ogre::Math::Abs(p.length() - 3) < epsilon;
+    });
+    Print("sphere", sphere_result);
+
+    CircleEmitter circle;
+    circle.SetEmissionRate(600000);
+    circle.SetRadius(2);
+    circle.SetNormal(Ogre::Vector3(0, 0, 1));
+    EmitterResult circle_result = Run(circle, frames, particles, [&](const Ogre::Vector3& p){
+        return Ogre::Math::Abs(p.length() - 2) < epsilon && Ogre::Math::Abs(p.z) < epsilon;
+    });
+    Print("circle", circle_result);
+
+    LineEmitter line;
+    line.SetEmissionRate(600000);
+    line.SetEnd(Ogre::Vector3(5, 0, 0));
+    EmitterResult line_result = Run(line, frames, particles, [](const Ogre::Vector3& p){
+        return p.x >= 0 && p.x <= 5 && p.y == 0 && p.z == 0;
+    });
+    Print("line", line_result);
+
+    for (const EmitterResult& r : {
+      point_result, burst_result, box_result, sphere_result, circle_result, line_result
+    }){
+        if (!r.valid) result = 1;
+    }
+    if (result != 0) std::cerr << "Particles emitted out of their emitter shape!" << std::endl;
+    return result;
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <OgreAnimation.h>
+#include <OgreKeyFrame.h>
+#include <OgreSkeleton.h>
+#include "data/VGearsAFile.h"
+
+/**
+ * Number of bones of the generated model.
+ */
+static const VGears::uint32 BONE_COUNT = 23;
+
+/**
+ * Number of frames of each generated animation.
+ */
+static const size_t FRAME_COUNT = 40;
+
+/**
+ * Generates the frames of an animation.
+ *
+ * About a third of the bones, like fingers or the head of a walking character, don't move.
+ * Angles are multiples of 360 / 4096 degrees, as in the original files.
+ *
+ * @param[in,out] random Random number generator.
+ * @return The frames.
+ */
+static VGears::AFile::FrameList BuildFrames(std::mt19937& random){
+    auto angle = [&random](){return (random() % 4096) * 360.0f / 4096.0f;};
+    std::vector<bool> moving(BONE_COUNT);
+    std::vector<Ogre::Vector3> rest(BONE_COUNT);
+    for (VGears::uint32 b = 0; b < BONE_COUNT; b ++){
+        moving[b] = random() % 3 != 0;
+        rest[b] = Ogre::Vector3(angle(), angle(), angle());
+    }
+    VGears::AFile::FrameList frames(FRAME_COUNT);
+    for (VGears::AFile::Frame& frame : frames){
+        frame.root_rotation = Ogre::Vector3(0, angle(), 0);
+        frame.root_translation = Ogre::Vector3(0, (random() % 64) / 64.0f, 0);
+        for (VGears::uint32 b = 0; b < BONE_COUNT; b ++){
+            frame.bone_rotations.push_back(
+              moving[b] ? Ogre::Vector3(angle(), angle(), angle()) : rest[b]
+            );
+        }
+    }
+    return frames;
+}
+
+/**
+ * Calculates the size of frames, as AFile used to keep them.
+ *
+ * @param[in] frames The frames.
+ * @return The size, in bytes.
+ */
+static size_t FramesSize(const VGears::AFile::FrameList& frames){
+    size_t size = 0;
+    for (const VGears::AFile::Frame& frame : frames){
+        size += sizeof(frame.root_rotation) + sizeof(frame.root_translation);
+        size += sizeof(VGears::AFile::BoneRotationList::value_type) * frame.bone_rotations.size();
+    }
+    return size;
+}
+
+/**
+ * Converts Euler angles to a quaternion, as AFile used to set them in key frames.
+ *
+ * @param[in] rotation Euler angles, in degrees.
+ * @return The rotation.
+ */
+static Ogre::Quaternion ToQuaternion(const Ogre::Vector3& rotation){
+    Ogre::Quaternion quaternion;
+    Ogre::Matrix3 matrix;
+    matrix.FromEulerAnglesZXY(
+      Ogre::Radian(Ogre::Degree(-rotation.y)), Ogre::Radian(Ogre::Degree(-rotation.x)),
+      Ogre::Radian(Ogre::Degree(-rotation.z))
+    );
+    quaternion.FromRotationMatrix(matrix);
+    return quaternion;
+}
+
+/**
+ * Creates a skeleton with a root bone and the bones of the generated model.
+ *
+ * @param[in] name Skeleton name.
+ * @return The skeleton.
+ */
+static Ogre::SkeletonPtr BuildSkeleton(const std::string& name){
+    Ogre::SkeletonPtr skeleton(new Ogre::Skeleton(nullptr, name, 0, "General", true));
+    skeleton->createBone("root");
+    for (VGears::uint32 b = 0; b < BONE_COUNT; b ++) skeleton->createBone();
+    return skeleton;
+}
+
+/**
+ * Adds an animation to a skeleton as AFile used to, with a key frame per bone and frame.
+ *
+ * @param[in] frames The frames of the animation.
+ * @param[in,out] skeleton The skeleton.
+ * @param[in] name Animation name.
+ */
+static void AddFrames(
+  const VGears::AFile::FrameList& frames, Ogre::SkeletonPtr skeleton, const std::string& name
+){
+    Ogre::Animation* animation
+      = skeleton->createAnimation(name, (frames.size() - 1) * VGears::AFile::FRAME_DURATION);
+    Ogre::NodeAnimationTrack* track = animation->createNodeTrack(0, skeleton->getBone("root"));
+    for (size_t f = 0; f < frames.size(); f ++){
+        Ogre::TransformKeyFrame* key_frame
+          = track->createNodeKeyFrame(f * VGears::AFile::FRAME_DURATION);
+        key_frame->setTranslate(frames[f].root_translation);
+        key_frame->setRotation(ToQuaternion(frames[f].root_rotation));
+    }
+    for (VGears::uint32 b = 0; b < BONE_COUNT; b ++){
+        track = animation->createNodeTrack(b + 1, skeleton->getBone(b + 1));
+        for (size_t f = 0; f < frames.size(); f ++){
+            track->createNodeKeyFrame(f * VGears::AFile::FRAME_DURATION)->setRotation(
+              ToQuaternion(frames[f].bone_rotations[b])
+            );
+        }
+    }
+}
+
+/**
+ * Counts the key frames in all the animations of a skeleton.
+ *
+ * @param[in] skeleton The skeleton.
+ * @return Number of key frames.
+ */
+static size_t KeyFrames(const Ogre::SkeletonPtr& skeleton){
+    size_t key_frames = 0;
+    for (unsigned short a = 0; a < skeleton->getNumAnimations(); a ++){
+        for (const auto& track : skeleton->getAnimation(a)->_getNodeTrackList())
+            key_frames += track.second->getNumKeyFrames();
+    }
+    return key_frames;
+}
+
+/**
+ * Measures the time since a moment.
+ *
+ * @param[in] start The moment.
+ * @return Time since start, in milliseconds.
+ */
+static double Elapsed(const std::chrono::steady_clock::time_point& start){
+    return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+}
+
+/**
+ * AFile benchmark main function.
+ *
+ * Generates the animations of a model and reports the memory used by the animation data and by
+ * the skeleton key frames, and the time to load them into a skeleton, with a key frame per bone
+ * and frame as AFile used to and with the compact tracks.
+ *
+ * @param[in] argc Number of arguments passed to the application.
+ * @param[in] argv The first argument, if any, is the number of animations of the model.
+ * @return The application return code. 0 is OK, 1 if a sampled rotation differs from the
+ * original one by more than 0.1 degrees.
+ */
+int main(int argc, char *argv[]){
+    const int animations = argc > 1 ? std::stoi(argv[1]) : 64;
+    std::mt19937 random(1);
+    std::vector<VGears::AFile::FrameList> frames;
+    for (int a = 0; a < animations; a ++) frames.push_back(BuildFrames(random));
+
+    Ogre::SkeletonPtr frames_skeleton = BuildSkeleton("frames");
+    auto start = std::chrono::steady_clock::now();
+    for (int a = 0; a < animations; a ++)
+        AddFrames(frames[a], frames_skeleton, "animation" + std::to_string(a));
+    const double frames_ms = Elapsed(start);
+
+    Ogre::SkeletonPtr compact_skeleton = BuildSkeleton("compact");
+    std::vector<VGears::AFile*> a_files;
+    start = std::chrono::steady_clock::now();
+    for (int a = 0; a < animations; a ++){
+        VGears::AFile* a_file
+          = new VGears::AFile(nullptr, "benchmark" + std::to_string(a) + ".a", 0, "General");
+        a_file->SetBoneCount(BONE_COUNT);
+        a_file->SetFrames(frames[a]);
+        a_file->AddTo(compact_skeleton, "animation" + std::to_string(a));
+        a_files.push_back(a_file);
+    }
+    const double compact_ms = Elapsed(start);
+
+    int result = 0;
+    // Ogre::Quaternion::equals works in single precision, and can't resolve much less than
+    // 0.05 degrees.
+    const Ogre::Radian tolerance(Ogre::Degree(0.1f));
+    size_t frames_size = 0, compact_size = 0;
+    for (int a = 0; a < animations; a ++){
+        frames_size += FramesSize(frames[a]);
+        compact_size += a_files[a]->CalculateSize();
+        for (size_t f = 0; f < FRAME_COUNT; f ++){
+            for (VGears::uint32 b = 0; b < BONE_COUNT; b ++){
+                const Ogre::Quaternion expected = ToQuaternion(frames[a][f].bone_rotations[b]);
+                if (!a_files[a]->GetBoneRotation(b, f).equals(expected, tolerance)) result = 1;
+            }
+        }
+        delete a_files[a];
+    }
+    const size_t key_frames = KeyFrames(frames_skeleton);
+    const size_t compact_key_frames = KeyFrames(compact_skeleton);
+    const size_t key_frame_size = sizeof(Ogre::TransformKeyFrame);
+
+    std::cout << animations << " animations, " << BONE_COUNT << " bones, " << FRAME_COUNT
+      << " frames each" << std::endl << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(20) << "" << std::right << std::setw(12) << "frames"
+      << std::setw(12) << "compact" << std::setw(10) << "ratio" << std::endl;
+    std::cout << std::left << std::setw(20) << "data KiB" << std::right << std::setw(12)
+      << frames_size / 1024.0 << std::setw(12) << compact_size / 1024.0 << std::setw(10)
+      << static_cast<double>(frames_size) / compact_size << std::endl;
+    std::cout << std::left << std::setw(20) << "key frames" << std::right << std::setw(12)
+      << key_frames << std::setw(12) << compact_key_frames << std::setw(10)
+      << static_cast<double>(key_frames) / compact_key_frames << std::endl;
+    std::cout << std::left << std::setw(20) << "key frame KiB" << std::right << std::setw(12)
+      << key_frames * key_frame_size / 1024.0 << std::setw(12)
+      << compact_key_frames * key_frame_size / 1024.0 << std::endl;
+    std::cout << std::left << std::setw(20) << "load ms" << std::right << std::setw(12)
+      << frames_ms << std::setw(12) << compact_ms << std::setw(10) << frames_ms / compact_ms
+      << std::endl;
+    if (result != 0) std::cerr << "Sampled rotations differ from the frames!" << std::endl;
+    return result;
+}
@@ -131,7 +131,7 @@ Battle.logic_script = {
 
 
     on_update = function( self )
-        local timer = timer:get_game_time_total()
+        local timer = fast_binds.timer_get_game_time_total()
         local delta = timer - self.game_timer
 
         -- update timers
@@ -200,7 +200,7 @@ Battle.init = function()
 
 
     -- init timer with start value
-    EntityContainer.BattleLogic.game_timer = timer:get_game_time_total()
+    EntityContainer.BattleLogic.game_timer = fast_binds.timer_get_game_time_total()
 
 
 
@@ -162,19 +162,19 @@ end
 -- @param by Bank at which to store the Y coordinate.
 -- @param bz Bank at which to store the Z coordinate.
 -- @param bt Bank at which to store the triangle.
--- @param id The entity ID.
+-- @param name The entity name.
 -- @param ax Address at which to store the X coordinate.
 -- @param ay Address at which to store the Y coordinate.
 -- @param az Address at which to store the Z coordinate.
 -- @param at Address at which to store the triangle.
 -- @param scale Map scale to multiply values
-axyzi = function(bx, by, bz, bt, id, ax, ay, az, at, scale)
-    local entity = entity_manager:get_entity_from_index(id)
-    if entity == nil then
+axyzi = function(bx, by, bz, bt, name, ax, ay, az, at, scale)
+    -- Field scripts usually call this every frame, use the fast binds.
+    local x, y, z = fast_binds.entity_get_position(name)
+    if x == nil then
         do return end
     end
-    local x, y, z = entity:get_position()
-    local t = entity:get_move_triangle_id()
+    local t = fast_binds.entity_get_move_triangle_id(name)
     Banks[bx][ax] = math.floor(x * scale)
     Banks[by][ay] = math.floor(y * scale)
     Banks[bz][az] = math.floor(z * scale)
@@ -13,9 +13,22 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
 #include "common/LzsFile.h"
 #include "core/Logger.h"
 
+const u32 LzsBuffer::WINDOW_SIZE = 4096;
+
+const u32 LzsBuffer::WINDOW_START = 0xFEE;
+
+const u32 LzsBuffer::MIN_MATCH = 3;
+
+const u32 LzsBuffer::MAX_MATCH = 18;
+
+const u32 LzsBuffer::HASH_BITS = 12;
+
+const u32 LzsBuffer::MAX_CHAIN = 256;
+
 LzsFile::LzsFile(const Ogre::String& file): File(file){
     ExtractLzs();
 }
@@ -104,3 +117,93 @@ std::vector<VGears::uint8> LzsBuffer::Decompress(
     ret.assign(tmp.buffer_, tmp.buffer_ + tmp.buffer_size_);
     return ret;
 }
+
+std::vector<VGears::uint8> LzsBuffer::Compress(
+  const std::vector<VGears::uint8>& buffer, const CompressionMode mode
+){
+    const u8* data = buffer.data();
+    const u32 size = static_cast<u32>(buffer.size());
+    const u32 max_chain = (mode == CompressionMode::GREEDY ? 1 : MAX_CHAIN);
+    const bool lazy = (mode == CompressionMode::HASH_CHAIN);
+    // Worst case: every byte is a literal, plus one control byte every 8 of them.
+    std::vector<VGears::uint8> compressed(4, 0);
+    compressed.reserve(4 + size + (size + 7) / 8);
+    std::vector<int> head(1 << HASH_BITS, -1);
+    std::vector<int> prev(WINDOW_SIZE, -1);
+    u32 hashed = 0; // Positions before this one are already in the hash chains.
+    auto hash_up_to = [&](const u32 end){
+        for (; hashed < end && hashed + MIN_MATCH <= size; hashed ++){
+            const u32 hash = Hash(data, hashed);
+            prev[hashed % WINDOW_SIZE] = head[hash];
+            head[hash] = static_cast<int>(hashed);
+        }
+        hashed = std::max(hashed, end);
+    };
+    size_t control_pos = 0;
+    u32 control_bit = 8;
+    u32 pos = 0;
+    while (pos < size){
+        if (control_bit == 8){
+            control_pos = compressed.size();
+            compressed.push_back(0);
+            control_bit = 0;
+        }
+        hash_up_to(pos);
+        u32 distance = 0;
+        u32 length = FindMatch(data, size, pos, head, prev, max_chain, distance);
+        if (lazy && length >= MIN_MATCH && length < MAX_MATCH){
+            // If the next byte starts a longer match, it's better to emit a literal now.
+            hash_up_to(pos + 1);
+            u32 next_distance = 0;
+            if (FindMatch(data, size, pos + 1, head, prev, max_chain, next_distance) > length)
+                length = 0;
+        }
+        if (length >= MIN_MATCH){
+            const u32 reference = (pos - distance + WINDOW_START) % WINDOW_SIZE;
+            compressed.push_back(static_cast<u8>(reference & 0xFF));
+            compressed.push_back(static_cast<u8>(((reference >> 4) & 0xF0) | (length - MIN_MATCH)));
+            pos += length;
+        }
+        else{
+            compressed[control_pos] |= 1 << control_bit;
+            compressed.push_back(data[pos]);
+            pos ++;
+        }
+        control_bit ++;
+    }
+    const u32 compressed_size = static_cast<u32>(compressed.size() - 4);
+    for (int i = 0; i < 4; i ++) compressed[i] = (compressed_size >> (i * 8)) & 0xFF;
+    return compressed;
+}
+
+u32 LzsBuffer::Hash(const u8* data, const u32 pos){
+    const u32 sequence = (data[pos] << 16) | (data[pos + 1] << 8) | data[pos + 2];
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+u32 LzsBuffer::FindMatch(
+  const u8* data, const u32 size, const u32 pos, const std::vector<int>& head,
+  const std::vector<int>& prev, const u32 max_chain, u32& distance
+){
+    if (pos + MIN_MATCH > size) return 0;
+    const u32 max_length = std::min(MAX_MATCH, size - pos);
+    u32 best = 0;
+    int candidate = head[Hash(data, pos)];
+    for (u32 chain = 0; chain < max_chain && candidate >= 0; chain ++){
+        // A distance of a whole window would point to the byte being written.
+        if (pos - candidate >= WINDOW_SIZE) break;
+        // Sequences may overlap the current position, the decoder copies byte by byte.
+        u32 length = 0;
+        while (length < max_length && data[candidate + length] == data[pos + length]) length ++;
+        if (length > best){
+            best = length;
+            distance = pos - candidate;
+            if (best == max_length) break;
+        }
+        const int next = prev[candidate % WINDOW_SIZE];
+        // Older slots get overwritten by newer positions: stop when the chain stops going back.
+        if (next >= candidate) break;
+        candidate = next;
+    }
+    return best;
+}
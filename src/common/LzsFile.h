@@ -90,6 +90,25 @@ class LzsBuffer{
          */
         LzsBuffer() = delete;
 
+        /**
+         * Strategies to find repeated data when compressing.
+         */
+        enum class CompressionMode{
+
+            /**
+             * Only the most recent occurrence of each sequence is checked. Fast, but it
+             * compresses worse.
+             */
+            GREEDY,
+
+            /**
+             * Previous occurrences of each sequence are searched in the whole window, and a
+             * match is deferred if the next byte starts a longer one. Slower, but it compresses
+             * better.
+             */
+            HASH_CHAIN
+        };
+
         /**
          * Decompresses lzs data in a buffer.
          *
@@ -99,4 +118,79 @@ class LzsBuffer{
         static std::vector<VGears::uint8> Decompress(
           const std::vector<VGears::uint8>& buffer
         );
+
+        /**
+         * Compresses data in a buffer to the lzs format.
+         *
+         * The output, including the size header, can be decompressed with {@see Decompress},
+         * with {@see LzsFile} or with {@see VGears::LZSDataStream}.
+         *
+         * @param[in] buffer Data to compress.
+         * @param[in] mode Compression strategy.
+         * @return Compressed data.
+         */
+        static std::vector<VGears::uint8> Compress(
+          const std::vector<VGears::uint8>& buffer,
+          const CompressionMode mode = CompressionMode::HASH_CHAIN
+        );
+
+    private:
+
+        /**
+         * Size of the sliding window, in bytes.
+         */
+        static const u32 WINDOW_SIZE;
+
+        /**
+         * Position of the first written byte in the decoder's window.
+         */
+        static const u32 WINDOW_START;
+
+        /**
+         * Shortest sequence that can be encoded as a reference.
+         */
+        static const u32 MIN_MATCH;
+
+        /**
+         * Longest sequence that can be encoded as a reference.
+         */
+        static const u32 MAX_MATCH;
+
+        /**
+         * Number of bits in the hash of a sequence.
+         */
+        static const u32 HASH_BITS;
+
+        /**
+         * Maximum number of previous occurrences checked in hash chain mode.
+         */
+        static const u32 MAX_CHAIN;
+
+        /**
+         * Calculates the hash of the sequence at a position.
+         *
+         * @param[in] data Data being compressed. At least {@see MIN_MATCH} bytes must be
+         * available from the position.
+         * @param[in] pos Position of the sequence.
+         * @return The hash of the sequence.
+         */
+        static u32 Hash(const u8* data, const u32 pos);
+
+        /**
+         * Finds the longest previous occurrence of the sequence at a position.
+         *
+         * @param[in] data Data being compressed.
+         * @param[in] size Size of the data being compressed.
+         * @param[in] pos Position of the sequence.
+         * @param[in] head Most recent position of each hash.
+         * @param[in] prev Previous position with the same hash, for every position in the
+         * window.
+         * @param[in] max_chain Maximum number of positions to check.
+         * @param[out] distance Distance from the position to the match.
+         * @return Length of the match. Less than {@see MIN_MATCH} if none was found.
+         */
+        static u32 FindMatch(
+          const u8* data, const u32 size, const u32 pos, const std::vector<int>& head,
+          const std::vector<int>& prev, const u32 max_chain, u32& distance
+        );
 };
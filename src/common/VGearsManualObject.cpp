@@ -30,6 +30,7 @@ namespace VGears{
       colour_(nullptr),
       _texture_coordinate(nullptr),
       _index(nullptr),
+      index_32_(nullptr),
       colour_type_(Ogre::VertexElement::getBestColourVertexElementType())
     {}
 
@@ -84,15 +85,18 @@ namespace VGears{
     }
 
     void ManualObject::createIndexBuffer(){
+        // Sections merged from many groups can have more vertices than 16 bits can index.
+        const bool wide(_section->vertexData->vertexCount > 0x10000);
         _indexbuffer_ =
           Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
-            Ogre::HardwareIndexBuffer::IT_16BIT,
+            wide ? Ogre::HardwareIndexBuffer::IT_32BIT : Ogre::HardwareIndexBuffer::IT_16BIT,
             _section->indexData->indexCount,
             Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY
           );
 
         void *data(_indexbuffer_->lock(Ogre::HardwareBuffer::HBL_DISCARD));
-        _index = static_cast< uint16* >(data);
+        if (wide) index_32_ = static_cast< uint32* >(data);
+        else _index = static_cast< uint16* >(data);
         _section->indexData->indexBuffer = _indexbuffer_;
     }
 
@@ -111,6 +115,7 @@ namespace VGears{
         colour_ = nullptr;
         _texture_coordinate = nullptr;
         _index = nullptr;
+        index_32_ = nullptr;
     }
 
     void ManualObject::begin(
@@ -177,8 +182,9 @@ namespace VGears{
     }
 
     void ManualObject::index(const uint32 idx){
-        if (_index == nullptr) createIndexBuffer();
-        *(_index ++) = idx;
+        if (_index == nullptr && index_32_ == nullptr) createIndexBuffer();
+        if (index_32_ != nullptr) *(index_32_ ++) = idx;
+        else *(_index ++) = idx;
     }
 
     void ManualObject::bone(
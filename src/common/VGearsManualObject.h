@@ -266,10 +266,15 @@ namespace VGears{
             Ogre::Vector2 *_texture_coordinate;
 
             /**
-             * The object index.
+             * The object index, if the section indices are 16 bits wide.
              */
             uint16 *_index;
 
+            /**
+             * The object index, if the section indices are 32 bits wide.
+             */
+            uint32 *index_32_;
+
             /**
              * The colour type.
              */
@@ -31,6 +31,38 @@ ConfigVar cv_debug_background2d("debug_background2d", "Draw background debug inf
 ConfigVar cv_show_background2d("show_background2d", "Draw background", "true");
 ConfigVar cv_background2d_manual("background2d_manual", "Manual 2d background scrolling", "false");
 
+/**
+ * Writes the UV vector of a tile to a vertex buffer.
+ *
+ * @param[out] write_iterator The first vertex of the tile in the locked buffer.
+ * @param[in] u1 Left texture coordinate.
+ * @param[in] v1 Top texture coordinate.
+ * @param[in] u2 Right texture coordinate.
+ * @param[in] v2 Bottom texture coordinate.
+ */
+static void WriteTileUV(
+  float* write_iterator, const float u1, const float v1, const float u2, const float v2
+){
+    write_iterator += 7;
+    *write_iterator ++ = u1;
+    *write_iterator ++ = v1;
+    write_iterator += 7;
+    *write_iterator ++ = u2;
+    *write_iterator ++ = v1;
+    write_iterator += 7;
+    *write_iterator ++ = u2;
+    *write_iterator ++ = v2;
+    write_iterator += 7;
+    *write_iterator ++ = u1;
+    *write_iterator ++ = v1;
+    write_iterator += 7;
+    *write_iterator ++ = u2;
+    *write_iterator ++ = v2;
+    write_iterator += 7;
+    *write_iterator ++ = u1;
+    *write_iterator ++ = v2;
+}
+
 Background2D::Background2D():
   alpha_max_vertex_count_(0),
   add_max_vertex_count_(0),
@@ -119,35 +151,33 @@ void Background2D::Hide(){scene_manager_->removeRenderQueueListener(this);}
 void Background2D::Show(){scene_manager_->addRenderQueueListener(this);}
 
 void Background2D::Update(){
+    const float delta_time = Timer::getSingleton().GetGameTimeDelta();
     for (unsigned int i = 0; i < animation_played_.size(); ++ i){
-        for (unsigned int j = 0; j < animations_.size(); ++ j){
-            if (animations_[j]->GetName() == animation_played_[i].name){
-                float delta_time = Timer::getSingleton().GetGameTimeDelta();
-                float time = animations_[j]->GetTime();
-                float end_time = animations_[j]->GetLength();
-
-                // If animation ended
-                if (time + delta_time >= end_time){
-                    // Set to last frame of animation.
-                    if (time != end_time) animations_[j]->SetTime(end_time);
-
-                    if (animation_played_[i].state == Background2DAnimation::ONCE){
-                        for (unsigned int k = 0; k < animation_played_[i].sync.size(); ++k){
-                            ScriptManager::getSingleton().ContinueScriptExecution(
-                              animation_played_[i].sync[k]
-                            );
-                        }
-                        animation_played_[i].sync.clear();
-                        // Mark to delete this way:
-                        animation_played_[i].name = "";
-                    }
-                    // In case of looped, sync with end:
-                    else animations_[j]->SetTime(time + delta_time - end_time);
-                }
-                else animations_[j]->AddTime(delta_time);
+        bool ended = false;
+        for (Background2DAnimation* animation : animation_played_[i].animations){
+            float time = animation->GetTime();
+            float end_time = animation->GetLength();
+
+            // If animation ended
+            if (time + delta_time >= end_time){
+                ended = true;
+                // Set to last frame of animation.
+                if (time != end_time) animation->SetTime(end_time);
+                // In case of looped, sync with end:
+                if (animation_played_[i].state != Background2DAnimation::ONCE)
+                    animation->SetTime(time + delta_time - end_time);
             }
+            else animation->AddTime(delta_time);
+        }
+        if (ended && animation_played_[i].state == Background2DAnimation::ONCE){
+            for (unsigned int k = 0; k < animation_played_[i].sync.size(); ++k)
+                ScriptManager::getSingleton().ContinueScriptExecution(animation_played_[i].sync[k]);
+            animation_played_[i].sync.clear();
+            // Mark to delete this way:
+            animation_played_[i].name = "";
         }
     }
+    ApplyTileUV();
 
     // Remove stopped animations.
     std::vector<AnimationPlayed>::iterator i = animation_played_.begin();
@@ -257,6 +287,7 @@ void Background2D::Clear(){
         for(unsigned int j = 0; j < animation_played_[i].sync.size(); ++j)
             ScriptManager::getSingleton().ContinueScriptExecution(animation_played_[i].sync[j]);
     animation_played_.clear();
+    pending_uv_.clear();
     tiles_.clear();
     DestroyVertexBuffers();
     CreateVertexBuffers();
@@ -574,46 +605,65 @@ void Background2D::UpdateTileUV(
     float* write_iterator
       = static_cast<float*>(vertex_buffer->lock(Ogre::HardwareBuffer::HBL_NORMAL));
     write_iterator += tiles_[tile_id].start_vertex_index * TILE_VERTEX_INDEX_SIZE;
-    write_iterator += 7;
-    *write_iterator ++ = u1;
-    *write_iterator ++ = v1;
-    write_iterator += 7;
-    *write_iterator ++ = u2;
-    *write_iterator ++ = v1;
-    write_iterator += 7;
-    *write_iterator ++ = u2;
-    *write_iterator ++ = v2;
-    write_iterator += 7;
-    *write_iterator ++ = u1;
-    *write_iterator ++ = v1;
-    write_iterator += 7;
-    *write_iterator ++ = u2;
-    *write_iterator ++ = v2;
-    write_iterator += 7;
-    *write_iterator ++ = u1;
-    *write_iterator ++ = v2;
+    WriteTileUV(write_iterator, u1, v1, u2, v2);
     vertex_buffer->unlock();
 }
 
+void Background2D::QueueTileUV(
+  const unsigned int tile_id, const float u1, const float v1, const float u2, const float v2
+){
+    if (tile_id >= tiles_.size()){
+        LOG_ERROR("Tile with id " + Ogre::StringConverter::toString( tile_id ) + " doesn't exist.");
+        return;
+    }
+    pending_uv_.push_back(TileUV{tile_id, u1, v1, u2, v2});
+}
+
+void Background2D::ApplyTileUV(){
+    if (pending_uv_.empty()) return;
+    const Blending blendings[] = {VGears::B_ALPHA, VGears::B_ADD, VGears::B_SUBTRACT};
+    const Ogre::HardwareVertexBufferSharedPtr vertex_buffers[]
+      = {alpha_vertex_buffer_, add_vertex_buffer_, subtract_vertex_buffer_};
+    for (int b = 0; b < 3; ++ b){
+        float* vertices = nullptr;
+        for (const TileUV& uv : pending_uv_){
+            const Tile& tile = tiles_[uv.tile_id];
+            if (tile.blending != blendings[b]) continue;
+            if (vertices == nullptr){
+                vertices = static_cast<float*>(
+                  vertex_buffers[b]->lock(Ogre::HardwareBuffer::HBL_NORMAL)
+                );
+            }
+            WriteTileUV(
+              vertices + tile.start_vertex_index * TILE_VERTEX_INDEX_SIZE,
+              uv.u1, uv.v1, uv.u2, uv.v2
+            );
+        }
+        if (vertices != nullptr) vertex_buffers[b]->unlock();
+    }
+    pending_uv_.clear();
+}
+
 void Background2D::AddAnimation(Background2DAnimation* animation){animations_.push_back(animation);}
 
 void Background2D::PlayAnimation(
   const Ogre::String& animation, const Background2DAnimation::State state
 ){
-    bool found = false;
+    AnimationPlayed anim;
     for (unsigned int i = 0; i < animations_.size(); ++ i){
         if (animations_[i]->GetName() == animation){
-            found = true;
+            anim.animations.push_back(animations_[i]);
             animations_[i]->SetTime(0);
             animations_[i]->AddTime(0);
         }
     }
+    // Show the first keyframes now, instead of waiting for the next update.
+    ApplyTileUV();
     for (unsigned int i = 0; i < animation_played_.size(); ++ i){
         if (animation_played_[i].name == animation)
             animation_played_.erase(animation_played_.begin() + i);
     }
-    if(found == true){
-        AnimationPlayed anim;
+    if(anim.animations.empty() == false){
         anim.name = animation;
         anim.state = state;
         animation_played_.push_back(anim);
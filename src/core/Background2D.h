@@ -328,6 +328,22 @@ class Background2D : public Ogre::RenderQueueListener{
           const unsigned int tile_id, const float u1, const float v1, const float u2, const float v2
         );
 
+        /**
+         * Queues an update of the UV vector of a tile.
+         *
+         * Queued updates are written in {@see Update}, locking each vertex buffer only once for
+         * all of them.
+         *
+         * @param[in] tile_id ID of the tile to update.
+         * @param[in] u1
+         * @param[in] v1
+         * @param[in] u2
+         * @param[in] v2
+         */
+        void QueueTileUV(
+          const unsigned int tile_id, const float u1, const float v1, const float u2, const float v2
+        );
+
         /**
          * Adds an animation to the background.
          *
@@ -338,6 +354,8 @@ class Background2D : public Ogre::RenderQueueListener{
         /**
          * Plays an animation.
          *
+         * The first keyframe of the animation is shown immediately.
+         *
          * @param[in] animation The animation to play.
          * @param[in] state Animation state.
          */
@@ -487,6 +505,42 @@ class Background2D : public Ogre::RenderQueueListener{
 
     private:
 
+        /**
+         * A queued update of the UV vector of a tile.
+         */
+        struct TileUV{
+
+            /**
+             * ID of the tile to update.
+             */
+            unsigned int tile_id;
+
+            /**
+             * Left texture coordinate.
+             */
+            float u1;
+
+            /**
+             * Top texture coordinate.
+             */
+            float v1;
+
+            /**
+             * Right texture coordinate.
+             */
+            float u2;
+
+            /**
+             * Bottom texture coordinate.
+             */
+            float v2;
+        };
+
+        /**
+         * Writes the queued tile UV updates to the vertex buffers.
+         */
+        void ApplyTileUV();
+
         /**
          * Creates all vertex buffers.
          */
@@ -663,6 +717,11 @@ class Background2D : public Ogre::RenderQueueListener{
              * Animation state.
              */
             Background2DAnimation::State state;
+
+            /**
+             * The animations with the name, one for each tile they apply to.
+             */
+            std::vector<Background2DAnimation*> animations;
         };
 
         /**
@@ -674,4 +733,9 @@ class Background2D : public Ogre::RenderQueueListener{
          * List of animations.
          */
         std::vector<Background2DAnimation*> animations_;
+
+        /**
+         * Tile UV updates queued for the next {@see Update}.
+         */
+        std::vector<TileUV> pending_uv_;
 };
@@ -13,6 +13,7 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
 #include <Ogre.h>
 #include "core/Background2DAnimation.h"
 #include "core/Background2D.h"
@@ -24,7 +25,9 @@ Background2DAnimation::Background2DAnimation(
     background_(background),
     tile_index_(tile_index),
     time_(0),
-    length_(0)
+    length_(0),
+    uv_cursor_(0),
+    applied_uv_(-1)
 {}
 
 Background2DAnimation::~Background2DAnimation(){}
@@ -32,27 +35,35 @@ Background2DAnimation::~Background2DAnimation(){}
 void Background2DAnimation::AddTime(const float time){
     time_ += time;
     if(time_ > length_) time_ = length_;
-    if(uv_.size() > 0){
-        int min_id = -1;
-        float min_time = 0;
-        for (unsigned int i = 0; i < uv_.size(); ++ i){
-            if (uv_[i].time <= time_ && uv_[i].time >= min_time){
-                min_id = i;
-                min_time = uv_[i].time;
-            }
-        }
+    if (uv_.empty()) return;
 
-        if(min_id != -1){
-            background_->UpdateTileUV(
-              tile_index_, uv_[min_id].u1, uv_[min_id].v1,
-              uv_[min_id].u2, uv_[min_id].v2);
+    // Animations play forward, so the cursor is usually still valid or one keyframe behind.
+    if (!IsCursorAt(uv_cursor_)){
+        if (IsCursorAt(uv_cursor_ + 1)) ++ uv_cursor_;
+        else{
+            uv_cursor_ = std::upper_bound(
+              uv_.begin(), uv_.end(), time_,
+              [](const float time, const Background2DKeyFrameUV& key_frame){
+                  return time < key_frame.time;
+              }
+            ) - uv_.begin();
         }
     }
+
+    // The last keyframe at or before the current time. Keyframes before the start are ignored.
+    if (uv_cursor_ == 0 || uv_[uv_cursor_ - 1].time < 0) return;
+    const int id = static_cast<int>(uv_cursor_) - 1;
+    if (id == applied_uv_) return;
+    applied_uv_ = id;
+    background_->QueueTileUV(tile_index_, uv_[id].u1, uv_[id].v1, uv_[id].u2, uv_[id].v2);
 }
 
 const Ogre::String& Background2DAnimation::GetName() const{return name_;}
 
-void Background2DAnimation::SetTime(const float time){time_ = time;}
+void Background2DAnimation::SetTime(const float time){
+    time_ = time;
+    applied_uv_ = -1;
+}
 
 float Background2DAnimation::GetTime() const{return time_;}
 
@@ -80,5 +91,20 @@ void Background2DAnimation::AddUVKeyFrame(
     uv_key_frame.v1 = v1;
     uv_key_frame.u2 = u2;
     uv_key_frame.v2 = v2;
-    uv_.push_back(uv_key_frame);
+    uv_.insert(
+      std::upper_bound(
+        uv_.begin(), uv_.end(), time, [](const float time, const Background2DKeyFrameUV& key_frame){
+            return time < key_frame.time;
+        }
+      ),
+      uv_key_frame
+    );
+    uv_cursor_ = 0;
+    applied_uv_ = -1;
+}
+
+bool Background2DAnimation::IsCursorAt(const size_t cursor) const{
+    if (cursor > uv_.size()) return false;
+    return (cursor == uv_.size() || uv_[cursor].time > time_)
+      && (cursor == 0 || uv_[cursor - 1].time <= time_);
 }
@@ -65,6 +65,10 @@ class Background2DAnimation{
         /**
          * Adds time, so the animation state is changed according to it.
          *
+         * The tile texture coordinates are set to the last keyframe at or before the new time.
+         * They are only queued in the background if the keyframe changes, and written with the
+         * rest of the tiles in {@see Background2D::Update}.
+         *
          * @param[in] time The time passed
          * @todo time is in seconds?
          */
@@ -80,6 +84,9 @@ class Background2DAnimation{
         /**
          * Sets the time the animation has been running.
          *
+         * The tile is not updated until the next call to {@see AddTime}, which will set it even
+         * if the keyframe doesn't change.
+         *
          * @param[in] time The time the animation has been running.
          * @todo time is in seconds?
          */
@@ -147,6 +154,15 @@ class Background2DAnimation{
          */
         Background2DAnimation();
 
+        /**
+         * Checks if a keyframe index is the first keyframe after the current time.
+         *
+         * @param[in] cursor The keyframe index. It can be past the last keyframe.
+         * @return True if all the keyframes before the index are at or before the current time,
+         * and all the rest after it.
+         */
+        bool IsCursorAt(const size_t cursor) const;
+
         /**
          * The animation name.
          */
@@ -204,8 +220,20 @@ class Background2DAnimation{
         };
 
         /**
-         * Keyframe list.
+         * Keyframe list, sorted by time.
+         *
+         * Keyframes with the same time are kept in the order they were added.
          */
         std::vector<Background2DKeyFrameUV> uv_;
+
+        /**
+         * Index of the first keyframe after the current time.
+         */
+        size_t uv_cursor_;
+
+        /**
+         * Index of the last keyframe set to the tile, or -1 if it must be set again.
+         */
+        int applied_uv_;
 };
 
@@ -20,6 +20,7 @@
 #include <OgreStringConverter.h>
 #include "Console.h"
 #include "EntityManager.h"
+#include "FieldIndex.h"
 #include "Logger.h"
 #include "XmlMapFile.h"
 #include "XmlMapsFile.h"
@@ -292,11 +293,10 @@ void CmdMap(const Ogre::StringVector& params){
         Console::getSingleton().AddTextToOutput("Usage: /map [map_id]");
         return;
     }
+    const Ogre::String& file_name = FieldIndex::getSingleton().GetFileName(params[1]);
+    if (file_name.empty()) return;
     EntityManager::getSingleton().Clear();
-    XmlMapsFile xml("./data/maps.xml");
-    Ogre::String file_name = xml.GetMapFileNameByName(params[1]);
-    XmlMapFile xml_map("./data/" + file_name);
-    xml_map.LoadMap();
+    XmlMapFile::LoadMap(FieldIndex::FIELDS_DIR, file_name);
 }
 
 /**
@@ -305,8 +305,8 @@ void CmdMap(const Ogre::StringVector& params){
  * @param[in] complete_params The map names will be loaded here.
  */
 void CmdMapCompletion(Ogre::StringVector& complete_params){
-    XmlMapsFile xml("./data/maps.xml");
-    xml.GetMapNames(complete_params);
+    const Ogre::StringVector& names = FieldIndex::getSingleton().GetNames();
+    complete_params.insert(complete_params.end(), names.begin(), names.end());
 }
 
 /**
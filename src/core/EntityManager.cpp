@@ -708,18 +708,16 @@ bool EntityManager::SetEntityOnWalkmesh(Entity* entity){
     position2.y = position3.y;
     std::vector<std::pair<int, float>> triangles;
     // Search for possible triangles.
-    for (int i = 0; i < walkmesh_.GetNumberOfTriangles(); ++ i){
-        Ogre::Vector3 A3 = walkmesh_.GetA(i);
-        Ogre::Vector3 B3 = walkmesh_.GetB(i);
-        Ogre::Vector3 C3 = walkmesh_.GetC(i);
+    const int triangle_count = walkmesh_.GetNumberOfTriangles();
+    for (int i = 0; i < triangle_count; ++ i){
+        const Ogre::Vector3& A3 = walkmesh_.GetAUnchecked(i);
+        const Ogre::Vector3& B3 = walkmesh_.GetBUnchecked(i);
+        const Ogre::Vector3& C3 = walkmesh_.GetCUnchecked(i);
         Ogre::Vector2 A2(A3.x, A3.y);
         Ogre::Vector2 B2(B3.x, B3.y);
         Ogre::Vector2 C2(C3.x, C3.y);
-        if (Ogre::Math::pointInTri2D(position2, A2, B2, C2) == true){
-            triangles.push_back(std::make_pair(i, PointElevation(
-              position2, walkmesh_.GetA(i), walkmesh_.GetB(i), walkmesh_.GetC(i)
-            )));
-        }
+        if (Ogre::Math::pointInTri2D(position2, A2, B2, C2) == true)
+            triangles.push_back(std::make_pair(i, PointElevation(position2, A3, B3, C3)));
     }
     // If the coordinates doesn't match any triangle, exit.
     if (triangles.size() == 0 && entity == player_entity_){
@@ -766,7 +764,7 @@ bool EntityManager::PerformWalkmeshMove(Entity* entity, const float speed){
         return false;
     }
     int current_triangle = entity->GetMoveTriangleId();
-    if (current_triangle == -1){
+    if (!walkmesh_.IsValidTriangle(current_triangle)){
         LOG_ERROR("Entity '" + entity->GetName() + "' not placed on walkmesh and can't move.");
         return false;
     }
@@ -784,9 +782,9 @@ bool EntityManager::PerformWalkmeshMove(Entity* entity, const float speed){
     // Shorten move vector by triangle angle
     end_point.x = start_point.x + direction.x;
     end_point.y = start_point.y + direction.y;
-    Ogre::Vector3 A3 = walkmesh_.GetA(current_triangle);
-    Ogre::Vector3 B3 = walkmesh_.GetB(current_triangle);
-    Ogre::Vector3 C3 = walkmesh_.GetC(current_triangle);
+    const Ogre::Vector3& A3 = walkmesh_.GetAUnchecked(current_triangle);
+    const Ogre::Vector3& B3 = walkmesh_.GetBUnchecked(current_triangle);
+    const Ogre::Vector3& C3 = walkmesh_.GetCUnchecked(current_triangle);
     end_point.z = PointElevation(Ogre::Vector2(end_point.x, end_point.y), A3, B3, C3);
     Ogre::Vector3 temp = end_point - start_point;
     temp.normalise();
@@ -1011,12 +1009,12 @@ bool EntityManager::WalkmeshBorderCross(
         return false;
     }
     int current_triangle = entity->GetMoveTriangleId();
-    if (current_triangle == -1) return true;
+    if (!walkmesh_.IsValidTriangle(current_triangle)) return true;
     Ogre::Vector2 pos = Ogre::Vector2(position.x, position.y);
     for (;;){
-        Ogre::Vector3 A3 = walkmesh_.GetA(current_triangle);
-        Ogre::Vector3 B3 = walkmesh_.GetB(current_triangle);
-        Ogre::Vector3 C3 = walkmesh_.GetC(current_triangle);
+        const Ogre::Vector3& A3 = walkmesh_.GetAUnchecked(current_triangle);
+        const Ogre::Vector3& B3 = walkmesh_.GetBUnchecked(current_triangle);
+        const Ogre::Vector3& C3 = walkmesh_.GetCUnchecked(current_triangle);
         Ogre::Vector2 A(A3.x, A3.y);
         Ogre::Vector2 B(B3.x, B3.y);
         Ogre::Vector2 C(C3.x, C3.y);
@@ -1024,16 +1022,17 @@ bool EntityManager::WalkmeshBorderCross(
         float sign2 = SideOfVector(pos, C, B);
         float sign3 = SideOfVector(pos, A, C);
         int next_triangle = -1;
-        if (sign1 < 0) next_triangle = walkmesh_.GetAccessSide(current_triangle, 0);
-        else if (sign2 < 0) next_triangle = walkmesh_.GetAccessSide(current_triangle, 1);
-        else if (sign3 < 0) next_triangle = walkmesh_.GetAccessSide(current_triangle, 2);
+        if (sign1 < 0) next_triangle = walkmesh_.GetAccessSideUnchecked(current_triangle, 0);
+        else if (sign2 < 0) next_triangle = walkmesh_.GetAccessSideUnchecked(current_triangle, 1);
+        else if (sign3 < 0) next_triangle = walkmesh_.GetAccessSideUnchecked(current_triangle, 2);
         else{
             position.z = PointElevation(pos, A3, B3, C3);
             entity->SetMoveTriangleId(current_triangle);
             return false;
         }
-        if (next_triangle >= 0){
-            bool lock = walkmesh_.IsLocked(next_triangle);
+        // Access sides come from the walkmesh file, so they are validated once here.
+        if (walkmesh_.IsValidTriangle(next_triangle)){
+            bool lock = walkmesh_.IsLockedUnchecked(next_triangle);
             if (lock == false){
                 current_triangle = next_triangle;
                 continue;
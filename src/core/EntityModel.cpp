@@ -19,11 +19,14 @@
 #include "core/EntityModel.h"
 #include "core/EntityManager.h"
 #include "core/Logger.h"
+#include "core/ResourceGroupLoader.h"
 #include "core/Timer.h"
 
+const int EntityModel::NO_ANIMATION = -1;
+
 EntityModel::EntityModel(
   const Ogre::String& name, const Ogre::String file_name, Ogre::SceneNode* node
-): Entity(name, node), animation_current_(nullptr)
+): Entity(name, node), animation_current_(nullptr), animation_current_handle_(NO_ANIMATION)
 {
     Ogre::SceneManager* scene_manager;
     Ogre::String res_group;
@@ -38,9 +41,19 @@ EntityModel::EntityModel(
         default:
             res_group = "FIELD_MODELS";
     }
+    ResourceGroupLoader::getSingleton().Wait();
     scene_manager = Ogre::Root::getSingleton().getSceneManager("Scene");
     model_ = scene_manager->createEntity(name_, file_name, res_group);
     model_->setVisible(false);
+    if (model_->getAllAnimationStates() != nullptr){
+        Ogre::AnimationStateIterator animations
+          = model_->getAllAnimationStates()->getAnimationStateIterator();
+        while (animations.hasMoreElements() == true){
+            animation_handles_[animations.peekNextKey()]
+              = static_cast<int>(animation_states_.size());
+            animation_states_.push_back(animations.getNext());
+        }
+    }
     PlayAnimation(animation_default_, Entity::AUTO_ANIMATION, Entity::PLAY_LOOPED, 0, -1);
     model_node_->attachObject(model_);
 }
@@ -60,27 +73,19 @@ bool EntityModel::IsVisible() const{return model_->isVisible();}
 
 Ogre::Entity* EntityModel::GetModel(){return model_;}
 
+int EntityModel::GetAnimationHandle(const Ogre::String& animation) const{
+    auto handle = animation_handles_.find(animation);
+    return (handle == animation_handles_.end()) ? NO_ANIMATION : handle->second;
+}
+
 void EntityModel::PlayAnimation(
   const Ogre::String& animation, Entity::AnimationState state,
   Entity::AnimationPlayType play_type, const float start, const float end
 ){
-    if (animation_current_ != nullptr) animation_current_->setEnabled(false);
-    if (
-      model_->getAllAnimationStates() != nullptr
-      && model_->getAllAnimationStates()->hasAnimationState(animation) == true
-    ){
-        animation_current_name_ = animation;
-        animation_current_ = model_->getAnimationState(animation);
-        animation_current_->setLoop((play_type == Entity::PLAY_LOOPED) ? true : false);
-        animation_current_->setEnabled(true);
-        animation_current_->setTimePosition(
-          (start == -1) ? animation_current_->getLength() : start
-        );
-        animation_end_time_ = (end == -1) ? animation_current_->getLength() : end;
-        animation_state_ = state;
-        animation_play_type_ = play_type;
-    }
+    const int handle = GetAnimationHandle(animation);
+    if (handle != NO_ANIMATION) PlayAnimation(handle, state, play_type, start, end);
     else{
+        if (animation_current_ != nullptr) animation_current_->setEnabled(false);
         // Idle is hard coded to the default animation,
         // so don't spam crazy amounts of errors if its not found.
         if (animation != "Idle"){
@@ -91,19 +96,38 @@ void EntityModel::PlayAnimation(
     }
 }
 
+void EntityModel::PlayAnimation(
+  const int handle, Entity::AnimationState state, Entity::AnimationPlayType play_type,
+  const float start, const float end
+){
+    if (animation_current_ != nullptr) animation_current_->setEnabled(false);
+    animation_current_handle_ = handle;
+    animation_current_ = animation_states_[handle];
+    animation_current_name_ = animation_current_->getAnimationName();
+    animation_current_->setLoop((play_type == Entity::PLAY_LOOPED) ? true : false);
+    animation_current_->setEnabled(true);
+    animation_current_->setTimePosition((start == -1) ? animation_current_->getLength() : start);
+    animation_end_time_ = (end == -1) ? animation_current_->getLength() : end;
+    animation_state_ = state;
+    animation_play_type_ = play_type;
+}
+
 void EntityModel::PlayAnimationContinue(const Ogre::String& animation){
+    // Called every frame with the animation that should be playing, which usually already is.
     if (
-      // If animation isn't being played...
-      animation_current_ == nullptr
-      // ... the animatio to play exists (use this to avoid exception)...
-      || (model_->getAllAnimationStates()->hasAnimationState(animation) == true
-      && (
-        // and (the requested animation is not currently playing...
-        animation_current_ != model_->getAnimationState(animation)
-        // or it's currently playing  but it's not looped)
-        || animation_play_type_ != Entity::PLAY_LOOPED))
+      animation_current_ != nullptr && animation_play_type_ == Entity::PLAY_LOOPED
+      && animation == animation_current_name_
     ){
+        return;
+    }
+    // If animation isn't being played, or the animation to play exists (play it anyway if it's
+    // the same one, because it's not looped).
+    if (animation_current_ == nullptr)
         PlayAnimation(animation, Entity::AUTO_ANIMATION, Entity::PLAY_LOOPED, 0, -1);
+    else{
+        const int handle = GetAnimationHandle(animation);
+        if (handle != NO_ANIMATION)
+            PlayAnimation(handle, Entity::AUTO_ANIMATION, Entity::PLAY_LOOPED, 0, -1);
     }
 }
 
@@ -133,7 +157,7 @@ void EntityModel::UpdateAnimation(const float delta){
                   ? animation_current_->getTimePosition()
                   : animation_current_->getTimePosition() - animation_current_->getLength();
                 PlayAnimation(
-                  animation_current_name_, Entity::AUTO_ANIMATION, Entity::PLAY_LOOPED, time, -1
+                  animation_current_handle_, Entity::AUTO_ANIMATION, Entity::PLAY_LOOPED, time, -1
                 );
                 animation_current_->addTime(delta_mod);
             }
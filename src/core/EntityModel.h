@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
 #include "Entity.h"
 
 /**
@@ -79,6 +81,8 @@ class EntityModel : public Entity{
         /**
          * Resumes an animation.
          *
+         * Does nothing if the animation is already being played looped, without looking it up.
+         *
          * @param[in] animation The name of the animation to resume.
          */
         virtual void PlayAnimationContinue(const Ogre::String& animation);
@@ -97,6 +101,33 @@ class EntityModel : public Entity{
          */
         EntityModel();
 
+        /**
+         * Handle for animations the model doesn't have.
+         */
+        static const int NO_ANIMATION;
+
+        /**
+         * Retrieves the handle of an animation.
+         *
+         * @param[in] animation Name of the animation.
+         * @return The animation handle, or {@see NO_ANIMATION} if the model doesn't have it.
+         */
+        int GetAnimationHandle(const Ogre::String& animation) const;
+
+        /**
+         * Plays an animation of the model.
+         *
+         * @param[in] handle Handle of the animation to play. It must be valid.
+         * @param[in] state Initial state of the animation.
+         * @param[in] play_type Play mode, for single or looped playbacks.
+         * @param[in] start Start point in time of the animation, in seconds.
+         * @param[in] end End point in time of the animation, in seconds.
+         */
+        void PlayAnimation(
+          const int handle, AnimationState state, AnimationPlayType play_type, const float start,
+          const float end
+        );
+
         /**
          * The model.
          */
@@ -106,5 +137,23 @@ class EntityModel : public Entity{
          * The current animation state.
          */
         Ogre::AnimationState* animation_current_;
+
+        /**
+         * Handle of the current animation, or {@see NO_ANIMATION}.
+         */
+        int animation_current_handle_;
+
+        /**
+         * Animation states of the model, indexed by handle.
+         *
+         * They are resolved once, when the model is loaded, so playing and updating animations
+         * don't look them up by name.
+         */
+        std::vector<Ogre::AnimationState*> animation_states_;
+
+        /**
+         * Animation handles, by animation name.
+         */
+        std::unordered_map<Ogre::String, int> animation_handles_;
 };
 
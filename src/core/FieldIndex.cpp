@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include "core/FieldIndex.h"
+#include "core/Logger.h"
+#include "core/XmlMapsFile.h"
+
+template<>FieldIndex* Ogre::Singleton<FieldIndex>::msSingleton = nullptr;
+
+const Ogre::String FieldIndex::FIELDS_DIR("./data/fields/");
+
+FieldIndex::FieldIndex(){
+    XmlMapsFile xml(FIELDS_DIR + "_fields.xml");
+    Ogre::StringVector file_names;
+    xml.GetMapFiles(names_, file_names);
+    file_names_.reserve(names_.size());
+    for (size_t i = 0; i < names_.size(); ++ i) file_names_.emplace(names_[i], file_names[i]);
+}
+
+FieldIndex::~FieldIndex(){}
+
+const Ogre::String& FieldIndex::GetFileName(const Ogre::String& name) const{
+    static const Ogre::String none;
+    const auto file_name = file_names_.find(name);
+    if (file_name == file_names_.end()){
+        LOG_WARNING("Can't find map \"" + name + "\" in " + FIELDS_DIR + "_fields.xml.");
+        return none;
+    }
+    return file_name->second;
+}
+
+const Ogre::StringVector& FieldIndex::GetNames() const{return names_;}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <OgreSingleton.h>
+#include <OgreStringVector.h>
+
+/**
+ * Index of the installed fields.
+ *
+ * The field list is read once, and field names are resolved to map files from memory for the
+ * rest of the session.
+ */
+class FieldIndex : public Ogre::Singleton<FieldIndex>{
+
+    public:
+
+        /**
+         * Directory of the fields.
+         */
+        static const Ogre::String FIELDS_DIR;
+
+        /**
+         * Constructor.
+         *
+         * Reads the field list, {@see FIELDS_DIR}/_fields.xml.
+         */
+        FieldIndex();
+
+        /**
+         * Destructor.
+         */
+        virtual ~FieldIndex();
+
+        /**
+         * Retrieves the map file of a field.
+         *
+         * @param[in] name Name of the field.
+         * @return Path to the map file, relative to {@see FIELDS_DIR}, or an empty string if
+         * there is no such field.
+         */
+        const Ogre::String& GetFileName(const Ogre::String& name) const;
+
+        /**
+         * Retrieves the names of all fields.
+         *
+         * @return The field names, in the order of the field list.
+         */
+        const Ogre::StringVector& GetNames() const;
+
+    private:
+
+        /**
+         * Field names, in the order of the field list.
+         */
+        Ogre::StringVector names_;
+
+        /**
+         * Map files, by field name.
+         */
+        std::unordered_map<Ogre::String, Ogre::String> file_names_;
+};
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <OgreException.h>
+#include <OgreLogManager.h>
+#include "core/FieldPreloader.h"
+#include "core/FieldIndex.h"
+
+template<>FieldPreloader* Ogre::Singleton<FieldPreloader>::msSingleton = nullptr;
+
+const size_t FieldPreloader::CACHE_SIZE(4);
+
+const Ogre::String FieldPreloader::FIELDS_DIR("./data/fields/");
+
+FieldPreloader::FieldPreloader(): stop_(false), thread_(boost::ref(*this)){}
+
+FieldPreloader::~FieldPreloader(){
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        stop_ = true;
+        queue_.clear();
+    }
+    condition_.notify_all();
+    thread_.join();
+}
+
+void FieldPreloader::Preload(const std::vector<Ogre::String>& names){
+    std::vector<Ogre::String> pending;
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        for (const Ogre::String& name : names)
+            if (!IsKnown(name) && std::find(pending.begin(), pending.end(), name) == pending.end())
+                pending.push_back(name);
+    }
+    if (pending.empty()) return;
+    // The field index is used here, in the main thread, so missing fields are reported as usual.
+    std::vector<Request> requests;
+    for (const Ogre::String& name : pending){
+        const Ogre::String& file_name = FieldIndex::getSingleton().GetFileName(name);
+        if (!file_name.empty()) requests.push_back(Request{name, file_name});
+    }
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        for (const Request& request : requests)
+            if (!IsKnown(request.name)) queue_.push_back(request);
+    }
+    condition_.notify_all();
+}
+
+std::shared_ptr<const VGears::FieldBundle> FieldPreloader::Get(const Ogre::String& name){
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    queue_.erase(
+      std::remove_if(
+        queue_.begin(), queue_.end(), [&name](const Request& request){
+            return request.name == name;
+        }
+      ),
+      queue_.end()
+    );
+    while (loading_ == name) condition_.wait(lock);
+    for (auto entry = cache_.begin(); entry != cache_.end(); ++ entry){
+        if (entry->first != name) continue;
+        cache_.splice(cache_.begin(), cache_, entry);
+        return cache_.front().second;
+    }
+    return nullptr;
+}
+
+void FieldPreloader::Clear(){
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    queue_.clear();
+    cache_.clear();
+}
+
+void FieldPreloader::operator()(){
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    while (true){
+        while (!stop_ && queue_.empty()) condition_.wait(lock);
+        if (stop_) return;
+        const Request request(queue_.front());
+        queue_.pop_front();
+        loading_ = request.name;
+        lock.unlock();
+
+        std::shared_ptr<VGears::FieldBundle> bundle(new VGears::FieldBundle());
+        bool loaded = false;
+        try{
+            if (!bundle->Open(FIELDS_DIR, request.file_name))
+                bundle->Import(FIELDS_DIR, request.file_name);
+            loaded = true;
+        }
+        catch (const Ogre::Exception& ex){
+            Ogre::LogManager::getSingleton().stream()
+              << "Can't preload field " << request.name << ": " << ex.getDescription();
+        }
+        catch (const std::exception& ex){
+            Ogre::LogManager::getSingleton().stream()
+              << "Can't preload field " << request.name << ": " << ex.what();
+        }
+
+        lock.lock();
+        loading_.clear();
+        if (loaded){
+            cache_.emplace_front(request.name, bundle);
+            if (cache_.size() > CACHE_SIZE) cache_.pop_back();
+        }
+        condition_.notify_all();
+    }
+}
+
+bool FieldPreloader::IsKnown(const Ogre::String& name) const{
+    if (loading_ == name) return true;
+    for (const Request& request : queue_) if (request.name == name) return true;
+    for (const CacheEntry& entry : cache_) if (entry.first == name) return true;
+    return false;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <boost/thread.hpp>
+#include <OgreSingleton.h>
+#include <OgreString.h>
+#include "map/VGearsFieldBundle.h"
+
+/**
+ * Loads fields in the background, before they are needed.
+ *
+ * When a field is loaded, the fields its gateways lead to are read and decoded in a worker
+ * thread: from their bundles if they are up to date, or from their XML files otherwise. The
+ * decoded fields are kept in a small least recently used cache, so a field jump only has to
+ * create the entities.
+ *
+ * The worker only reads files and builds unmanaged resources. Everything that touches the scene
+ * or the script state is done by {@see XmlMapFile} in the main thread.
+ */
+class FieldPreloader : public Ogre::Singleton<FieldPreloader>{
+
+    public:
+
+        /**
+         * Constructor.
+         *
+         * Starts the worker thread.
+         */
+        FieldPreloader();
+
+        /**
+         * Destructor.
+         *
+         * Pending requests are dropped, and the field being loaded is waited for.
+         */
+        virtual ~FieldPreloader();
+
+        /**
+         * Requests some fields to be loaded in the background.
+         *
+         * Fields already cached, queued or being loaded are not requested again. Fields that
+         * can't be found in the field list are ignored.
+         *
+         * @param[in] names Names of the fields to load.
+         */
+        void Preload(const std::vector<Ogre::String>& names);
+
+        /**
+         * Retrieves a preloaded field.
+         *
+         * If the field is being loaded, waits for it. If it's only queued, the request is
+         * dropped, since loading it in the calling thread is as fast.
+         *
+         * @param[in] name Name of the field.
+         * @return The decoded field, or null if it's not preloaded.
+         */
+        std::shared_ptr<const VGears::FieldBundle> Get(const Ogre::String& name);
+
+        /**
+         * Drops all cached fields and pending requests.
+         */
+        void Clear();
+
+        /**
+         * Worker thread loop.
+         */
+        void operator()();
+
+    private:
+
+        /**
+         * Maximum number of decoded fields kept in the cache.
+         */
+        static const size_t CACHE_SIZE;
+
+        /**
+         * Directory of the fields.
+         */
+        static const Ogre::String FIELDS_DIR;
+
+        /**
+         * A field to load.
+         */
+        struct Request{
+
+            /**
+             * Name of the field.
+             */
+            Ogre::String name;
+
+            /**
+             * Path to the map file, relative to {@see FIELDS_DIR}.
+             */
+            Ogre::String file_name;
+        };
+
+        /**
+         * A decoded field, with its name.
+         */
+        typedef std::pair<Ogre::String, std::shared_ptr<const VGears::FieldBundle>> CacheEntry;
+
+        /**
+         * Checks if a field is cached, queued or being loaded.
+         *
+         * The mutex must be locked by the caller.
+         *
+         * @param[in] name Name of the field.
+         * @return True if the field is cached, queued or being loaded.
+         */
+        bool IsKnown(const Ogre::String& name) const;
+
+        /**
+         * Guards the queue, the cache and the state of the worker.
+         */
+        boost::mutex mutex_;
+
+        /**
+         * Signalled when a request is queued, a field is loaded, or the worker must stop.
+         */
+        boost::condition_variable condition_;
+
+        /**
+         * Fields waiting to be loaded.
+         */
+        std::deque<Request> queue_;
+
+        /**
+         * Name of the field being loaded by the worker. Empty if none.
+         */
+        Ogre::String loading_;
+
+        /**
+         * Decoded fields, the most recently used first.
+         */
+        std::list<CacheEntry> cache_;
+
+        /**
+         * Indicates if the worker thread must finish.
+         */
+        bool stop_;
+
+        /**
+         * The worker thread.
+         */
+        boost::thread thread_;
+};
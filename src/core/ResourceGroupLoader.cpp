@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <OgreBuildSettings.h>
+#include <OgreException.h>
+#include <OgreLogManager.h>
+#include <OgreResourceGroupManager.h>
+#include "core/ResourceGroupLoader.h"
+
+template<>ResourceGroupLoader* Ogre::Singleton<ResourceGroupLoader>::msSingleton = nullptr;
+
+ResourceGroupLoader::ResourceGroupLoader(const std::chrono::steady_clock::time_point start):
+  start_(start), deferred_started_(false), first_frame_(false)
+{}
+
+ResourceGroupLoader::~ResourceGroupLoader(){
+    if (thread_.joinable()) thread_.join();
+}
+
+void ResourceGroupLoader::AddLocation(
+  const Ogre::String& location, const Ogre::String& type, const Ogre::String& group,
+  const bool recursive, const bool deferred
+){
+    if (deferred){
+        deferred_.push_back(Location{location, type, group, recursive});
+        return;
+    }
+    Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
+      location, type, group, recursive
+    );
+}
+
+void ResourceGroupLoader::Start(){
+    const auto start = std::chrono::steady_clock::now();
+    Ogre::ResourceGroupManager& manager(Ogre::ResourceGroupManager::getSingleton());
+    // Resources can be created in a deferred group before it's initialized, so the groups must
+    // exist from the start.
+    std::vector<Ogre::String> deferred_groups;
+    for (const Location& location : deferred_){
+        if (!manager.resourceGroupExists(location.group))
+            manager.createResourceGroup(location.group);
+        deferred_groups.push_back(location.group);
+    }
+    // Every other group, including the ones from the resources configuration file.
+    for (const Ogre::String& group : manager.getResourceGroups()){
+        if (std::find(deferred_groups.begin(), deferred_groups.end(), group)
+          != deferred_groups.end()) continue;
+        if (!manager.isResourceGroupInitialised(group)) manager.initialiseResourceGroup(group);
+    }
+    const double elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+    Ogre::LogManager::getSingleton().stream()
+      << "Initialized resource groups for the first screen in " << elapsed << " ms";
+#if OGRE_THREAD_SUPPORT == 1 || OGRE_THREAD_SUPPORT == 2
+    // With thread support levels 1 and 2 the resource managers lock their data, so the rest of
+    // the groups can be initialized while the first screen is drawn. Level 3 has threads but no
+    // locks, so it's handled as if there was no thread support.
+    deferred_started_ = true;
+    thread_ = std::thread(&ResourceGroupLoader::InitialiseDeferred, this);
+#endif
+}
+
+void ResourceGroupLoader::Wait(){
+    if (thread_.joinable()) thread_.join();
+    if (!deferred_started_){
+        deferred_started_ = true;
+        InitialiseDeferred();
+    }
+}
+
+bool ResourceGroupLoader::frameEnded(const Ogre::FrameEvent& evt){
+    if (first_frame_) return true;
+    first_frame_ = true;
+    const double elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start_
+    ).count();
+    Ogre::LogManager::getSingleton().stream() << "Time to first frame: " << elapsed << " ms";
+    // Without thread support, the rest of the groups are initialized after the first frame.
+    if (!deferred_started_) Wait();
+    return true;
+}
+
+void ResourceGroupLoader::InitialiseDeferred(){
+    const auto start = std::chrono::steady_clock::now();
+    Ogre::ResourceGroupManager& manager(Ogre::ResourceGroupManager::getSingleton());
+    std::vector<Ogre::String> groups;
+    try{
+        for (const Location& location : deferred_){
+            manager.addResourceLocation(
+              location.location, location.type, location.group, location.recursive
+            );
+            if (std::find(groups.begin(), groups.end(), location.group) == groups.end())
+                groups.push_back(location.group);
+        }
+        for (const Ogre::String& group : groups) manager.initialiseResourceGroup(group);
+    }
+    catch (const Ogre::Exception& ex){
+        Ogre::LogManager::getSingleton().stream()
+          << "Can't initialize deferred resource groups: " << ex.getDescription();
+        return;
+    }
+    catch (const std::exception& ex){
+        Ogre::LogManager::getSingleton().stream()
+          << "Can't initialize deferred resource groups: " << ex.what();
+        return;
+    }
+    const double elapsed = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+    Ogre::LogManager::getSingleton().stream()
+      << "Initialized " << groups.size() << " deferred resource groups in " << elapsed << " ms";
+}
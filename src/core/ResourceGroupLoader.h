@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <OgreFrameListener.h>
+#include <OgreSingleton.h>
+#include <OgreString.h>
+
+/**
+ * Initializes the resource groups.
+ *
+ * Groups needed to draw the first screen are initialized right away. The rest are only created
+ * at first, and their locations are indexed and their scripts parsed later: in a background
+ * thread if Ogre is built with thread support and locking (OGRE_THREAD_SUPPORT 1 or 2), or in the
+ * main thread just after the first frame otherwise. Code that uses a deferred group must call
+ * {@see Wait} first.
+ *
+ * It also logs the time it took to render the first frame.
+ */
+class ResourceGroupLoader :
+  public Ogre::Singleton<ResourceGroupLoader>, public Ogre::FrameListener
+{
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param[in] start When the application started, to measure the startup time.
+         */
+        ResourceGroupLoader(const std::chrono::steady_clock::time_point start);
+
+        /**
+         * Destructor.
+         *
+         * Waits for the background initialization, if it's still running.
+         */
+        virtual ~ResourceGroupLoader();
+
+        /**
+         * Adds a resource location.
+         *
+         * @param[in] location Path to the location.
+         * @param[in] type Archive type of the location.
+         * @param[in] group Resource group to add the location to.
+         * @param[in] recursive Whether subdirectories are indexed too.
+         * @param[in] deferred True to initialize the group after the first frame, false to add
+         * the location now and initialize the group in {@see Start}.
+         */
+        void AddLocation(
+          const Ogre::String& location, const Ogre::String& type, const Ogre::String& group,
+          const bool recursive, const bool deferred
+        );
+
+        /**
+         * Initializes every group that is not deferred, and starts initializing the rest.
+         */
+        void Start();
+
+        /**
+         * Waits until all deferred groups are initialized.
+         *
+         * If they are not being initialized in the background, initializes them now. Must be
+         * called from the main thread.
+         */
+        void Wait();
+
+        /**
+         * Called just after a frame has been rendered.
+         *
+         * Logs the time to the first frame and, if there is no background thread, initializes
+         * the deferred groups.
+         *
+         * @param[in] evt Frame event.
+         * @return Always true, to continue rendering.
+         */
+        bool frameEnded(const Ogre::FrameEvent& evt);
+
+    private:
+
+        /**
+         * A resource location.
+         */
+        struct Location{
+
+            /**
+             * Path to the location.
+             */
+            Ogre::String location;
+
+            /**
+             * Archive type of the location.
+             */
+            Ogre::String type;
+
+            /**
+             * Resource group to add the location to.
+             */
+            Ogre::String group;
+
+            /**
+             * Whether subdirectories are indexed too.
+             */
+            bool recursive;
+        };
+
+        /**
+         * Adds the deferred locations and initializes their groups.
+         */
+        void InitialiseDeferred();
+
+        /**
+         * When the application started.
+         */
+        std::chrono::steady_clock::time_point start_;
+
+        /**
+         * Locations of the deferred groups.
+         */
+        std::vector<Location> deferred_;
+
+        /**
+         * Background initialization thread. Not joinable if there is none.
+         */
+        std::thread thread_;
+
+        /**
+         * Whether the deferred groups are initialized, or being initialized in the background.
+         */
+        bool deferred_started_;
+
+        /**
+         * Whether the first frame has been rendered.
+         */
+        bool first_frame_;
+};
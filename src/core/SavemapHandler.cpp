@@ -99,6 +99,11 @@ void SavemapHandler::SetData(const unsigned int bank, const unsigned int address
     current_savemap_->SetData(bank, address, value);
 }
 
+int SavemapHandler::GetData(const unsigned int bank, const unsigned int address) const{
+    if (current_savemap_ == nullptr) return 0;
+    return current_savemap_->GetData(bank, address);
+}
+
 void SavemapHandler::SetControlKey(const char* control){
     if (current_savemap_ == nullptr) current_savemap_ = new Savemap();
     current_savemap_->SetControlKey(std::string(control));
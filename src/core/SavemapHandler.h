@@ -104,6 +104,15 @@ class SavemapHandler : public Ogre::Singleton<SavemapHandler>{
          */
         void SetData(const unsigned int bank, const unsigned int address, const int value);
 
+        /**
+         * Retrieves data from the current savemap memory banks.
+         *
+         * @param[in] bank The memory bank.
+         * @param[in] address The address in the bank.
+         * @return The value. 0 for invalid banks or addresses, or if there is no current savemap.
+         */
+        int GetData(const unsigned int bank, const unsigned int address) const;
+
         /**
          * Sets the control string of the current savemap.
          *
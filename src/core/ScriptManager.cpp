@@ -13,12 +13,19 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <boost/filesystem.hpp>
 #include "core/ConfigVar.h"
 #include "core/DebugDraw.h"
 #include "core/Logger.h"
 #include "core/ScriptManager.h"
 #include "core/ScriptManagerBinds.h"
 #include "core/ScriptManagerCommands.h"
+#include "core/ScriptManagerFfiBinds.h"
 #include "core/Timer.h"
 #include "core/Utilites.h"
 #include "core/XmlScriptsFile.h"
@@ -28,6 +35,23 @@ ConfigVar cv_debug_script(
   "debug_script", "Debug script flags. 0x01 - System, 0x02 - Entity, 0x04 - Ui.", "0"
 );
 
+ConfigVar cv_script_profile(
+  "script_profile", "Measure the time and instructions used by each script function", "false"
+);
+
+ConfigVar cv_script_budget(
+  "script_budget",
+  "Milliseconds each script type can run per frame before low priority scripts are deferred. "
+  "0 for no limit.",
+  "0"
+);
+
+ConfigVar cv_script_budget_priority(
+  "script_budget_priority",
+  "Scripts with this priority number or higher are deferred when the budget is exhausted",
+  "999"
+);
+
 /**
  * Script manager singleton.
  */
@@ -50,9 +74,26 @@ Ogre::String script_entity_type[] = {"SYSTEM", "ENTITY", "UI", "BATTLE"};
  */
 bool priority_queue_compare(QueueScript a, QueueScript b){return a.priority < b.priority;}
 
+const unsigned int ScriptManager::NAME_NONE(0);
+
+const unsigned int ScriptManager::NAME_ON_START(1);
+
+const unsigned int ScriptManager::NAME_ON_UPDATE(2);
+
+const unsigned int ScriptManager::NAME_ON_BUTTON(3);
+
+const int ScriptManager::PROFILE_HOOK_INSTRUCTIONS(1000);
+
 ScriptManager::ScriptManager():
-  system_table_name_("System"), entity_table_name_("EntityContainer"), ui_table_name_("UiContainer")
+  system_table_name_("System"), entity_table_name_("EntityContainer"),
+  ui_table_name_("UiContainer"), current_entity_(nullptr), current_function_(NAME_NONE),
+  sleep_id_(0), entity_order_(0), profiling_(false), profile_instructions_(0)
 {
+    // In the same order as the identifier constants.
+    GetNameId("");
+    GetNameId("on_start");
+    GetNameId("on_update");
+    GetNameId("on_button");
     lua_state_ = lua_open();
     luabind::open(lua_state_);
     luaopen_base(lua_state_);
@@ -61,6 +102,7 @@ ScriptManager::ScriptManager():
     luaopen_math(lua_state_);
     luaopen_io(lua_state_);
     InitBinds();
+    InitFfiBinds();
     InitCmd();
     // TODO: Use the one in data/ ?
     RunFile("system/system.lua");
@@ -70,6 +112,8 @@ ScriptManager::ScriptManager():
 
 ScriptManager::~ScriptManager(){lua_close(lua_state_);}
 
+void ScriptManager::InitFfiBinds(){OpenFfiBinds(lua_state_);}
+
 void ScriptManager::Input(const VGears::Event& event){
     if (
       (event.type == VGears::ET_KEY_PRESS || event.type == VGears::ET_KEY_REPEAT_WAIT)
@@ -97,32 +141,54 @@ void ScriptManager::Input(const VGears::Event& event){
         || event.param1 == OIS::KC_Y || event.param1 == OIS::KC_Z || event.param1 == OIS::KC_X
       )
     ){
-
-        for (unsigned int i = 0; i < script_entity_.size(); ++ i){
-            Ogre::String argument2 = "";
-            if (event.type == VGears::ET_KEY_PRESS) argument2 = "Press";
-            else if (event.type == VGears::ET_KEY_REPEAT_WAIT) argument2 = "Repeat";
-            ScriptRequest(
-              &script_entity_[i], "on_button", 100,
-              KeyToString((OIS::KeyCode) ((int) event.param1)), argument2, false, false
-            );
+        // Only entities with a button handler are notified.
+        if (button_handlers_.empty()) return;
+        const unsigned int argument1
+          = GetNameId(KeyToString((OIS::KeyCode) ((int) event.param1)));
+        unsigned int argument2 = NAME_NONE;
+        if (event.type == VGears::ET_KEY_PRESS) argument2 = GetNameId("Press");
+        else if (event.type == VGears::ET_KEY_REPEAT_WAIT) argument2 = GetNameId("Repeat");
+        for (ScriptEntity* entity : button_handlers_){
+            ScriptRequest(entity, NAME_ON_BUTTON, 100, argument1, argument2, false, false);
         }
     }
 }
 
 void ScriptManager::Update(const ScriptManager::Type type){
-    // Resort all queue. This will give correct info for debug draw.
-    for (unsigned int i = 0; i < script_entity_.size(); ++ i){
-        if (script_entity_[i].type == type){
-            if (script_entity_[i].queue.size() > 0){
-                if (script_entity_[i].resort == true){
-                    std::stable_sort(
-                      script_entity_[i].queue.begin(),
-                      script_entity_[i].queue.end(), priority_queue_compare
-                    );
-                    script_entity_[i].resort = false;
-                }
-            }
+    TypeSchedule& schedule = schedule_[type];
+    schedule.time += Timer::getSingleton().GetGameTimeDelta();
+
+    // Wake up the scripts whose wait is over.
+    while (!schedule.sleeping.empty() && schedule.sleeping.front().wake_time <= schedule.time){
+        std::pop_heap(schedule.sleeping.begin(), schedule.sleeping.end(), SleepingScript::Later);
+        const SleepingScript sleeping(schedule.sleeping.back());
+        schedule.sleeping.pop_back();
+        for (QueueScript& script : sleeping.entity->queue){
+            if (script.function != sleeping.function || script.sleep_id != sleeping.sleep_id)
+                continue;
+            script.seconds_to_wait = 0;
+            script.wait = false;
+            break;
+        }
+        Schedule(*sleeping.entity);
+    }
+
+    // Take the ready entities, the ones deferred by the budget first and then in the order they
+    // were added to the manager, and resort their queues. The rest of the entities are idle and
+    // their queues haven't changed.
+    running_.swap(schedule.ready);
+    schedule.ready.clear();
+    std::sort(
+      running_.begin(), running_.end(), [](const ScriptEntity* a, const ScriptEntity* b){
+          if (a->deferred != b->deferred) return a->deferred;
+          return a->order < b->order;
+      }
+    );
+    for (ScriptEntity* entity : running_){
+        entity->scheduled = false;
+        if (entity->resort == true){
+            std::stable_sort(entity->queue.begin(), entity->queue.end(), priority_queue_compare);
+            entity->resort = false;
         }
     }
 
@@ -143,28 +209,23 @@ void ScriptManager::Update(const ScriptManager::Type type){
                 y += 16;
 
                 for (unsigned int j = 0; j < script_entity_.size(); ++ j){
-                    if (script_entity_[j].type == i){
-                        Ogre::String text = script_entity_[j].name;
-                        unsigned int queue_size = script_entity_[j].queue.size();
+                    if (script_entity_[j]->type == i){
+                        Ogre::String text = script_entity_[j]->name;
+                        unsigned int queue_size = script_entity_[j]->queue.size();
                         if (queue_size > 0){
                             text += ": ";
                             DEBUG_DRAW.SetColour(Ogre::ColourValue(0.8f, 0.8f, 0.0f, 1.0f));
                         }
                         else DEBUG_DRAW.SetColour(Ogre::ColourValue(0.5, 0.5, 0.5, 1));
                         for (unsigned int k = 0; k < queue_size; ++ k){
+                            const QueueScript& script = script_entity_[j]->queue[k];
                             if (k > 0) text += ", ";
-                            text +=
-                              "("
-                              + Ogre::StringConverter::toString(script_entity_[j].queue[k].priority)
-                              + ")" + script_entity_[j].queue[k].function;
-
-                            if (script_entity_[j].queue[k].wait == true){
-                                if (script_entity_[j].queue[k].seconds_to_wait != 0){
-                                    text +=
-                                      ":wait("+ Ogre::StringConverter::toString(
-                                        script_entity_[j].queue[k].seconds_to_wait
-                                      ) + ")";
-                                }
+                            text += "(" + Ogre::StringConverter::toString(script.priority) + ")"
+                              + names_[script.function];
+
+                            if (script.wait == true && script.seconds_to_wait != 0){
+                                text += ":wait("
+                                  + Ogre::StringConverter::toString(script.seconds_to_wait) + ")";
                             }
                         }
                         DEBUG_DRAW.Text(20.0f, static_cast<float>(y), text);
@@ -178,147 +239,146 @@ void ScriptManager::Update(const ScriptManager::Type type){
     // Before updating entities, call on_update on the system timer.
     RunString("Timer.update()");
 
-    for (unsigned int i = 0; i < script_entity_.size(); ++ i){
-        if (script_entity_[i].type == type){
-            if (script_entity_[i].queue.size() > 0){
-                current_script_id_.entity = script_entity_[i].name;
-                current_script_id_.function = script_entity_[i].queue[0].function;
-
-                if (script_entity_[i].queue[0].wait == false){
-                    if (script_entity_[i].queue[0].yield == false){
-                        LOG_TRIVIAL(
-                          "[SCRIPT] Start script \"" + current_script_id_.function
-                          + "\" for entity \"" + current_script_id_.entity + "\"."
-                        );
-
-                        if (script_entity_[i].queue[0].paused_script_start.entity != ""){
-                            ContinueScriptExecution(script_entity_[i].queue[0].paused_script_start);
-                            script_entity_[i].queue[0].paused_script_start.entity = "";
-                        }
-                        luabind::object table = GetTableByEntityName(
-                          type, current_script_id_.entity,
-                          script_entity_[i].queue[0].state
-                        );
-                        if (
-                          table.is_valid()
-                          && luabind::type(table) == LUA_TTABLE
-                          && luabind::type(table[current_script_id_.function]) == LUA_TFUNCTION
-                        ){
-                            int ret = 0;
-                            try{
-                                ret = luabind::resume_function<int>(
-                                  table[current_script_id_.function], table,
-                                  script_entity_[i].queue[0].argument1.c_str(),
-                                  script_entity_[i].queue[0].argument2.c_str()
-                                );
-                            }
-                            catch (luabind::error& e){
-                                std::string msg = "LUA error in entity " + script_entity_[i].name
-                                  + " (" + current_script_id_.entity + ") " + " in function "
-                                  + script_entity_[i].queue[0].function + " ("
-                                  + current_script_id_.function + ")";
-                                if (lua_tostring(script_entity_[i].queue[0].state, -1) != NULL){
-                                    msg = msg + ". Details: " + std::string(
-                                      lua_tostring(script_entity_[i].queue[0].state, -1)
-                                    );
-                                }
-                                msg = msg + ". Exception: " + e.what();
-                                LOG_ERROR(msg);
-                            }
+    // Trace messages are only built if they are going to be logged.
+    const bool trace
+      = Ogre::LogManager::getSingleton().getDefaultLog()->getLogDetail() >= Ogre::LL_BOREME;
 
-                            if (ret == 0){
-                                LOG_TRIVIAL(
-                                  "[SCRIPT] Script \"" + current_script_id_.function
-                                  + "\" for entity \"" + current_script_id_.entity + "\" finished."
-                                );
-                                if (script_entity_[i].queue[0].function != "on_update")
-                                    RemoveEntityTopScript(script_entity_[i]);
-                            }
-                            else if (ret == 1){
-                                LOG_TRIVIAL(
-                                  "[SCRIPT] Script \"" + current_script_id_.function
-                                  + "\" for entity \"" + current_script_id_.entity
-                                  + "\" not paused and will be continued next cycle."
-                                );
-                                script_entity_[i].queue[0].yield = true;
-                            }
-                            else{
-                                LOG_TRIVIAL(
-                                  "[SCRIPT] Script \"" + current_script_id_.function
-                                  + "\" for entity \"" + current_script_id_.entity
-                                  + "\" not finished yet."
-                                );
-                                script_entity_[i].queue[0].yield = true;
-                                script_entity_[i].queue[0].wait = true;
-                            }
-                        }
-                        else{
-                            LOG_WARNING(
-                              "Script \"" + current_script_id_.function + "\" for entity \""
-                              + current_script_id_.entity + "\" doesn't exist."
-                            );
-                            RemoveEntityTopScript(script_entity_[i]);
-                        }
-                    }
-                    else{
-                        LOG_TRIVIAL(
-                          "[SCRIPT] Continue function \"" + current_script_id_.function
-                          + "\" for entity \"" + current_script_id_.entity + "\"."
-                        );
-
-                        int ret = 0;
-                        try{
-                            ret = luabind::resume<int>(script_entity_[i].queue[0].state);
-                        }
-                        catch(luabind::error& e){
-                            luabind::object error_msg(luabind::from_stack(e.state(), -1));
-                            LOG_WARNING(
-                              Ogre::String(luabind::object_cast<std::string >(error_msg))
-                            );
-                        }
+    // The profiler hook is only set while the profiler is enabled.
+    const bool profile = cv_script_profile.GetB();
+    if (profile != profiling_){
+        lua_sethook(
+          lua_state_, profile ? ProfileHook : nullptr, profile ? LUA_MASKCOUNT : 0,
+          PROFILE_HOOK_INSTRUCTIONS
+        );
+        profiling_ = profile;
+    }
+    const double budget = cv_script_budget.GetF() / 1000.0;
+    const int budget_priority = cv_script_budget_priority.GetI();
+    const auto update_start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < running_.size(); ++ i){
+        // Entities removed by a script are cleared from the list.
+        if (running_[i] == nullptr || running_[i]->queue.empty()) continue;
+        ScriptEntity& entity = *running_[i];
+        current_entity_ = &entity;
+        current_function_ = entity.queue[0].function;
+        if (entity.queue[0].wait == true){
+            // Waken up by an event after being taken from the ready list.
+            Schedule(entity);
+            continue;
+        }
+        if (
+          budget > 0 && entity.queue[0].priority >= budget_priority
+          && std::chrono::duration<double>(std::chrono::steady_clock::now() - update_start).count()
+            > budget
+        ){
+            entity.deferred = true;
+            Schedule(entity);
+            continue;
+        }
+        entity.deferred = false;
+
+        // The entity may be removed by its own script, so keep what the profiler needs.
+        const unsigned int profile_entity = profile ? GetNameId(entity.name) : NAME_NONE;
+        const Type profile_type = entity.type;
+        const auto run_start = std::chrono::steady_clock::now();
+        profile_instructions_ = 0;
+
+        int ret = 0;
+        if (entity.queue[0].yield == false){
+            if (trace) LOG_TRIVIAL(
+              "[SCRIPT] Start script \"" + names_[current_function_] + "\" for entity \""
+              + entity.name + "\"."
+            );
 
-                        if (ret == 0){ // Finished.
-                            LOG_TRIVIAL(
-                              "[SCRIPT] Script \"" + current_script_id_.function
-                              + "\" for entity \"" + current_script_id_.entity + "\" finished."
-                            );
+            if (entity.queue[0].paused_script_start.entity != ""){
+                ContinueScriptExecution(entity.queue[0].paused_script_start);
+                entity.queue[0].paused_script_start.entity = "";
+            }
+            lua_State* state = entity.queue[0].state;
+            luabind::object table = GetRegistryObject(state, entity.table_ref);
+            luabind::object function = GetRegistryObject(state, entity.queue[0].function_ref);
+            try{
+                ret = luabind::resume_function<int>(
+                  function, table, names_[entity.queue[0].argument1].c_str(),
+                  names_[entity.queue[0].argument2].c_str()
+                );
+            }
+            catch (luabind::error& e){
+                std::string msg = "LUA error in entity " + entity.name + " in function "
+                  + names_[current_function_];
+                if (lua_tostring(state, -1) != NULL)
+                    msg = msg + ". Details: " + std::string(lua_tostring(state, -1));
+                msg = msg + ". Exception: " + e.what();
+                LOG_ERROR(msg);
+            }
+        }
+        else{
+            if (trace) LOG_TRIVIAL(
+              "[SCRIPT] Continue function \"" + names_[current_function_] + "\" for entity \""
+              + entity.name + "\"."
+            );
 
-                            // Stop yield for on_update.
-                            script_entity_[i].queue[0].yield = false;
+            try{
+                ret = luabind::resume<int>(entity.queue[0].state);
+            }
+            catch(luabind::error& e){
+                luabind::object error_msg(luabind::from_stack(e.state(), -1));
+                LOG_WARNING(Ogre::String(luabind::object_cast<std::string >(error_msg)));
+            }
+        }
+        if (profile){
+            AddProfileRun(
+              profile_entity, profile_type, current_function_,
+              std::chrono::duration<double>(std::chrono::steady_clock::now() - run_start).count()
+            );
+        }
 
-                            if (script_entity_[i].queue[0].function != "on_update")
-                                RemoveEntityTopScript(script_entity_[i]);
-                        }
-                        else if (ret == 1){
-                            LOG_TRIVIAL(
-                              "[SCRIPT] Script \"" + current_script_id_.function
-                              + "\" for entity \"" + current_script_id_.entity
-                              + "\" not paused and will be continued next cycle."
-                            );
-                        }
-                        else{
-                            LOG_TRIVIAL(
-                              "[SCRIPT] Script \"" + current_script_id_.function
-                              + "\" for entity \"" + current_script_id_.entity
-                              + "\" not finished yet."
-                            );
-                            script_entity_[i].queue[0].wait = true;
-                        }
-                    }
-                }
-                else if (script_entity_[i].queue[0].seconds_to_wait > 0){
-                    script_entity_[i].queue[0].seconds_to_wait
-                      -= Timer::getSingleton().GetGameTimeDelta();
-                    script_entity_[i].queue[0].seconds_to_wait
-                      = (script_entity_[i].queue[0].seconds_to_wait < 0)
-                        ? 0 : script_entity_[i].queue[0].seconds_to_wait;
-
-                    if (script_entity_[i].queue[0].seconds_to_wait == 0)
-                        script_entity_[i].queue[0].wait = false;
-                }
+        // The script may have removed its own entity.
+        if (running_[i] == nullptr) continue;
+
+        if (ret == 0){
+            if (trace) LOG_TRIVIAL(
+              "[SCRIPT] Script \"" + names_[current_function_] + "\" for entity \""
+              + entity.name + "\" finished."
+            );
+
+            // Stop yield for on_update.
+            entity.queue[0].yield = false;
+
+            if (entity.queue[0].function != NAME_ON_UPDATE) RemoveEntityTopScript(entity);
+        }
+        else if (ret == 1){
+            if (trace) LOG_TRIVIAL(
+              "[SCRIPT] Script \"" + names_[current_function_] + "\" for entity \""
+              + entity.name + "\" not paused and will be continued next cycle."
+            );
+            entity.queue[0].yield = true;
+        }
+        else{
+            if (trace) LOG_TRIVIAL(
+              "[SCRIPT] Script \"" + names_[current_function_] + "\" for entity \""
+              + entity.name + "\" not finished yet."
+            );
+            entity.queue[0].yield = true;
+            entity.queue[0].wait = true;
+            if (entity.queue[0].seconds_to_wait > 0){
+                entity.queue[0].sleep_id = ++ sleep_id_;
+                schedule.sleeping.push_back(
+                  SleepingScript{
+                    schedule.time + entity.queue[0].seconds_to_wait, &entity,
+                    entity.queue[0].function, entity.queue[0].sleep_id
+                  }
+                );
+                std::push_heap(
+                  schedule.sleeping.begin(), schedule.sleeping.end(), SleepingScript::Later
+                );
             }
         }
+        Schedule(entity);
     }
+    running_.clear();
+    current_entity_ = nullptr;
 }
 
 void ScriptManager::UpdateDebug(){}
@@ -330,9 +390,11 @@ void ScriptManager::ClearField(){}
 void ScriptManager::ClearBattle(){
     // Remove all battle script entities.
     for (unsigned int i = 0; i < script_entity_.size(); ++ i){
-        if (script_entity_[i].type == BATTLE){
-            while(script_entity_[i].queue.size() > 0)
-                ScriptManager::RemoveEntityTopScript(script_entity_[i]);
+        if (script_entity_[i]->type == BATTLE){
+            Detach(*script_entity_[i]);
+            while(script_entity_[i]->queue.size() > 0)
+                ScriptManager::RemoveEntityTopScript(*script_entity_[i]);
+            luaL_unref(lua_state_, LUA_REGISTRYINDEX, script_entity_[i]->table_ref);
             script_entity_.erase(script_entity_.begin() + i);
             i --;
         }
@@ -358,15 +420,60 @@ void ScriptManager::RunString(const Ogre::String& lua){
 }
 
 void ScriptManager::RunFile(const Ogre::String& file){
-    if (luaL_dofile(lua_state_, ("./data/" + file).c_str()) == 1)
+    const Ogre::String path("./data/" + file);
+    if (IsPrecompiled(path)){
+        std::ifstream stream(path + "c", std::ifstream::binary);
+        const std::string chunk(
+          (std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>()
+        );
+        const Ogre::String chunk_name("@" + path);
+        if (
+          !chunk.empty()
+          && luaL_loadbuffer(lua_state_, chunk.data(), chunk.size(), chunk_name.c_str()) == 0
+        ){
+            // Errors while running are the script's, running the source again won't help.
+            if (lua_pcall(lua_state_, 0, LUA_MULTRET, 0) != 0){
+                LOG_ERROR(Ogre::String(lua_tostring(lua_state_, -1)));
+                lua_pop(lua_state_, 1);
+            }
+            return;
+        }
+        // Bytecode built by another LuaJIT version, or corrupted. Try the source.
+        if (!chunk.empty()){
+            LOG_WARNING(Ogre::String(lua_tostring(lua_state_, -1)));
+            lua_pop(lua_state_, 1);
+        }
+    }
+    if (luaL_dofile(lua_state_, path.c_str()) == 1)
         LOG_ERROR(Ogre::String(lua_tostring(lua_state_, -1)));
 }
 
+bool ScriptManager::IsPrecompiled(const Ogre::String& path){
+    // The precompiled file is the source name plus a "c" (script.luac for script.lua).
+    // Timestamps have a coarse resolution, so on a tie the precompiled file may be stale.
+    boost::system::error_code bytecode_error, source_error;
+    const std::time_t bytecode_time
+      = boost::filesystem::last_write_time(path + "c", bytecode_error);
+    const std::time_t source_time = boost::filesystem::last_write_time(path, source_error);
+    return !bytecode_error && (source_error || bytecode_time > source_time);
+}
+
+void ScriptManager::RunChunk(const Ogre::String& file, const Ogre::String& chunk){
+    const Ogre::String chunk_name("@./data/" + file);
+    if (
+      luaL_loadbuffer(lua_state_, chunk.data(), chunk.size(), chunk_name.c_str()) != 0
+      || lua_pcall(lua_state_, 0, LUA_MULTRET, 0) != 0
+    ){
+        LOG_ERROR(Ogre::String(lua_tostring(lua_state_, -1)));
+        lua_pop(lua_state_, 1);
+    }
+}
+
 void ScriptManager::AddEntity(
   const ScriptManager::Type type, const Ogre::String& entity_name, Entity* entity
 ){
     for (unsigned int i = 0; i < script_entity_.size(); ++ i){
-        if (script_entity_[i].type == type && script_entity_[i].name == entity_name){
+        if (script_entity_[i]->type == type && script_entity_[i]->name == entity_name){
             LOG_ERROR(
               "Script \"" + script_entity_type[type] + "\" entity \""
               + entity_name + "\" already exist in script manager."
@@ -381,15 +488,23 @@ void ScriptManager::AddEntity(
         ScriptEntity script_entity;
         script_entity.name = entity_name;
         script_entity.type = type;
+        table.push(lua_state_);
+        script_entity.table_ref = luaL_ref(lua_state_, LUA_REGISTRYINDEX);
 
         // Initialize entity field for model entity.
         if (entity != nullptr) table["entity"] = boost::ref(*entity);
 
-        // Check the "on_start" script
-        if (luabind::type(table["on_start"]) == LUA_TFUNCTION){
+        // Queue the "on_start" and "on_update" scripts, if they exist.
+        const unsigned int functions[] = {NAME_ON_START, NAME_ON_UPDATE};
+        const int priorities[] = {1, 999};
+        for (int f = 0; f < 2; ++ f){
+            luabind::object function = table[names_[functions[f]]];
+            if (luabind::type(function) != LUA_TFUNCTION) continue;
             QueueScript script;
-            script.function = "on_start";
-            script.priority = 1;
+            script.function = functions[f];
+            function.push(lua_state_);
+            script.function_ref = luaL_ref(lua_state_, LUA_REGISTRYINDEX);
+            script.priority = priorities[f];
             script.state = lua_newthread(lua_state_);
             // The thread must not be garbage collected,
             // so it need to be stored.
@@ -400,30 +515,21 @@ void ScriptManager::AddEntity(
             script_entity.queue.push_back(script);
         }
 
-        // Check the "on_update" script.
-        if (luabind::type(table["on_update"]) == LUA_TFUNCTION){
-            QueueScript script;
-            script.function = "on_update";
-            script.priority = 999;
-            script.state = lua_newthread(lua_state_);
-            // The thread must not be garbage collected,
-            // so it need to be stored.
-            script.state_id = luaL_ref(lua_state_, LUA_REGISTRYINDEX);
-            script.seconds_to_wait = 0;
-            script.wait = false;
-            script.yield = false;
-            script_entity.queue.push_back(script);
-        }
-
-        script_entity_.push_back(script_entity);
+        script_entity.order = entity_order_ ++;
+        script_entity_.emplace_back(new ScriptEntity(script_entity));
+        Schedule(*script_entity_.back());
+        if (luabind::type(table[names_[NAME_ON_BUTTON]]) == LUA_TFUNCTION)
+            button_handlers_.push_back(script_entity_.back().get());
     }
 }
 
 void ScriptManager::RemoveEntity(const ScriptManager::Type type, const Ogre::String& entity_name){
     for (unsigned int i = 0; i < script_entity_.size(); ++ i){
-        if (script_entity_[i].type == type && script_entity_[i].name == entity_name){
-            while(script_entity_[i].queue.size() > 0)
-                ScriptManager::RemoveEntityTopScript(script_entity_[i]);
+        if (script_entity_[i]->type == type && script_entity_[i]->name == entity_name){
+            Detach(*script_entity_[i]);
+            while(script_entity_[i]->queue.size() > 0)
+                ScriptManager::RemoveEntityTopScript(*script_entity_[i]);
+            luaL_unref(lua_state_, LUA_REGISTRYINDEX, script_entity_[i]->table_ref);
             script_entity_.erase(script_entity_.begin() + i);
             return;
         }
@@ -432,8 +538,9 @@ void ScriptManager::RemoveEntity(const ScriptManager::Type type, const Ogre::Str
 
 void ScriptManager::RemoveEntityTopScript(ScriptEntity& entity){
     if (entity.queue.size() > 0){
-        // Delete the thread.
+        // Delete the thread and release the function.
         luaL_unref(lua_state_, LUA_REGISTRYINDEX, entity.queue[0].state_id);
+        luaL_unref(lua_state_, LUA_REGISTRYINDEX, entity.queue[0].function_ref);
 
         if (entity.queue[0].paused_script_end.entity != ""){
             ContinueScriptExecution(entity.queue[0].paused_script_end);
@@ -467,11 +574,13 @@ luabind::object ScriptManager::GetTableByEntityName(
 }
 
 QueueScript* ScriptManager::GetScriptByScriptId(const ScriptId& script) const{
+    auto function = name_ids_.find(script.function);
+    if (function == name_ids_.end()) return nullptr;
     for (unsigned int i = 0; i < script_entity_.size(); ++ i){
-        if (script.entity == script_entity_[i].name){
-            for (unsigned int j = 0; j < script_entity_[i].queue.size(); ++ j){
-                if (script.function == script_entity_[i].queue[j].function)
-                    return (QueueScript*) &(script_entity_[i].queue[j]);
+        if (script.entity == script_entity_[i]->name){
+            for (unsigned int j = 0; j < script_entity_[i]->queue.size(); ++ j){
+                if (function->second == script_entity_[i]->queue[j].function)
+                    return &(script_entity_[i]->queue[j]);
             }
             return nullptr;
         }
@@ -483,13 +592,19 @@ ScriptEntity* ScriptManager::GetScriptEntityByName(
   const Type type, const Ogre::String& entity_name
 ) const{
     for (unsigned int i = 0; i < script_entity_.size(); ++ i){
-        if (script_entity_[i].type == type && script_entity_[i].name == entity_name)
-            return (ScriptEntity*) &(script_entity_[i]);
+        if (script_entity_[i]->type == type && script_entity_[i]->name == entity_name)
+            return script_entity_[i].get();
     }
     return nullptr;
 }
 
-const ScriptId ScriptManager::GetCurrentScriptId() const{return current_script_id_;}
+const ScriptId ScriptManager::GetCurrentScriptId() const{
+    ScriptId script;
+    if (current_entity_ == nullptr) return script;
+    script.entity = current_entity_->name;
+    script.function = names_[current_function_];
+    return script;
+}
 
 void ScriptManager::ContinueScriptExecution(const ScriptId& script){
     QueueScript* script_pointer = GetScriptByScriptId(script);
@@ -501,6 +616,12 @@ void ScriptManager::ContinueScriptExecution(const ScriptId& script){
         return;
     }
     script_pointer->wait = false;
+    for (auto& entity : script_entity_){
+        if (entity->name == script.entity){
+            Schedule(*entity);
+            return;
+        }
+    }
 }
 
 int ScriptManager::ScriptWait(const float seconds){
@@ -508,7 +629,7 @@ int ScriptManager::ScriptWait(const float seconds){
       "script:wait: We set script wait for "
       + Ogre::StringConverter::toString(seconds) + " seconds."
     );
-    QueueScript* script = GetScriptByScriptId(current_script_id_);
+    QueueScript* script = GetCurrentScript();
     if (script == nullptr){
         LOG_ERROR("script:wait: Currently no any script running.");
         return 1;
@@ -610,48 +731,146 @@ bool ScriptManager::ScriptRequest(
   ScriptEntity* script_entity, const Ogre::String& function, const int priority,
   const Ogre::String& argument1, const Ogre::String& argument2, bool start_sync, bool end_sync
 ){
-    luabind::object table
-      = GetTableByEntityName(script_entity->type, script_entity->name, lua_state_);
-    if (
-      table.is_valid() && luabind::type(table) == LUA_TTABLE
-      && luabind::type(table[function]) == LUA_TFUNCTION
-    ){
-        QueueScript script;
-        script.function = function;
-        script.argument1 = argument1;
-        script.argument2 = argument2;
-        script.priority = priority;
-        script.state = lua_newthread(lua_state_);
-        // The thread must not be garbage collected,
-        // so it need to be stored.
-        script.state_id = luaL_ref(lua_state_, LUA_REGISTRYINDEX);
-        script.seconds_to_wait = 0;
-        script.wait = false;
-        script.yield = false;
-        if (start_sync == true)
-            script.paused_script_start = GetCurrentScriptId();
-        if (end_sync == true) script.paused_script_end = GetCurrentScriptId();
-
-        // If the script is already running, don't queue it.
-        for (int i = 0; i < script_entity->queue.size(); i ++){
-             if (script_entity->queue[i].function == function){
-                 script_entity->resort = true;
-                 return true;
-            }
+    return ScriptRequest(
+      script_entity, GetNameId(function), priority, GetNameId(argument1), GetNameId(argument2),
+      start_sync, end_sync
+    );
+}
+
+bool ScriptManager::ScriptRequest(
+  ScriptEntity* script_entity, const unsigned int function, const int priority,
+  const unsigned int argument1, const unsigned int argument2, bool start_sync, bool end_sync
+){
+    if (script_entity == nullptr) return false;
+    // If the script is already queued, don't queue it again.
+    for (const QueueScript& queued : script_entity->queue){
+        if (queued.function == function){
+            script_entity->resort = true;
+            return true;
         }
+    }
 
-        script_entity->queue.push_back(script);
-        script_entity->resort = true;
-        return true;
+    lua_rawgeti(lua_state_, LUA_REGISTRYINDEX, script_entity->table_ref);
+    lua_getfield(lua_state_, -1, names_[function].c_str());
+    if (lua_type(lua_state_, -1) != LUA_TFUNCTION){
+        lua_pop(lua_state_, 2);
+        return false;
     }
-    return false;
+    QueueScript script;
+    script.function = function;
+    script.function_ref = luaL_ref(lua_state_, LUA_REGISTRYINDEX);
+    lua_pop(lua_state_, 1);
+    script.argument1 = argument1;
+    script.argument2 = argument2;
+    script.priority = priority;
+    script.state = lua_newthread(lua_state_);
+    // The thread must not be garbage collected,
+    // so it need to be stored.
+    script.state_id = luaL_ref(lua_state_, LUA_REGISTRYINDEX);
+    script.seconds_to_wait = 0;
+    script.wait = false;
+    script.yield = false;
+    if (start_sync == true) script.paused_script_start = GetCurrentScriptId();
+    if (end_sync == true) script.paused_script_end = GetCurrentScriptId();
+    script_entity->queue.push_back(script);
+    script_entity->resort = true;
+    Schedule(*script_entity);
+    return true;
 }
 
 void ScriptManager::AddValueToStack(const float value){
-    QueueScript* script = GetScriptByScriptId(current_script_id_);
+    QueueScript* script = GetCurrentScript();
     if (script != nullptr) lua_pushnumber(script->state, value);
 }
 
+unsigned int ScriptManager::GetNameId(const Ogre::String& name){
+    auto id = name_ids_.find(name);
+    if (id != name_ids_.end()) return id->second;
+    names_.push_back(name);
+    name_ids_.emplace(name, names_.size() - 1);
+    return names_.size() - 1;
+}
+
+const Ogre::String& ScriptManager::GetName(const unsigned int id) const{return names_[id];}
+
+QueueScript* ScriptManager::GetCurrentScript(){
+    if (current_entity_ == nullptr) return nullptr;
+    for (QueueScript& script : current_entity_->queue)
+        if (script.function == current_function_) return &script;
+    return nullptr;
+}
+
+void ScriptManager::Schedule(ScriptEntity& entity){
+    if (entity.scheduled == true || entity.queue.empty()) return;
+    // If the queue must be resorted, the top script may change.
+    if (entity.resort == true || entity.queue[0].wait == false){
+        entity.scheduled = true;
+        schedule_[entity.type].ready.push_back(&entity);
+    }
+}
+
+void ScriptManager::Detach(ScriptEntity& entity){
+    TypeSchedule& schedule = schedule_[entity.type];
+    schedule.ready.erase(
+      std::remove(schedule.ready.begin(), schedule.ready.end(), &entity), schedule.ready.end()
+    );
+    schedule.sleeping.erase(
+      std::remove_if(
+        schedule.sleeping.begin(), schedule.sleeping.end(),
+        [&entity](const SleepingScript& sleeping){return sleeping.entity == &entity;}
+      ),
+      schedule.sleeping.end()
+    );
+    std::make_heap(schedule.sleeping.begin(), schedule.sleeping.end(), SleepingScript::Later);
+    std::replace(running_.begin(), running_.end(), &entity, static_cast<ScriptEntity*>(nullptr));
+    button_handlers_.erase(
+      std::remove(button_handlers_.begin(), button_handlers_.end(), &entity),
+      button_handlers_.end()
+    );
+    if (current_entity_ == &entity) current_entity_ = nullptr;
+}
+
+luabind::object ScriptManager::GetRegistryObject(lua_State* state, const int ref){
+    lua_rawgeti(state, LUA_REGISTRYINDEX, ref);
+    luabind::object object(luabind::from_stack(state, -1));
+    lua_pop(state, 1);
+    return object;
+}
+
+std::vector<ScriptManager::ScriptProfile> ScriptManager::GetProfile() const{
+    std::vector<ScriptProfile> profile;
+    profile.reserve(profile_.size());
+    for (const auto& function : profile_) profile.push_back(function.second);
+    std::sort(
+      profile.begin(), profile.end(), [](const ScriptProfile& a, const ScriptProfile& b){
+          return a.time > b.time;
+      }
+    );
+    return profile;
+}
+
+void ScriptManager::ResetProfile(){profile_.clear();}
+
+void ScriptManager::ProfileHook(lua_State* state, lua_Debug* debug){
+    ScriptManager::getSingleton().profile_instructions_ += PROFILE_HOOK_INSTRUCTIONS;
+}
+
+void ScriptManager::AddProfileRun(
+  const unsigned int entity, const Type type, const unsigned int function, const double time
+){
+    const unsigned long long key
+      = (static_cast<unsigned long long>(entity) << 34)
+      | (static_cast<unsigned long long>(type) << 32) | function;
+    ScriptProfile& profile = profile_[key];
+    profile.entity = entity;
+    profile.type = type;
+    profile.function = function;
+    ++ profile.runs;
+    profile.instructions += profile_instructions_;
+    profile.time += time;
+    profile.max_time = std::max(profile.max_time, time);
+}
+
 void ScriptManager::UpdateField(){}
 
 void ScriptManager::UpdateBattle(){}
@@ -15,6 +15,9 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include <OgreSingleton.h>
 #include <OgreString.h>
 #include "Event.h"
@@ -51,6 +54,10 @@ struct ScriptEntity;
 
 /**
  * A script queue.
+ *
+ * Function names and arguments are stored as identifiers interned by the
+ * {@see ScriptManager}, and the function itself as a reference in the Lua registry, so running a
+ * script step doesn't need any string lookup.
  */
 struct QueueScript{
 
@@ -58,30 +65,38 @@ struct QueueScript{
      * Constructor.
      */
     QueueScript():
-      function(""),
-      argument1(""),
-      argument2(""),
+      function(0),
+      function_ref(LUA_NOREF),
+      argument1(0),
+      argument2(0),
       priority(0),
       state(NULL),
+      state_id(LUA_NOREF),
       seconds_to_wait(0),
+      sleep_id(0),
       wait(false),
       yield(false)
     {}
 
     /**
-     * Function name.
+     * Function name identifier.
      */
-    Ogre::String function;
+    unsigned int function;
 
     /**
-     * First function argument.
+     * Reference to the function in the Lua registry.
      */
-    Ogre::String argument1;
+    int function_ref;
 
     /**
-     * Second function argument.
+     * First function argument identifier.
      */
-    Ogre::String argument2;
+    unsigned int argument1;
+
+    /**
+     * Second function argument identifier.
+     */
+    unsigned int argument2;
 
     /**
      * Function priority.
@@ -105,6 +120,13 @@ struct QueueScript{
      */
     float seconds_to_wait;
 
+    /**
+     * Identifies the last wait of the script with {@see seconds_to_wait}.
+     *
+     * Used to discard stale entries in the scheduler.
+     */
+    unsigned int sleep_id;
+
     /**
      * Indicates if the script completion should be waited for,
      */
@@ -166,6 +188,58 @@ class ScriptManager : public Manager, public Ogre::Singleton<ScriptManager>{
             BATTLE
         };
 
+        /**
+         * Execution cost of a function of an entity, as measured by the profiler.
+         */
+        struct ScriptProfile{
+
+            /**
+             * Constructor.
+             */
+            ScriptProfile():
+              entity(0), type(SYSTEM), function(0), runs(0), instructions(0), time(0),
+              max_time(0)
+            {}
+
+            /**
+             * Identifier of the entity name.
+             */
+            unsigned int entity;
+
+            /**
+             * Entity type.
+             */
+            Type type;
+
+            /**
+             * Identifier of the function name.
+             */
+            unsigned int function;
+
+            /**
+             * Number of times the function has been resumed.
+             */
+            unsigned int runs;
+
+            /**
+             * Approximate number of Lua instructions executed.
+             *
+             * Instructions are counted in blocks of {@see PROFILE_HOOK_INSTRUCTIONS}, and only
+             * while interpreted: LuaJIT doesn't run hooks in compiled code.
+             */
+            unsigned long long instructions;
+
+            /**
+             * Total execution time, in seconds.
+             */
+            double time;
+
+            /**
+             * Longest single run, in seconds.
+             */
+            double max_time;
+        };
+
         /**
          * Constructor.
          */
@@ -227,12 +301,35 @@ class ScriptManager : public Manager, public Ogre::Singleton<ScriptManager>{
         /**
          * Runs a lua file.
          *
+         * If there is a precompiled version of the file, with the same name plus a "c" (such as
+         * "script.luac" for "script.lua"), and it's newer than the source, it's run instead. If
+         * the precompiled file can't be loaded, the source is run.
+         *
          * No errors are handled, and nothing is returned
          *
          * @param[in] file Path to the lua file to run (relative to the data directory).
          */
         void RunFile(const Ogre::String& file);
 
+        /**
+         * Runs a lua chunk already in memory.
+         *
+         * Errors are logged.
+         *
+         * @param[in] file Path to the lua file the chunk was read from (relative to the data
+         * directory). Only used to name the chunk.
+         * @param[in] chunk Lua source or precompiled bytecode.
+         */
+        void RunChunk(const Ogre::String& file, const Ogre::String& chunk);
+
+        /**
+         * Checks if a lua file has a precompiled version that {@see RunFile} would run.
+         *
+         * @param[in] path Path to the lua file.
+         * @return True if the precompiled file exists and is newer than the source.
+         */
+        static bool IsPrecompiled(const Ogre::String& path);
+
         /**
          * Initializes Lua binds.
          *
@@ -240,6 +337,14 @@ class ScriptManager : public Manager, public Ogre::Singleton<ScriptManager>{
          */
         void InitBinds();
 
+        /**
+         * Initializes the LuaJIT FFI binds of the most frequently used commands.
+         *
+         * Also enables the JIT compiler. The binds are available to scripts in the "fast_binds"
+         * table, see ScriptManagerFfiBinds.h.
+         */
+        void InitFfiBinds();
+
         /**
          * Initializes command bindings
          */
@@ -408,6 +513,45 @@ class ScriptManager : public Manager, public Ogre::Singleton<ScriptManager>{
           const Ogre::String& argument2, bool start_sync, bool end_sync
         );
 
+        /**
+         * Request a script execution.
+         *
+         * Same as the version taking strings, with the function name and the arguments already
+         * interned.
+         *
+         * @param[in] script_entity Entity the scripts belong to.
+         * @param[in] function Identifier of the name of the function to execute.
+         * @param[in] priority Execution priority.
+         * @param[in] argument1 Identifier of the first argument for the script.
+         * @param[in] argument2 Identifier of the second argument for the script.
+         * @param[in] start_sync If true, the script will be started synchronously.
+         * @param[in] end_sync @todo Understand and document.
+         * @return True on success, false on error (i.e. if the entity or the script don't exist)
+         */
+        bool ScriptRequest(
+          ScriptEntity* script_entity, const unsigned int function, const int priority,
+          const unsigned int argument1, const unsigned int argument2, bool start_sync,
+          bool end_sync
+        );
+
+        /**
+         * Retrieves the identifier of a string.
+         *
+         * Identifiers are assigned the first time a string is seen, and never change.
+         *
+         * @param[in] name The string.
+         * @return The string identifier.
+         */
+        unsigned int GetNameId(const Ogre::String& name);
+
+        /**
+         * Retrieves an interned string.
+         *
+         * @param[in] id The string identifier, as returned by {@see GetNameId}.
+         * @return The string.
+         */
+        const Ogre::String& GetName(const unsigned int id) const;
+
         /**
          * Adds a script to the stack.
          *
@@ -416,8 +560,168 @@ class ScriptManager : public Manager, public Ogre::Singleton<ScriptManager>{
          */
         void AddValueToStack(const float value);
 
+        /**
+         * Retrieves the profiler measurements.
+         *
+         * Scripts are only measured while the "script_profile" variable is enabled.
+         *
+         * @return The measurements of every function run, costliest (by total time) first.
+         */
+        std::vector<ScriptProfile> GetProfile() const;
+
+        /**
+         * Discards the profiler measurements.
+         */
+        void ResetProfile();
+
     private:
 
+        /**
+         * Number of Lua instructions between calls to the profiler hook.
+         */
+        static const int PROFILE_HOOK_INSTRUCTIONS;
+
+        /**
+         * Identifier of the empty string.
+         */
+        static const unsigned int NAME_NONE;
+
+        /**
+         * Identifier of "on_start".
+         */
+        static const unsigned int NAME_ON_START;
+
+        /**
+         * Identifier of "on_update".
+         */
+        static const unsigned int NAME_ON_UPDATE;
+
+        /**
+         * Identifier of "on_button".
+         */
+        static const unsigned int NAME_ON_BUTTON;
+
+        /**
+         * A script waiting for some time.
+         */
+        struct SleepingScript{
+
+            /**
+             * Time at which the wait is over, in the clock of the script type.
+             */
+            double wake_time;
+
+            /**
+             * Entity the script belongs to.
+             */
+            ScriptEntity* entity;
+
+            /**
+             * Identifier of the name of the function.
+             */
+            unsigned int function;
+
+            /**
+             * Identifies the wait, see {@see QueueScript::sleep_id}.
+             */
+            unsigned int sleep_id;
+
+            /**
+             * Orders sleeping scripts for a min-heap.
+             *
+             * @param[in] a The first script to compare.
+             * @param[in] b The second script to compare.
+             * @return True if a wakes up later than b.
+             */
+            static bool Later(const SleepingScript& a, const SleepingScript& b){
+                return a.wake_time > b.wake_time;
+            }
+        };
+
+        /**
+         * Scheduling state of the scripts of a type.
+         */
+        struct TypeSchedule{
+
+            /**
+             * Constructor.
+             */
+            TypeSchedule(): time(0){}
+
+            /**
+             * Game time accumulated by the updates of this type, in seconds.
+             *
+             * A double, so frame deltas are still added exactly after a long session.
+             */
+            double time;
+
+            /**
+             * Entities whose top script must run in the next update.
+             */
+            std::vector<ScriptEntity*> ready;
+
+            /**
+             * Scripts waiting for some time, as a min-heap on the wake up time.
+             */
+            std::vector<SleepingScript> sleeping;
+        };
+
+        /**
+         * Adds an entity to the ready list of its type, if its top script can run.
+         *
+         * Entities whose top script waits for some time are woken up by the heap, and the ones
+         * whose top script waits for an event by {@see ContinueScriptExecution}, so idle entities
+         * are not visited at all.
+         *
+         * @param[in] entity The entity to schedule.
+         */
+        void Schedule(ScriptEntity& entity);
+
+        /**
+         * Removes every reference to an entity from the scheduler and the input handlers.
+         *
+         * @param[in] entity The entity being removed.
+         */
+        void Detach(ScriptEntity& entity);
+
+        /**
+         * Retrieves the script being executed.
+         *
+         * @return The script being executed, or nullptr if there is none.
+         */
+        QueueScript* GetCurrentScript();
+
+        /**
+         * Pushes an object stored in the Lua registry and wraps it.
+         *
+         * @param[in] state State to push the object to.
+         * @param[in] ref Reference to the object in the registry.
+         * @return The object.
+         */
+        static luabind::object GetRegistryObject(lua_State* state, const int ref);
+
+        /**
+         * Lua count hook for the profiler.
+         *
+         * Hooks are global to all the coroutines in LuaJIT, so it's only set in the main state.
+         *
+         * @param[in] state The running state.
+         * @param[in] debug Hook information.
+         */
+        static void ProfileHook(lua_State* state, lua_Debug* debug);
+
+        /**
+         * Adds a run of a function to the profiler measurements.
+         *
+         * @param[in] entity Identifier of the entity name.
+         * @param[in] type Entity type.
+         * @param[in] function Identifier of the function name.
+         * @param[in] time Time the run took, in seconds.
+         */
+        void AddProfileRun(
+          const unsigned int entity, const Type type, const unsigned int function, const double time
+        );
+
         /**
          * Updates the script while in a field.
          */
@@ -460,13 +764,77 @@ class ScriptManager : public Manager, public Ogre::Singleton<ScriptManager>{
 
         /**
          * The list of map entity scripts.
+         *
+         * They are allocated separately so the scheduler can point to them.
+         */
+        std::vector<std::unique_ptr<ScriptEntity>> script_entity_;
+
+        /**
+         * Scheduling state for each script type.
+         */
+        TypeSchedule schedule_[BATTLE + 1];
+
+        /**
+         * Entities being updated.
+         *
+         * Entities removed during the update are set to nullptr.
          */
-        std::vector<ScriptEntity> script_entity_;
+        std::vector<ScriptEntity*> running_;
 
         /**
-         * The current script ID.
+         * Entities whose table defines "on_button", in the order they were added.
+         *
+         * Input events are only delivered to them. The handler must be defined before the entity
+         * is added to the manager.
          */
-        ScriptId current_script_id_;
+        std::vector<ScriptEntity*> button_handlers_;
+
+        /**
+         * Last identifier assigned to a script wait.
+         */
+        unsigned int sleep_id_;
+
+        /**
+         * Order to assign to the next entity added.
+         */
+        unsigned int entity_order_;
+
+        /**
+         * Interned strings, indexed by identifier.
+         */
+        std::vector<Ogre::String> names_;
+
+        /**
+         * Identifiers of the interned strings.
+         */
+        std::unordered_map<Ogre::String, unsigned int> name_ids_;
+
+        /**
+         * The entity whose script is being executed.
+         *
+         * nullptr if no script is being executed.
+         */
+        ScriptEntity* current_entity_;
+
+        /**
+         * Identifier of the name of the function being executed.
+         */
+        unsigned int current_function_;
+
+        /**
+         * Profiler measurements, by entity, type and function.
+         */
+        std::unordered_map<unsigned long long, ScriptProfile> profile_;
+
+        /**
+         * Indicates if the profiler hook is set.
+         */
+        bool profiling_;
+
+        /**
+         * Instructions counted by the profiler hook during the current run.
+         */
+        unsigned long long profile_instructions_;
 };
 
 struct ScriptEntity{
@@ -476,13 +844,26 @@ struct ScriptEntity{
      *
      *By default, the type is {@see ScriptManager::SYSTEM}.
      */
-    ScriptEntity(): name(""), type(ScriptManager::SYSTEM), resort(false){}
+    ScriptEntity():
+      name(""), table_ref(LUA_NOREF), order(0), type(ScriptManager::SYSTEM), resort(false),
+      scheduled(false), deferred(false)
+    {}
 
     /**
      * The script name.
      */
     Ogre::String name;
 
+    /**
+     * Reference to the entity script table in the Lua registry.
+     */
+    int table_ref;
+
+    /**
+     * Order in which the entity was added. Entities are updated in this order.
+     */
+    unsigned int order;
+
     /**
      * The script type.
      */
@@ -494,8 +875,20 @@ struct ScriptEntity{
     std::vector<QueueScript> queue;
 
     /**
-     * @todo Understand and document.
+     * Indicates if the queue must be sorted by priority before the next update.
      */
     bool resort;
+
+    /**
+     * Indicates if the entity is in the ready list of the scheduler.
+     */
+    bool scheduled;
+
+    /**
+     * Indicates if the last run was deferred because the frame budget was exhausted.
+     *
+     * Deferred entities run first in the next update, so they are not starved.
+     */
+    bool deferred;
 };
 
@@ -22,6 +22,8 @@
 #include "Enemy.h"
 #include "Entity.h"
 #include "EntityManager.h"
+#include "FieldIndex.h"
+#include "FieldPreloader.h"
 #include "BattleManager.h"
 #include "AudioManager.h"
 #include "SavemapHandler.h"
@@ -29,7 +31,6 @@
 #include "UiManager.h"
 #include "UiWidget.h"
 #include "XmlMapFile.h"
-#include "XmlMapsFile.h"
 #include "DialogsManager.h"
 #include "TextHandler.h"
 #include <luabind/detail/class_registry.hpp>
@@ -66,16 +67,20 @@ void ScriptPrint(const char* text){
  */
 void ScriptMap(const char* text){
     EntityManager::getSingleton().Clear();
-    XmlMapsFile xml("./data/fields/_fields.xml");
-    Ogre::String file_name = xml.GetMapFileNameByName(text);
-    XmlMapFile xml_map("./data/fields/" + file_name);
-    xml_map.LoadMap();
+    // Gateway destinations are usually preloaded when the previous field was loaded.
+    std::shared_ptr<const VGears::FieldBundle> preloaded
+      = FieldPreloader::getSingleton().Get(text);
+    if (preloaded != nullptr){
+        XmlMapFile::Load(*preloaded);
+        return;
+    }
+    const Ogre::String& file_name = FieldIndex::getSingleton().GetFileName(text);
+    XmlMapFile::LoadMap(FieldIndex::FIELDS_DIR, file_name);
 }
 
 void ScriptWorldMap(const int map, const unsigned int x, const unsigned int y){
     EntityManager::getSingleton().Clear();
-    XmlMapFile xml_map("./data/fields/wm" + std::to_string(map) + ".xml");
-    xml_map.LoadMap();
+    XmlMapFile::LoadMap("./data/fields/", "wm" + std::to_string(map) + ".xml");
 }
 
 /**
@@ -13,9 +13,16 @@
  * GNU General Public License for more details.
  */
 
+#include <iomanip>
+#include <sstream>
 #include "ConfigCmdHandler.h"
 #include "Console.h"
 
+/**
+ * Names of the script types, defined in ScriptManager.cpp.
+ */
+extern Ogre::String script_entity_type[];
+
 /**
  * Runs a script string.
  *
@@ -52,6 +59,44 @@ void CmdScriptRunFile(const Ogre::StringVector& params){
     ScriptManager::getSingleton().RunFile(params[1]);
 }
 
+/**
+ * Prints the costliest script functions measured by the profiler.
+ *
+ * @param[in] params Command parameters. The first one is the command name. The second one, if
+ * passed, is the number of functions to print (10 by default), or "reset" to discard the
+ * measurements. If more than two parameters are passed, a usage string will be printed instead.
+ */
+void CmdScriptProfile(const Ogre::StringVector& params){
+    if (params.size() > 2){
+        Console::getSingleton().AddTextToOutput("Usage: /script_profile_list [count|reset]");
+        return;
+    }
+    ScriptManager& manager = ScriptManager::getSingleton();
+    if (params.size() > 1 && params[1] == "reset"){
+        manager.ResetProfile();
+        return;
+    }
+    const std::vector<ScriptManager::ScriptProfile> profile = manager.GetProfile();
+    if (profile.empty()){
+        Console::getSingleton().AddTextToOutput(
+          "No scripts measured. Enable the profiler with /set script_profile true"
+        );
+        return;
+    }
+    const unsigned int count = params.size() > 1
+      ? Ogre::StringConverter::parseUnsignedInt(params[1], 10) : 10;
+    Console::getSingleton().AddTextToOutput("total ms    max ms      runs  kinstr  function");
+    for (unsigned int i = 0; i < count && i < profile.size(); ++ i){
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(3) << std::setw(8) << profile[i].time * 1000
+          << std::setw(10) << profile[i].max_time * 1000 << std::setw(10) << profile[i].runs
+          << std::setw(8) << profile[i].instructions / 1000 << "  "
+          << script_entity_type[profile[i].type] << " " << manager.GetName(profile[i].entity)
+          << "." << manager.GetName(profile[i].function);
+        Console::getSingleton().AddTextToOutput(line.str());
+    }
+}
+
 void ScriptManager::InitCmd(){
     ConfigCmdHandler::getSingleton().AddCommand(
       "script_run_string", "Run script string", "", CmdScriptRunString, NULL
@@ -59,4 +104,8 @@ void ScriptManager::InitCmd(){
     ConfigCmdHandler::getSingleton().AddCommand(
       "script_run_file", "Run script file", "", CmdScriptRunFile, NULL
     );
+    ConfigCmdHandler::getSingleton().AddCommand(
+      "script_profile_list", "List the costliest script functions", "[count|reset]",
+      CmdScriptProfile, NULL
+    );
 }
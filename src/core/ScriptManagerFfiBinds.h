@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+/**
+ * Bindings for the most frequently called script commands, through the LuaJIT FFI.
+ *
+ * The functions here only take and return plain C types, and are handed to Lua as a table of
+ * function pointers. Calls to them skip luabind's overload resolution and argument conversion,
+ * and can be compiled by the JIT as part of the script loops that use them. They are exposed to
+ * scripts in the global "fast_binds" table:
+ *
+ * - entity_get_position(name): Returns x, y and z, or nil if there is no such entity.
+ * - entity_set_position(name, x, y, z)
+ * - entity_get_rotation(name): Returns the rotation in degrees, 0 if there is no such entity.
+ * - entity_set_rotation(name, degrees)
+ * - entity_get_state(name): Returns the Entity::State, -1 if there is no such entity.
+ * - entity_get_animation_state(name): Returns the Entity::AnimationState, -1 if there is no such
+ *   entity.
+ * - entity_is_moving(name): Returns true if the entity is in a linear movement or a jump.
+ * - entity_get_move_triangle_id(name): Returns the walkmesh triangle the entity is moving to.
+ * - entity_get_move_auto_speed(name): Returns the speed of the automatic movement.
+ * - timer_get_game_time_total(), timer_get_game_time_delta(), timer_get_timer()
+ * - savemap_get_data(bank, address), savemap_set_data(bank, address, value)
+ *
+ * Everything else is still bound through luabind, in ScriptManagerBinds.h.
+ *
+ * The functions are only reached through the function pointers in {@see FFI_BINDS}, so they don't
+ * need C linkage.
+ */
+
+#pragma once
+
+#include <cstring>
+#include "EntityManager.h"
+#include "Logger.h"
+#include "SavemapHandler.h"
+#include "Timer.h"
+#include "LuaIncludes.h"
+
+/**
+ * Retrieves an entity position.
+ *
+ * @param[in] name Entity name.
+ * @param[out] position X, Y and Z coordinates.
+ * @return 1 if the entity exists, 0 otherwise.
+ */
+static int FfiEntityGetPosition(const char* name, float* position){
+    const Entity* entity = EntityManager::getSingleton().ScriptGetEntity(name);
+    if (entity == nullptr) return 0;
+    const Ogre::Vector3 entity_position = entity->GetPosition();
+    position[0] = entity_position.x;
+    position[1] = entity_position.y;
+    position[2] = entity_position.z;
+    return 1;
+}
+
+/**
+ * Sets an entity position.
+ *
+ * Same as the "set_position" entity command.
+ *
+ * @param[in] name Entity name.
+ * @param[in] x X coordinate.
+ * @param[in] y Y coordinate.
+ * @param[in] z Z coordinate.
+ */
+static void FfiEntitySetPosition(const char* name, float x, float y, float z){
+    Entity* entity = EntityManager::getSingleton().ScriptGetEntity(name);
+    if (entity != nullptr) entity->ScriptSetPosition(x, y, z);
+}
+
+/**
+ * Retrieves an entity rotation.
+ *
+ * @param[in] name Entity name.
+ * @return The rotation, in degrees. 0 if the entity doesn't exist.
+ */
+static float FfiEntityGetRotation(const char* name){
+    const Entity* entity = EntityManager::getSingleton().ScriptGetEntity(name);
+    return entity == nullptr ? 0 : entity->ScriptGetRotation();
+}
+
+/**
+ * Sets an entity rotation.
+ *
+ * @param[in] name Entity name.
+ * @param[in] rotation The rotation, in degrees.
+ */
+static void FfiEntitySetRotation(const char* name, float rotation){
+    Entity* entity = EntityManager::getSingleton().ScriptGetEntity(name);
+    if (entity != nullptr) entity->ScriptSetRotation(rotation);
+}
+
+/**
+ * Retrieves an entity state.
+ *
+ * @param[in] name Entity name.
+ * @return The {@see Entity::State}, or -1 if the entity doesn't exist.
+ */
+static int FfiEntityGetState(const char* name){
+    const Entity* entity = EntityManager::getSingleton().ScriptGetEntity(name);
+    return entity == nullptr ? -1 : entity->GetState();
+}
+
+/**
+ * Retrieves an entity animation state.
+ *
+ * @param[in] name Entity name.
+ * @return The {@see Entity::AnimationState}, or -1 if the entity doesn't exist.
+ */
+static int FfiEntityGetAnimationState(const char* name){
+    const Entity* entity = EntityManager::getSingleton().ScriptGetEntity(name);
+    return entity == nullptr ? -1 : entity->GetAnimationState();
+}
+
+/**
+ * Retrieves the walkmesh triangle an entity is moving to.
+ *
+ * @param[in] name Entity name.
+ * @return The triangle ID, or -1 if the entity doesn't exist.
+ */
+static int FfiEntityGetMoveTriangleId(const char* name){
+    const Entity* entity = EntityManager::getSingleton().ScriptGetEntity(name);
+    return entity == nullptr ? -1 : entity->GetMoveTriangleId();
+}
+
+/**
+ * Retrieves the speed of the automatic movement of an entity.
+ *
+ * @param[in] name Entity name.
+ * @return The speed, or 0 if the entity doesn't exist.
+ */
+static float FfiEntityGetMoveAutoSpeed(const char* name){
+    const Entity* entity = EntityManager::getSingleton().ScriptGetEntity(name);
+    return entity == nullptr ? 0 : entity->GetMoveAutoSpeed();
+}
+
+/**
+ * Retrieves the total game time.
+ *
+ * @return The game time, in seconds.
+ */
+static float FfiTimerGetGameTimeTotal(){return Timer::getSingleton().GetGameTimeTotal();}
+
+/**
+ * Retrieves the game time elapsed since the last frame.
+ *
+ * @return The time delta, in seconds.
+ */
+static float FfiTimerGetGameTimeDelta(){return Timer::getSingleton().GetGameTimeDelta();}
+
+/**
+ * Retrieves the in-game timer.
+ *
+ * @return The timer value.
+ */
+static int FfiTimerGetTimer(){return Timer::getSingleton().GetGameTimer();}
+
+/**
+ * Retrieves the value of a bank address of the current savemap.
+ *
+ * @param[in] bank The memory bank.
+ * @param[in] address The address in the bank.
+ * @return The value. 0 for invalid banks or addresses.
+ */
+static int FfiSavemapGetData(unsigned int bank, unsigned int address){
+    return SavemapHandler::getSingleton().GetData(bank, address);
+}
+
+/**
+ * Sets the value of a bank address of the current savemap.
+ *
+ * @param[in] bank The memory bank.
+ * @param[in] address The address in the bank.
+ * @param[in] value The value to set.
+ */
+static void FfiSavemapSetData(unsigned int bank, unsigned int address, int value){
+    SavemapHandler::getSingleton().SetData(bank, address, value);
+}
+
+/**
+ * Table of the FFI bound functions.
+ *
+ * Must match the declaration in {@see FFI_BINDS_SCRIPT}.
+ */
+struct FfiBinds{
+    int (*entity_get_position)(const char*, float*);
+    void (*entity_set_position)(const char*, float, float, float);
+    float (*entity_get_rotation)(const char*);
+    void (*entity_set_rotation)(const char*, float);
+    int (*entity_get_state)(const char*);
+    int (*entity_get_animation_state)(const char*);
+    int (*entity_get_move_triangle_id)(const char*);
+    float (*entity_get_move_auto_speed)(const char*);
+    float (*timer_get_game_time_total)();
+    float (*timer_get_game_time_delta)();
+    int (*timer_get_timer)();
+    int (*savemap_get_data)(unsigned int, unsigned int);
+    void (*savemap_set_data)(unsigned int, unsigned int, int);
+};
+
+/**
+ * The FFI bound functions.
+ */
+static const FfiBinds FFI_BINDS = {
+    FfiEntityGetPosition,
+    FfiEntitySetPosition,
+    FfiEntityGetRotation,
+    FfiEntitySetRotation,
+    FfiEntityGetState,
+    FfiEntityGetAnimationState,
+    FfiEntityGetMoveTriangleId,
+    FfiEntityGetMoveAutoSpeed,
+    FfiTimerGetGameTimeTotal,
+    FfiTimerGetGameTimeDelta,
+    FfiTimerGetTimer,
+    FfiSavemapGetData,
+    FfiSavemapSetData
+};
+
+/**
+ * Lua chunk that declares {@see FfiBinds} and builds the "fast_binds" table.
+ *
+ * It receives the ffi module and a pointer to {@see FFI_BINDS}.
+ */
+static const char* FFI_BINDS_SCRIPT = R"(
+local ffi, pointer = ...
+ffi.cdef[[
+typedef struct{
+    int (*entity_get_position)(const char*, float*);
+    void (*entity_set_position)(const char*, float, float, float);
+    float (*entity_get_rotation)(const char*);
+    void (*entity_set_rotation)(const char*, float);
+    int (*entity_get_state)(const char*);
+    int (*entity_get_animation_state)(const char*);
+    int (*entity_get_move_triangle_id)(const char*);
+    float (*entity_get_move_auto_speed)(const char*);
+    float (*timer_get_game_time_total)();
+    float (*timer_get_game_time_delta)();
+    int (*timer_get_timer)();
+    int (*savemap_get_data)(unsigned int, unsigned int);
+    void (*savemap_set_data)(unsigned int, unsigned int, int);
+} vgears_ffi_binds;
+]]
+local binds = ffi.cast("const vgears_ffi_binds*", pointer)
+local position = ffi.new("float[3]")
+-- Entity states, as in Entity::State.
+local LINEAR, JUMP = 2, 3
+fast_binds = {
+    entity_get_position = function(name)
+        if binds.entity_get_position(name, position) == 0 then return nil end
+        return position[0], position[1], position[2]
+    end,
+    entity_set_position = function(name, x, y, z) binds.entity_set_position(name, x, y, z) end,
+    entity_get_rotation = function(name) return binds.entity_get_rotation(name) end,
+    entity_set_rotation = function(name, rotation) binds.entity_set_rotation(name, rotation) end,
+    entity_get_state = function(name) return binds.entity_get_state(name) end,
+    entity_get_animation_state = function(name) return binds.entity_get_animation_state(name) end,
+    entity_is_moving = function(name)
+        local state = binds.entity_get_state(name)
+        return state == LINEAR or state == JUMP
+    end,
+    entity_get_move_triangle_id = function(name)
+        return binds.entity_get_move_triangle_id(name)
+    end,
+    entity_get_move_auto_speed = function(name) return binds.entity_get_move_auto_speed(name) end,
+    timer_get_game_time_total = function() return binds.timer_get_game_time_total() end,
+    timer_get_game_time_delta = function() return binds.timer_get_game_time_delta() end,
+    timer_get_timer = function() return binds.timer_get_timer() end,
+    savemap_get_data = function(bank, address) return binds.savemap_get_data(bank, address) end,
+    savemap_set_data = function(bank, address, value)
+        binds.savemap_set_data(bank, address, value)
+    end
+}
+)";
+
+/**
+ * Builds the "fast_binds" table in a Lua state.
+ *
+ * Also enables the JIT compiler, which is only enabled when its library is opened.
+ *
+ * @param[in] state The Lua state.
+ * @return True if the table was built, false if there was an error. Errors are logged.
+ */
+static bool OpenFfiBinds(lua_State* state){
+    lua_pushcfunction(state, luaopen_jit);
+    lua_pushstring(state, LUA_JITLIBNAME);
+    lua_call(state, 1, 0);
+    if (luaL_loadbuffer(state, FFI_BINDS_SCRIPT, strlen(FFI_BINDS_SCRIPT), "=fast_binds") != 0){
+        LOG_ERROR(Ogre::String(lua_tostring(state, -1)));
+        lua_pop(state, 1);
+        return false;
+    }
+    lua_pushcfunction(state, luaopen_ffi);
+    lua_pushstring(state, LUA_FFILIBNAME);
+    lua_call(state, 1, 1);
+    lua_pushlightuserdata(state, const_cast<FfiBinds*>(&FFI_BINDS));
+    if (lua_pcall(state, 2, 0, 0) != 0){
+        LOG_ERROR(Ogre::String(lua_tostring(state, -1)));
+        lua_pop(state, 1);
+        return false;
+    }
+    return true;
+}
@@ -15,9 +15,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
 #include <OgreString.h>
 #include <Ogre.h>
-#include <vector>
 
 class UiWidget;
 
@@ -53,6 +54,137 @@ struct UiKeyFrameVector2{
     Ogre::Vector2 value;
 };
 
+/**
+ * A track of keyframes of an UI animation.
+ *
+ * Keyframes are kept sorted by time, and a cursor remembers where the last sample was taken, so
+ * sampling an animation as it plays doesn't need to look at every keyframe.
+ *
+ * Sampling interpolates between the last keyframe before the time and the first one at or after
+ * it. If there is no keyframe after time 0 and before the time, the first keyframe added is used
+ * as the previous one, at time 0. If there is no keyframe at or after the time and not after the
+ * animation length, the first keyframe added is used as the next one, at the end of the animation.
+ * When several keyframes have the same time, the first one added is used as the previous one, and
+ * the last one added as the next one.
+ *
+ * @tparam KeyFrame The type of keyframe, {@see UiKeyFrameFloat} or {@see UiKeyFrameVector2}.
+ */
+template <typename KeyFrame>
+class UiKeyFrameTrack{
+
+    public:
+
+        /**
+         * The type of the keyframe values.
+         */
+        typedef decltype(KeyFrame::value) Value;
+
+        /**
+         * Constructor.
+         */
+        UiKeyFrameTrack(): cursor_(0){}
+
+        /**
+         * Checks if the track has no keyframes.
+         *
+         * @return True if there are no keyframes, false otherwise.
+         */
+        bool IsEmpty() const{return key_frames_.empty();}
+
+        /**
+         * Adds a keyframe.
+         *
+         * @param[in] key_frame The keyframe to add. It's placed after any other keyframe with the
+         * same time.
+         */
+        void AddKeyFrame(const KeyFrame& key_frame){
+            if (key_frames_.empty()) first_ = key_frame.value;
+            key_frames_.insert(
+              std::upper_bound(
+                key_frames_.begin(), key_frames_.end(), key_frame.time,
+                [](const float time, const KeyFrame& other){return time < other.time;}
+              ),
+              key_frame
+            );
+            cursor_ = 0;
+        }
+
+        /**
+         * Samples the track.
+         *
+         * The track must not be empty.
+         *
+         * @param[in] time Animation time to sample at, in seconds.
+         * @param[in] length Animation length, in seconds.
+         * @return The interpolated value.
+         */
+        Value GetValue(const float time, const float length){
+            const auto begin = key_frames_.cbegin();
+            const auto end = key_frames_.cend();
+            const auto before = [](const KeyFrame& key_frame, const float time){
+                return key_frame.time < time;
+            };
+            const auto after = [](const float time, const KeyFrame& key_frame){
+                return time < key_frame.time;
+            };
+
+            // Move the cursor to the first keyframe at or after the time. Animations usually
+            // play forward, so it's most often already there or at the next keyframe.
+            if (!IsCursorAt(cursor_, time)){
+                if (IsCursorAt(cursor_ + 1, time)) ++ cursor_;
+                else cursor_ = std::lower_bound(begin, end, time, before) - begin;
+            }
+
+            Value min_value = first_;
+            float min = 0;
+            if (cursor_ > 0 && key_frames_[cursor_ - 1].time > 0){
+                const float min_time = key_frames_[cursor_ - 1].time;
+                min_value = std::lower_bound(begin, begin + cursor_, min_time, before)->value;
+                min = min_time;
+            }
+            Value max_value = first_;
+            float max = length;
+            if (cursor_ < key_frames_.size() && key_frames_[cursor_].time <= length){
+                const float max_time = key_frames_[cursor_].time;
+                max_value = (std::upper_bound(begin + cursor_, end, max_time, after) - 1)->value;
+                max = max_time;
+            }
+
+            if (time == 0) return min_value;
+            return min_value + (max_value - min_value) * ((time - min) / (max - min));
+        }
+
+    private:
+
+        /**
+         * Checks if a cursor position is the first keyframe at or after a time.
+         *
+         * @param[in] cursor The cursor position. It can be past the last keyframe.
+         * @param[in] time The time.
+         * @return True if the cursor is at the first keyframe at or after the time.
+         */
+        bool IsCursorAt(const size_t cursor, const float time) const{
+            if (cursor > key_frames_.size()) return false;
+            return (cursor == key_frames_.size() || key_frames_[cursor].time >= time)
+              && (cursor == 0 || key_frames_[cursor - 1].time < time);
+        }
+
+        /**
+         * The keyframes, sorted by time.
+         */
+        std::vector<KeyFrame> key_frames_;
+
+        /**
+         * Value of the first keyframe added.
+         */
+        Value first_;
+
+        /**
+         * Index of the first keyframe at or after the last sampled time.
+         */
+        size_t cursor_;
+};
+
 /**
  * An UI element animation.
  */
@@ -202,18 +334,20 @@ class UiAnimation{
         UiAnimation();
 
         /**
-         * Gets the value from a @{see UiKeyFrameFloat}.
+         * Gets the value of a float track at the current time.
          *
-         * @return The value of the keyframe.
+         * @param[in] track The track to sample.
+         * @return The interpolated value.
          */
-        float KeyFrameGetValue(std::vector<UiKeyFrameFloat>& data);
+        float KeyFrameGetValue(UiKeyFrameTrack<UiKeyFrameFloat>& track);
 
         /**
-         * Gets the value from a @{see UiKeyFrameVector2}.
+         * Gets the value of a coordinate track at the current time.
          *
-         * @return The value of the keyframe.
+         * @param[in] track The track to sample.
+         * @return The interpolated value.
          */
-        Ogre::Vector2 KeyFrameGetValue(std::vector<UiKeyFrameVector2>& data);
+        Ogre::Vector2 KeyFrameGetValue(UiKeyFrameTrack<UiKeyFrameVector2>& track);
 
         /**
          * The UI animation name.
@@ -238,55 +372,55 @@ class UiAnimation{
         /**
          * List of scale keyframes.
          */
-        std::vector<UiKeyFrameVector2> scale_;
+        UiKeyFrameTrack<UiKeyFrameVector2> scale_;
 
         /**
          * List of X position keyframes.
          */
-        std::vector<UiKeyFrameVector2> x_;
+        UiKeyFrameTrack<UiKeyFrameVector2> x_;
 
         /**
          * List of Y position keyframes.
          */
-        std::vector<UiKeyFrameVector2> y_;
+        UiKeyFrameTrack<UiKeyFrameVector2> y_;
 
         /**
          * List of width keyframes.
          */
-        std::vector<UiKeyFrameVector2> width_;
+        UiKeyFrameTrack<UiKeyFrameVector2> width_;
 
         /**
          * List of height keyframes.
          */
-        std::vector<UiKeyFrameVector2> height_;
+        UiKeyFrameTrack<UiKeyFrameVector2> height_;
 
         /**
          * List of rotation keyframes.
          */
-        std::vector<UiKeyFrameFloat> rotation_;
+        UiKeyFrameTrack<UiKeyFrameFloat> rotation_;
 
         /**
          * List of alpha keyframes.
          */
-        std::vector<UiKeyFrameFloat> alpha_;
+        UiKeyFrameTrack<UiKeyFrameFloat> alpha_;
 
         /**
          * @todo Understand and document.
          */
-        std::vector<UiKeyFrameVector2> scissor_x_top_;
+        UiKeyFrameTrack<UiKeyFrameVector2> scissor_x_top_;
 
         /**
          * @todo Understand and document.
          */
-        std::vector<UiKeyFrameVector2> scissor_y_left_;
+        UiKeyFrameTrack<UiKeyFrameVector2> scissor_y_left_;
 
         /**
          * @todo Understand and document.
          */
-        std::vector<UiKeyFrameVector2> scissor_x_bottom_;
+        UiKeyFrameTrack<UiKeyFrameVector2> scissor_x_bottom_;
 
         /**
          * @todo Understand and document.
          */
-        std::vector<UiKeyFrameVector2> scissor_y_right_;
+        UiKeyFrameTrack<UiKeyFrameVector2> scissor_y_right_;
 };
@@ -33,29 +33,36 @@ void Walkmesh::UpdateDebug(){
         DEBUG_DRAW.SetScreenSpace(true);
         DEBUG_DRAW.SetTextAlignment(DEBUG_DRAW.CENTER);
 
-        for (const auto &triangle : triangles_){
-            if (triangle.access_side[0] == -1) DEBUG_DRAW.SetColour(Ogre::ColourValue(1, 0, 0, 1));
-            else DEBUG_DRAW.SetColour(Ogre::ColourValue(1, 1, 1, 1));
-            DEBUG_DRAW.Line3d(triangle.a, triangle.b);
-            if (triangle.access_side[1] == -1) DEBUG_DRAW.SetColour(Ogre::ColourValue(1, 0, 0, 1));
-            else DEBUG_DRAW.SetColour(Ogre::ColourValue(1, 1, 1, 1));
-            DEBUG_DRAW.Line3d(triangle.b, triangle.c);
-            if (triangle.access_side[2] == -1) DEBUG_DRAW.SetColour(Ogre::ColourValue(1, 0, 0, 1));
-            else DEBUG_DRAW.SetColour(Ogre::ColourValue(1, 1, 1, 1));
-            DEBUG_DRAW.Line3d(triangle.c, triangle.a);
+        for (size_t t = 0; t < locked_.size(); ++ t){
+            const Ogre::Vector3* vertex = &vertices_[t * 3];
+            const int* access_side = &access_sides_[t * 3];
+            for (int side = 0; side < 3; ++ side){
+                if (access_side[side] == -1) DEBUG_DRAW.SetColour(Ogre::ColourValue(1, 0, 0, 1));
+                else DEBUG_DRAW.SetColour(Ogre::ColourValue(1, 1, 1, 1));
+                DEBUG_DRAW.Line3d(vertex[side], vertex[(side + 1) % 3]);
+            }
             DEBUG_DRAW.SetColour(Ogre::ColourValue(1, 1, 1, 1));
             DEBUG_DRAW.SetFadeDistance(40, 50);
-            Ogre::Vector3 triangle_pos = (triangle.a + triangle.b + triangle.c) / 3;
         }
     }
 }
 
-void Walkmesh::Clear(){triangles_.clear();}
+void Walkmesh::Clear(){
+    vertices_.clear();
+    access_sides_.clear();
+    locked_.clear();
+}
 
-void Walkmesh::AddTriangle(const WalkmeshTriangle& triangle){triangles_.push_back(triangle);}
+void Walkmesh::AddTriangle(const WalkmeshTriangle& triangle){
+    vertices_.push_back(triangle.a);
+    vertices_.push_back(triangle.b);
+    vertices_.push_back(triangle.c);
+    access_sides_.insert(access_sides_.end(), triangle.access_side, triangle.access_side + 3);
+    locked_.push_back(triangle.locked ? 1 : 0);
+}
 
 int Walkmesh::GetAccessSide(unsigned int triangle_id, unsigned char side) const{
-    if (triangle_id >= triangles_.size()){
+    if (triangle_id >= locked_.size()){
         LOG_ERROR("Triangle_id greater than number of triangles in walkmesh or less than zero.");
         return -1;
     }
@@ -63,51 +70,55 @@ int Walkmesh::GetAccessSide(unsigned int triangle_id, unsigned char side) const{
         LOG_ERROR("Side greater than 2. Side indexed from 0 to 2.");
         return -1;
     }
-    return triangles_[triangle_id].access_side[side];
+    return GetAccessSideUnchecked(triangle_id, side);
 }
 
 const Ogre::Vector3& Walkmesh::GetA(unsigned int triangle_id) const{
-    if (triangle_id >= triangles_.size()){
+    if (triangle_id >= locked_.size()){
         LOG_ERROR("Triangle_id greater than number of triangles in walkmesh or less than zero.");
         return Ogre::Vector3::ZERO;
     }
-    return triangles_[triangle_id].a;
+    return GetAUnchecked(triangle_id);
 }
 
 const Ogre::Vector3& Walkmesh::GetB(unsigned int triangle_id) const{
-    if (triangle_id >= triangles_.size()){
+    if (triangle_id >= locked_.size()){
         LOG_ERROR("Triangle_id greater than number of triangles in walkmesh or less than zero.");
         return Ogre::Vector3::ZERO;
     }
-    return triangles_[triangle_id].b;
+    return GetBUnchecked(triangle_id);
 }
 
 const Ogre::Vector3& Walkmesh::GetC(unsigned int triangle_id) const{
-    if (triangle_id >= triangles_.size()){
+    if (triangle_id >= locked_.size()){
         LOG_ERROR("Triangle_id greater than number of triangles in walkmesh or less than zero.");
         return Ogre::Vector3::ZERO;
     }
-    return triangles_[triangle_id].c;
+    return GetCUnchecked(triangle_id);
 }
 
-int Walkmesh::GetNumberOfTriangles() const{return triangles_.size();}
+int Walkmesh::GetNumberOfTriangles() const{return locked_.size();}
 
 void Walkmesh::LockWalkmesh(unsigned int triangle_id, bool lock){
-    if (triangle_id >= triangles_.size()){
+    if (triangle_id >= locked_.size()){
         LOG_ERROR("Triangle_id greater than number of triangles in walkmesh or less than zero.");
         return;
     }
-    triangles_[triangle_id].locked = lock;
+    locked_[triangle_id] = lock ? 1 : 0;
 }
 
 bool Walkmesh::IsLocked(unsigned int triangle_id) const{
-    if (triangle_id >= triangles_.size()){
+    if (triangle_id >= locked_.size()){
         LOG_ERROR("Triangle_id greater than number of triangles in walkmesh or less than zero.");
         return false;
     }
-    return triangles_[triangle_id].locked;
+    return IsLockedUnchecked(triangle_id);
 }
 
 void Walkmesh::load(const VGears::WalkmeshFilePtr &walkmesh){
+    const size_t count = locked_.size() + walkmesh->GetTriangles().size();
+    vertices_.reserve(count * 3);
+    access_sides_.reserve(count * 3);
+    locked_.reserve(count);
     for (const auto &triangle : walkmesh->GetTriangles()) AddTriangle(triangle);
 }
@@ -17,6 +17,7 @@
 
 #include <Ogre.h>
 #include <vector>
+#include "core/Assert.h"
 
 /**
  * A triangle of a walkmesh.
@@ -64,6 +65,13 @@ namespace VGears{
 
 /**
  * A walkmesh.
+ *
+ * Triangles are stored as a structure of arrays: vertices, access sides and locks are kept in
+ * separate packed arrays, so walking across the mesh only touches the data it needs.
+ *
+ * The Get* accessors check the triangle ID and log an error if it's invalid. The *Unchecked
+ * accessors are inline and only assert it in debug builds. They are meant for hot paths that
+ * have already validated the ID, such as moving entities on the walkmesh every frame.
  */
 class Walkmesh{
 
@@ -130,6 +138,57 @@ class Walkmesh{
          */
         const Ogre::Vector3& GetC(unsigned int triangle_id) const;
 
+        /**
+         * Checks which other triangle is accessed from one side of a triangle, without checking
+         * the parameters.
+         *
+         * @param[in] triangle_id Triangle. Must exist.
+         * @param[in] side The side index in the triangle. Must be 0, 1 or 2.
+         * @return The id of the triangle accessed from the indicated triangle and side, or -1 if
+         * no triangle can be accessed.
+         */
+        int GetAccessSideUnchecked(unsigned int triangle_id, unsigned char side) const;
+
+        /**
+         * Retrieves the first side of a triangle, without checking the triangle ID.
+         *
+         * @param[in] triangle_id ID of the triangle. Must exist.
+         * @return The side of the triangle.
+         */
+        const Ogre::Vector3& GetAUnchecked(unsigned int triangle_id) const;
+
+        /**
+         * Retrieves the second side of a triangle, without checking the triangle ID.
+         *
+         * @param[in] triangle_id ID of the triangle. Must exist.
+         * @return The side of the triangle.
+         */
+        const Ogre::Vector3& GetBUnchecked(unsigned int triangle_id) const;
+
+        /**
+         * Retrieves the third side of a triangle, without checking the triangle ID.
+         *
+         * @param[in] triangle_id ID of the triangle. Must exist.
+         * @return The side of the triangle.
+         */
+        const Ogre::Vector3& GetCUnchecked(unsigned int triangle_id) const;
+
+        /**
+         * Checks if a triangle is locked, without checking the triangle ID.
+         *
+         * @param[in] triangle_id ID of the triangle. Must exist.
+         * @return True if the triangle is locked, false otherwise.
+         */
+        bool IsLockedUnchecked(unsigned int triangle_id) const;
+
+        /**
+         * Checks if a triangle exists.
+         *
+         * @param[in] triangle_id ID of the triangle.
+         * @return True if the triangle is in the walkmesh, false otherwise.
+         */
+        bool IsValidTriangle(int triangle_id) const;
+
         /**
          * Counts the triangles in the walkmesh.
          *
@@ -163,8 +222,49 @@ class Walkmesh{
     private:
 
         /**
-         * The list of triangles.
+         * Vertices of the triangles, three per triangle (a, b and c).
+         */
+        std::vector<Ogre::Vector3> vertices_;
+
+        /**
+         * Access sides of the triangles, three per triangle.
+         */
+        std::vector<int> access_sides_;
+
+        /**
+         * Lock state of the triangles, one per triangle.
          */
-        std::vector<WalkmeshTriangle> triangles_;
+        std::vector<unsigned char> locked_;
 };
 
+inline int Walkmesh::GetAccessSideUnchecked(
+  unsigned int triangle_id, unsigned char side
+) const{
+    VGEARS_ASSERT(triangle_id < locked_.size() && side < 3, "Invalid walkmesh triangle side");
+    return access_sides_[triangle_id * 3 + side];
+}
+
+inline const Ogre::Vector3& Walkmesh::GetAUnchecked(unsigned int triangle_id) const{
+    VGEARS_ASSERT(triangle_id < locked_.size(), "Invalid walkmesh triangle");
+    return vertices_[triangle_id * 3];
+}
+
+inline const Ogre::Vector3& Walkmesh::GetBUnchecked(unsigned int triangle_id) const{
+    VGEARS_ASSERT(triangle_id < locked_.size(), "Invalid walkmesh triangle");
+    return vertices_[triangle_id * 3 + 1];
+}
+
+inline const Ogre::Vector3& Walkmesh::GetCUnchecked(unsigned int triangle_id) const{
+    VGEARS_ASSERT(triangle_id < locked_.size(), "Invalid walkmesh triangle");
+    return vertices_[triangle_id * 3 + 2];
+}
+
+inline bool Walkmesh::IsLockedUnchecked(unsigned int triangle_id) const{
+    VGEARS_ASSERT(triangle_id < locked_.size(), "Invalid walkmesh triangle");
+    return locked_[triangle_id] != 0;
+}
+
+inline bool Walkmesh::IsValidTriangle(int triangle_id) const{
+    return triangle_id >= 0 && static_cast<size_t>(triangle_id) < locked_.size();
+}
+
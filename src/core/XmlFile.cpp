@@ -24,6 +24,14 @@ XmlFile::XmlFile(const Ogre::String& file): file_(file){
         LOG_ERROR("Can't open " + file + ". TinyXml Error: " + file_.ErrorDesc());
 }
 
+XmlFile::XmlFile(const Ogre::String& file, const Ogre::String& content): file_(file){
+    file_.SetCondenseWhiteSpace(false);
+    file_.Parse(content.c_str());
+    normal_file_ = !file_.Error();
+    if (normal_file_ == false)
+        LOG_ERROR("Can't parse " + file + ". TinyXml Error: " + file_.ErrorDesc());
+}
+
 XmlFile::~XmlFile(){}
 
 bool XmlFile::GetBool(TiXmlNode* node, const Ogre::String& tag, bool def) const{
@@ -37,6 +37,16 @@ class XmlFile{
          */
         XmlFile(const Ogre::String& file);
 
+        /**
+         * Constructor.
+         *
+         * Parses an XML document already in memory.
+         *
+         * @param[in] file Name of the XML file, used in error messages.
+         * @param[in] content Contents of the XML file.
+         */
+        XmlFile(const Ogre::String& file, const Ogre::String& content);
+
         /**
          * Destructor.
          */
@@ -13,13 +13,21 @@
  * GNU General Public License for more details.
  */
 
+#include <fstream>
+#include <iterator>
+#include <utility>
 #include "core/AudioManager.h"
 #include "core/EntityManager.h"
+#include "core/FieldPreloader.h"
 #include "core/Logger.h"
+#include "core/ResourceGroupLoader.h"
 #include "core/ScriptManager.h"
 #include "core/XmlBackground2DFile.h"
 #include "core/XmlMapFile.h"
+#include "core/XmlTextFile.h"
 #include "map/VGearsBackground2DFileManager.h"
+#include "map/VGearsFieldBundle.h"
+#include "map/VGearsFieldBundleXMLSerializer.h"
 #include "map/VGearsWalkmeshFileManager.h"
 #include "TextHandler.h"
 
@@ -33,100 +41,117 @@ void XmlMapFile::LoadMap(){
         LOG_ERROR(file_.ValueStr() + " is not a valid fields map file! No <map> in root.");
         return;
     }
-    node = node->FirstChild();
-    while (node != nullptr){
-        if (node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "walkmesh"){
-            Ogre::String name(GetString(node, "file_name"));
-            if (!name.empty()){
-                VGears::WalkmeshFileManager::getSingleton();
-                VGears::WalkmeshFilePtr walkmesh = VGears::WalkmeshFileManager::getSingleton()
-                  .load(name, "FIELDS").staticCast<VGears::WalkmeshFile>();
-                EntityManager::getSingleton().GetWalkmesh()->load(walkmesh);
-            }
-        }
-        else if (
-          node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "movement_rotation"
-        ){
-            Ogre::Degree rotation = Ogre::Degree(GetFloat(node, "degree", 0));
-            EntityManager::getSingleton().SetPlayerMoveRotation(Ogre::Radian(rotation));
-        }
-        else if (node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "background2d"){
-            Ogre::String name = GetString(node, "file_name");
-            if (name != ""){
-                // TODO Migrate this code to a Resource and use it's group to load the background.
-                VGears::Background2DFilePtr background
-                  = VGears::Background2DFileManager::getSingleton()
-                    .load(name, "FIELDS").staticCast<VGears::Background2DFile>();
-                EntityManager::getSingleton().GetBackground2D()->load(background);
-            }
-        }
-        else if (node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "texts"){
-            TextHandler::getSingleton().LoadFieldText(GetString(node, "file_name"));
-        }
-        else if (node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "entity_model"){
-            Ogre::String name = GetString(node, "name");
-            if (name == ""){
-                LOG_ERROR("There is no name specified for <entity_model> tag.");
-                continue;
-            }
-            Ogre::String file_name = GetString(node, "file_name");
-            if (file_name == ""){
-                LOG_ERROR("There is no file_name specified for <entity_model> tag.");
-                continue;
-            }
-            Ogre::Vector3 position(GetVector3(node, "position"));
-            Ogre::Degree direction(Ogre::Degree(GetFloat(node, "direction")));
-            Ogre::Vector3 scale(GetVector3(node, "scale", Ogre::Vector3::UNIT_SCALE));
-            Ogre::Quaternion orientation(GetQuaternion(node, "root_orientation"));
-            int index(GetInt(node, "index"));
-            EntityManager::getSingleton().AddEntity(
-              name, file_name, position, direction, scale, orientation, index
-            );
-        }
-        else if (
-          node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "entity_trigger"
-        ){
-            Ogre::String name = GetString(node, "name");
-            if (name == ""){
-                LOG_ERROR("There is no name specified for <entity_trigger> tag.");
-                continue;
-            }
-            Ogre::Vector3 point1 = GetVector3(node, "point1", Ogre::Vector3::ZERO);
-            Ogre::Vector3 point2 = GetVector3(node, "point2", Ogre::Vector3::ZERO);
-            bool enabled = GetBool(node, "enabled", false);
-            EntityManager::getSingleton().AddEntityTrigger(name, point1, point2, enabled);
-        }
-        else if (node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "entity_point"){
-            Ogre::String name = GetString(node, "name");
-            if (name == ""){
-                LOG_ERROR("There is no name specified for <entity_point> tag.");
-                continue;
-            }
-            Ogre::Vector3 position = GetVector3(node, "position");
-            float rotation = GetFloat(node, "rotation");
-            EntityManager::getSingleton().AddEntityPoint(name, position, rotation);
-        }
-        else if (node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "entity_script"){
-            Ogre::String name = GetString(node, "name");
-            if (name == ""){
-                LOG_ERROR("There is no name specified for <entity_script> tag.");
-                continue;
-            }
-            EntityManager::getSingleton().AddEntityScript(name);
-        }
-        else if (node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "script"){
-            Ogre::String file_name = GetString(node, "file_name");
-            if (file_name != "") ScriptManager::getSingleton().RunFile("fields/" + file_name);
-        }
-        else if (node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "tracks"){
-            for (TiXmlNode* track = node->FirstChild(); track; track = track->NextSibling()){
-                int id = GetInt(track, "id");
-                int track_id = GetInt(track, "track_id");
-                AudioManager::getSingleton().AddTrack(id, track_id);
-            }
+    VGears::FieldBundle bundle;
+    VGears::FieldBundleXMLSerializer serializer;
+    serializer.ReadMap(node, &bundle);
+    ReadScripts("./data/fields/", bundle);
+    Load(bundle);
+}
+
+void XmlMapFile::ReadScripts(const Ogre::String& directory, VGears::FieldBundle& bundle){
+    for (const VGears::FieldBundle::Record& record : bundle.GetRecords()){
+        if (record.type != VGears::FieldBundle::RecordType::SCRIPT) continue;
+        std::ifstream script(directory + record.file_name, std::ifstream::binary);
+        if (!script.is_open()) continue;
+        std::string source(
+          (std::istreambuf_iterator<char>(script)), std::istreambuf_iterator<char>()
+        );
+        VGears::FieldBundle::FindGateways(source, bundle.GetGateways());
+        // Run the text already read, unless there is a precompiled version to run instead.
+        if (!ScriptManager::IsPrecompiled(directory + record.file_name))
+            bundle.GetScripts()[record.file_name] = std::move(source);
+    }
+}
+
+void XmlMapFile::LoadMap(const Ogre::String& directory, const Ogre::String& file){
+    VGears::FieldBundle bundle;
+    if (bundle.Open(directory, file)){
+        Load(bundle);
+        return;
+    }
+    XmlMapFile xml_map(directory + file);
+    xml_map.LoadMap();
+}
+
+void XmlMapFile::Load(const VGears::FieldBundle& bundle){
+    ResourceGroupLoader::getSingleton().Wait();
+    for (const VGears::FieldBundle::Record& record : bundle.GetRecords()){
+        switch (record.type){
+            case VGears::FieldBundle::RecordType::WALKMESH:
+                {
+                    auto embedded = bundle.GetWalkmeshes().find(record.file_name);
+                    VGears::WalkmeshFilePtr walkmesh = embedded != bundle.GetWalkmeshes().end()
+                      ? embedded->second
+                      : VGears::WalkmeshFileManager::getSingleton()
+                        .load(record.file_name, "FIELDS").staticCast<VGears::WalkmeshFile>();
+                    EntityManager::getSingleton().GetWalkmesh()->load(walkmesh);
+                }
+                break;
+            case VGears::FieldBundle::RecordType::MOVEMENT_ROTATION:
+                EntityManager::getSingleton().SetPlayerMoveRotation(
+                  Ogre::Radian(Ogre::Degree(record.angle))
+                );
+                break;
+            case VGears::FieldBundle::RecordType::BACKGROUND_2D:
+                {
+                    // TODO Migrate this code to a Resource and use it's group to load the
+                    // background.
+                    auto embedded = bundle.GetBackgrounds().find(record.file_name);
+                    VGears::Background2DFilePtr background
+                      = embedded != bundle.GetBackgrounds().end()
+                        ? embedded->second
+                        : VGears::Background2DFileManager::getSingleton()
+                          .load(record.file_name, "FIELDS").staticCast<VGears::Background2DFile>();
+                    EntityManager::getSingleton().GetBackground2D()->load(background);
+                }
+                break;
+            case VGears::FieldBundle::RecordType::TEXTS:
+                {
+                    auto embedded = bundle.GetTexts().find(record.file_name);
+                    if (embedded != bundle.GetTexts().end()){
+                        XmlTextFile texts(record.file_name, embedded->second);
+                        texts.LoadTexts();
+                    }
+                    else TextHandler::getSingleton().LoadFieldText(record.file_name);
+                }
+                break;
+            case VGears::FieldBundle::RecordType::ENTITY_MODEL:
+                EntityManager::getSingleton().AddEntity(
+                  record.name, record.file_name, record.position, Ogre::Degree(record.angle),
+                  record.scale, record.orientation, record.index
+                );
+                break;
+            case VGears::FieldBundle::RecordType::ENTITY_TRIGGER:
+                EntityManager::getSingleton().AddEntityTrigger(
+                  record.name, record.position, record.point2, record.enabled
+                );
+                break;
+            case VGears::FieldBundle::RecordType::ENTITY_POINT:
+                EntityManager::getSingleton().AddEntityPoint(
+                  record.name, record.position, record.angle
+                );
+                break;
+            case VGears::FieldBundle::RecordType::ENTITY_SCRIPT:
+                EntityManager::getSingleton().AddEntityScript(record.name);
+                break;
+            case VGears::FieldBundle::RecordType::SCRIPT:
+                {
+                    auto embedded = bundle.GetScripts().find(record.file_name);
+                    if (embedded != bundle.GetScripts().end()){
+                        ScriptManager::getSingleton().RunChunk(
+                          "fields/" + record.file_name, embedded->second
+                        );
+                    }
+                    else ScriptManager::getSingleton().RunFile("fields/" + record.file_name);
+                }
+                break;
+            case VGears::FieldBundle::RecordType::TRACK:
+                AudioManager::getSingleton().AddTrack(record.index, record.track);
+                break;
         }
-        node = node->NextSibling();
     }
+    if (FieldPreloader::getSingletonPtr() != nullptr)
+        FieldPreloader::getSingleton().Preload(bundle.GetGateways());
 }
 
 const Ogre::String XmlMapFile::GetWalkmeshFileName(){
@@ -17,6 +17,10 @@
 
 #include "XmlFile.h"
 
+namespace VGears{
+    class FieldBundle;
+}
+
 /**
  * Handles XML map files.
  */
@@ -41,6 +45,30 @@ class XmlMapFile : public XmlFile{
          */
         void LoadMap();
 
+        /**
+         * Loads a map.
+         *
+         * The map is loaded from its bundle if there is one and it's up to date. Otherwise, the
+         * map XML file is parsed.
+         *
+         * @param[in] directory Directory the paths in the map file are relative to, with a
+         * trailing slash.
+         * @param[in] file Path to the XML map file, relative to the directory.
+         */
+        static void LoadMap(const Ogre::String& directory, const Ogre::String& file);
+
+        /**
+         * Reads the scripts of a map parsed from its XML file.
+         *
+         * Scripts are scanned for gateways, whose destinations are added to the bundle gateways.
+         * The text read is added to the bundle scripts, so it's not read again when the map is
+         * loaded, unless there is a precompiled version of the script, which is run instead.
+         *
+         * @param[in] directory Directory the script paths are relative to, with a trailing slash.
+         * @param[in,out] bundle The bundle with the map records.
+         */
+        static void ReadScripts(const Ogre::String& directory, VGears::FieldBundle& bundle);
+
         /**
          * Retrieves the path to the map walkmesh file.
          *
@@ -48,4 +76,14 @@ class XmlMapFile : public XmlFile{
          * map, an error  message will be written to console and an empty string will be returned.
          */
         const Ogre::String GetWalkmeshFileName();
+
+        /**
+         * Loads the map data from the records of a bundle.
+         *
+         * Files embedded in the bundle are used directly, the rest are read from disk. When
+         * done, the fields the map gateways lead to are preloaded in the background.
+         *
+         * @param[in] bundle The bundle to load.
+         */
+        static void Load(const VGears::FieldBundle& bundle);
 };
@@ -53,3 +53,21 @@ void XmlMapsFile::GetMapNames(Ogre::StringVector& complete_params){
         node = node->NextSibling();
     }
 }
+
+void XmlMapsFile::GetMapFiles(Ogre::StringVector& names, Ogre::StringVector& file_names){
+    TiXmlNode* node = file_.RootElement();
+    if (node == nullptr || node->ValueStr() != "maps"){
+        LOG_ERROR(
+          "Field XML Manager: " + file_.ValueStr() + " is not a valid maps file! No <maps> in root."
+        );
+        return;
+    }
+    node = node->FirstChild();
+    while (node != nullptr){
+        if (node->Type() == TiXmlNode::TINYXML_ELEMENT && node->ValueStr() == "map"){
+            names.push_back(GetString(node, "name"));
+            file_names.push_back(GetString(node, "file_name"));
+        }
+        node = node->NextSibling();
+    }
+}
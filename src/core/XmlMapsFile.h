@@ -52,4 +52,12 @@ class XmlMapsFile : public XmlFile{
          * @param[out] complete_params The list of map names will be loaded here.
          */
         void GetMapNames(Ogre::StringVector& complete_params);
+
+        /**
+         * Retrieves the names and files of all maps.
+         *
+         * @param[out] names The map names will be loaded here.
+         * @param[out] file_names The path to the file of each map will be loaded here.
+         */
+        void GetMapFiles(Ogre::StringVector& names, Ogre::StringVector& file_names);
 };
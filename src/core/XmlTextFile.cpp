@@ -21,6 +21,10 @@
 
 XmlTextFile::XmlTextFile(const Ogre::String& file): XmlFile(file){}
 
+XmlTextFile::XmlTextFile(const Ogre::String& file, const Ogre::String& content):
+  XmlFile(file, content)
+{}
+
 XmlTextFile::~XmlTextFile(){}
 
 void XmlTextFile::LoadTexts(){
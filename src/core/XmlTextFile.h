@@ -31,6 +31,14 @@ class XmlTextFile : public XmlFile{
          */
         XmlTextFile(const Ogre::String& file);
 
+        /**
+         * Constructor.
+         *
+         * @param[in] file Name of the text file, used in error messages.
+         * @param[in] content Contents of the text file.
+         */
+        XmlTextFile(const Ogre::String& file, const Ogre::String& content);
+
         /**
          * Destructor.
          */
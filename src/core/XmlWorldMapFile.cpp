@@ -16,6 +16,7 @@
 #include "core/AudioManager.h"
 #include "core/EntityManager.h"
 #include "core/Logger.h"
+#include "core/ResourceGroupLoader.h"
 #include "core/ScriptManager.h"
 #include "core/WorldMapManager.h"
 #include "core/XmlBackground2DFile.h"
@@ -29,6 +30,7 @@ XmlWorldMapFile::XmlWorldMapFile(const Ogre::String& file): XmlFile(file){}
 XmlWorldMapFile::~XmlWorldMapFile(){}
 
 void XmlWorldMapFile::LoadWorldMap(const unsigned int current_progress){
+    ResourceGroupLoader::getSingleton().Wait();
     TiXmlNode* node = file_.RootElement();
     if (node == nullptr || node->ValueStr() != "world_map"){
         LOG_ERROR(file_.ValueStr() + " is not a valid fields map file! No <world_map> in root.");
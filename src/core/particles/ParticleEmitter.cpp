@@ -13,9 +13,8 @@
  * GNU General Public License for more details.
  */
 
-#include <OgreLogManager.h>
+#include <atomic>
 #include <OgreString.h>
-#include <OgreStringConverter.h>
 #include "core/particles/ParticleEmitter.h"
 #include "core/particles/ParticleTechnique.h"
 
@@ -24,39 +23,64 @@ ParticleEmitterDictionary::EmissionRate
 ParticleEmitterDictionary::TotalTimeToLive
   ParticleEmitter::total_time_to_live_dictionary_;
 ParticleEmitterDictionary::Direction ParticleEmitter::direction_dictionary_;
+ParticleEmitterDictionary::Burst ParticleEmitter::burst_dictionary_;
+ParticleEmitterDictionary::BurstInterval ParticleEmitter::burst_interval_dictionary_;
+
+/**
+ * Seed for the random number generator of the next emitter.
+ */
+static std::atomic<unsigned int> next_random_seed(1);
 
 ParticleEmitter::ParticleEmitter(void) :
     Particle(),
+    random_(next_random_seed ++),
     parent_technique_(nullptr),
     name_(Ogre::BLANKSTRING),
     emits_name_(Ogre::BLANKSTRING),
     emits_type_(PT_VISUAL),
     emission_rate_(1),
     emission_remainder_(0),
+    burst_(0),
+    burst_interval_(0),
+    burst_remainder_(0),
     emit_direction_1_(Ogre::Vector3::ZERO),
     emit_direction_2_(Ogre::Vector3::ZERO),
     emit_total_time_to_live_(10)
 {
     particle_type_ = PT_EMITTER;
-    if (createParamDictionary("ParticleEmitter")){
-        Ogre::ParamDictionary* dict = getParamDictionary();
-        dict->addParameter(
-          Ogre::ParameterDef("emission_rate", "", Ogre::PT_INT),
-          &emission_rate_dictionary_
-        );
-        dict->addParameter(
-          Ogre::ParameterDef("time_to_live", "", Ogre::PT_REAL),
-          &total_time_to_live_dictionary_
-        );
-        dict->addParameter(
-          Ogre::ParameterDef("direction", "", Ogre::PT_STRING),
-          &direction_dictionary_
-        );
-    }
+    if (createParamDictionary("ParticleEmitter")) AddBaseParameters(getParamDictionary());
 }
 
 ParticleEmitter::~ParticleEmitter(){}
 
+void ParticleEmitter::AddBaseParameters(Ogre::ParamDictionary* dict){
+    dict->addParameter(
+      Ogre::ParameterDef("emission_rate", "", Ogre::PT_INT),
+      &emission_rate_dictionary_
+    );
+    dict->addParameter(
+      Ogre::ParameterDef("time_to_live", "", Ogre::PT_REAL),
+      &total_time_to_live_dictionary_
+    );
+    dict->addParameter(
+      Ogre::ParameterDef("direction", "", Ogre::PT_STRING),
+      &direction_dictionary_
+    );
+    dict->addParameter(Ogre::ParameterDef("burst", "", Ogre::PT_INT), &burst_dictionary_);
+    dict->addParameter(
+      Ogre::ParameterDef("burst_interval", "", Ogre::PT_REAL), &burst_interval_dictionary_
+    );
+}
+
+Ogre::Real ParticleEmitter::UnitRandom(){
+    return static_cast<Ogre::Real>(random_() - std::minstd_rand::min())
+      / static_cast<Ogre::Real>(std::minstd_rand::max() - std::minstd_rand::min());
+}
+
+Ogre::Real ParticleEmitter::RangeRandom(const Ogre::Real low, const Ogre::Real high){
+    return low + (high - low) * UnitRandom();
+}
+
 void ParticleEmitter::CopyAttributesTo(ParticleEmitter* emitter){
     Particle::CopyAttributesTo(emitter);
     emitter->SetParentTechnique(parent_technique_);
@@ -67,40 +91,46 @@ void ParticleEmitter::CopyAttributesTo(ParticleEmitter* emitter){
     emitter->SetEmissionRate(emission_rate_);
     emitter->SetEmitDirectionRange(emit_direction_1_, emit_direction_2_);
     emitter->SetEmitTotalTimeToLive(emit_total_time_to_live_);
+    emitter->SetBurst(burst_);
+    emitter->SetBurstInterval(burst_interval_);
 }
 
-void ParticleEmitter::InitForEmission(){emission_remainder_ = 0;}
+void ParticleEmitter::InitForEmission(){
+    emission_remainder_ = 0;
+    burst_remainder_ = 0;
+}
 
 int ParticleEmitter::CalculateRequestedParticles(Ogre::Real time_elapsed){
     int request = 0;
-    Ogre::LogManager::getSingletonPtr()->logMessage(
-      "ParticleEmitter::CalculateRequestedParticles time:"
-      + Ogre::StringConverter::toString(time_elapsed)
-      + " emission rate:"
-      + Ogre::StringConverter::toString(emission_rate_)
-      + " reminder:"
-      + Ogre::StringConverter::toString(emission_remainder_)
-    );
-    if (enabled_ && emission_rate_ > 0){
+    if (enabled_ == false) return request;
+    if (emission_rate_ > 0){
         emission_remainder_ += emission_rate_ * time_elapsed;
         request = (int) emission_remainder_;
         emission_remainder_ -= request;
     }
+    if (burst_ > 0 && burst_remainder_ >= 0){
+        burst_remainder_ -= time_elapsed;
+        if (burst_interval_ <= 0){
+            // Single burst, on the first update.
+            request += burst_;
+            burst_remainder_ = -1;
+        }
+        else{
+            while (burst_remainder_ < 0){
+                request += burst_;
+                burst_remainder_ += burst_interval_;
+            }
+        }
+    }
     return request;
 }
 
 void ParticleEmitter::InitParticleForEmission(Particle* particle){
     particle->SetParentEmitter(this);
     particle->position = position; // Particle emits from emitter position
-    particle->direction.x = Ogre::Math::RangeRandom(
-      emit_direction_1_.x, emit_direction_2_.x
-    );
-    particle->direction.y = Ogre::Math::RangeRandom(
-      emit_direction_1_.y, emit_direction_2_.y
-    );
-    particle->direction.z = Ogre::Math::RangeRandom(
-      emit_direction_1_.z, emit_direction_2_.z
-    );
+    particle->direction.x = RangeRandom(emit_direction_1_.x, emit_direction_2_.x);
+    particle->direction.y = RangeRandom(emit_direction_1_.y, emit_direction_2_.y);
+    particle->direction.z = RangeRandom(emit_direction_1_.z, emit_direction_2_.z);
     particle->time_to_live = emit_total_time_to_live_;
     particle->total_time_to_live = emit_total_time_to_live_;
 }
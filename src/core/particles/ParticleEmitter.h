@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <random>
 #include <OgreStringInterface.h>
 #include "Particle.h"
 #include "ParticleEmitterDictionary.h"
@@ -164,6 +165,37 @@ class ParticleEmitter : public Ogre::StringInterface, public Particle{
         */
         int GetEmissionRate() const {return emission_rate_;};
 
+        /**
+         * Sets the number of particles emitted at once.
+         *
+         * Bursts are emitted on top of the emission rate. The first one is emitted on the first
+         * update, and then every {@see SetBurstInterval} seconds.
+         *
+         * @param[in] burst Number of particles in each burst. 0 to disable bursts.
+         */
+        void SetBurst(int burst) {burst_ = burst;};
+
+        /**
+         * Retrieves the number of particles emitted at once.
+         *
+         * @return Number of particles in each burst.
+         */
+        int GetBurst() const {return burst_;};
+
+        /**
+         * Sets the time between bursts.
+         *
+         * @param[in] interval Time between bursts, in seconds. 0 to emit only one burst.
+         */
+        void SetBurstInterval(Ogre::Real interval) {burst_interval_ = interval;};
+
+        /**
+         * Retrieves the time between bursts.
+         *
+         * @return Time between bursts, in seconds.
+         */
+        Ogre::Real GetBurstInterval() const {return burst_interval_;};
+
         /**
          * Sets the particle direction for the emitter.
          *
@@ -207,6 +239,42 @@ class ParticleEmitter : public Ogre::StringInterface, public Particle{
 
     protected:
 
+        /**
+         * Adds the parameters of all emitters to a parameter dictionary.
+         *
+         * Emitter types with parameters of their own create a dictionary with their name, and
+         * must add these to it too.
+         *
+         * @param[in,out] dict The dictionary.
+         */
+        void AddBaseParameters(Ogre::ParamDictionary* dict);
+
+        /**
+         * Generates a random number in the [0, 1] range.
+         *
+         * Techniques are updated in parallel, so emitters use their own generator instead of
+         * Ogre::Math, whose generator is shared by every thread.
+         *
+         * @return The random number.
+         */
+        Ogre::Real UnitRandom();
+
+        /**
+         * Generates a random number in a range.
+         *
+         * @param[in] low Lower limit of the range.
+         * @param[in] high Upper limit of the range.
+         * @return The random number.
+         */
+        Ogre::Real RangeRandom(const Ogre::Real low, const Ogre::Real high);
+
+        /**
+         * Random number generator of the emitter.
+         *
+         * Each emitter gets a different seed, in creation order, so emission is reproducible.
+         */
+        std::minstd_rand random_;
+
         /**
          * The particle technique.
          */
@@ -248,6 +316,31 @@ class ParticleEmitter : public Ogre::StringInterface, public Particle{
          */
         Ogre::Real emission_remainder_;
 
+        /**
+         * Dictionary for burst sizes.
+         */
+        static ParticleEmitterDictionary::Burst burst_dictionary_;
+
+        /**
+         * Number of particles in each burst. 0 if there are no bursts.
+         */
+        int burst_;
+
+        /**
+         * Dictionary for burst intervals.
+         */
+        static ParticleEmitterDictionary::BurstInterval burst_interval_dictionary_;
+
+        /**
+         * Time between bursts, in seconds. 0 for a single burst.
+         */
+        Ogre::Real burst_interval_;
+
+        /**
+         * Time left until the next burst, in seconds. Negative once a single burst is done.
+         */
+        Ogre::Real burst_remainder_;
+
         /**
          * Dictionary for particle directions.
          */
@@ -27,6 +27,16 @@ namespace ParticleEmitterDictionary{
         );
     }
 
+    void Burst::doSet(void* target, const Ogre::String& val){
+        static_cast<ParticleEmitter*>(target)->SetBurst(Ogre::StringConverter::parseInt(val));
+    }
+
+    void BurstInterval::doSet(void* target, const Ogre::String& val){
+        static_cast<ParticleEmitter*>(target)->SetBurstInterval(
+          Ogre::StringConverter::parseReal(val)
+        );
+    }
+
     void TotalTimeToLive::doSet(void* target, const Ogre::String& val){
         static_cast<ParticleEmitter*>(target)->SetEmitTotalTimeToLive(
           Ogre::StringConverter::parseReal(val)
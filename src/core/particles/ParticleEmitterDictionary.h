@@ -42,6 +42,52 @@ namespace ParticleEmitterDictionary{
             void doSet(void* target, const Ogre::String& val);
     };
 
+    /**
+     * The number of particles emitted at once by an emitter.
+     */
+    class Burst : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the burst size.
+             *
+             * @return Burst size.
+             */
+            Ogre::String doGet(const void* target) const{return "";};
+
+            /**
+             * Sets the burst size.
+             *
+             * @param[in] target The target.
+             * @param[in] val The number of particles in each burst.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+
+    /**
+     * The time between bursts of a particle emitter.
+     */
+    class BurstInterval : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the burst interval.
+             *
+             * @return Burst interval.
+             */
+            Ogre::String doGet(const void* target) const{return "";};
+
+            /**
+             * Sets the burst interval.
+             *
+             * @param[in] target The target.
+             * @param[in] val The time between bursts, in seconds.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+
     /**
      * The total time to live for particles emitted by an emitter.
      */
@@ -47,3 +47,5 @@ void ParticleRenderer::SetParentTechnique(ParticleTechnique* parent_technique){
 const ParticleTechnique* ParticleRenderer::GetParentTechnique() const{
     return parent_technique_;
 }
+
+void ParticleRenderer::NotifyCurrentCamera(Ogre::Camera* camera){}
@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <OgreCamera.h>
 #include <OgreString.h>
 #include <OgreStringInterface.h>
 #include "ParticlePool.h"
@@ -102,6 +103,15 @@ class ParticleRenderer : public Ogre::StringInterface{
          */
         virtual void Initialize() = 0;
 
+        /**
+         * Notifies the renderer of the camera the particles are being rendered with.
+         *
+         * Does nothing by default. Renderers that orient particles towards the camera use it.
+         *
+         * @param[in] camera The camera.
+         */
+        virtual void NotifyCurrentCamera(Ogre::Camera* camera);
+
         /**
          * Adds the particle to the scene render queue.
          *
@@ -13,11 +13,15 @@
  * GNU General Public License for more details.
  */
 
-#include <OgreLogManager.h>
 #include <OgreSceneNode.h>
+#include "core/ConfigVar.h"
 #include "core/particles/ParticleSystem.h"
 #include "core/particles/ParticleSystemManager.h"
 
+ConfigVar cv_particle_parallel(
+  "particle_parallel", "Update particle techniques and large particle ranges in parallel", "true"
+);
+
 ParticleSystem::ParticleSystem(const Ogre::String& name): MovableObject(name){}
 
 
@@ -57,22 +61,32 @@ Ogre::Real ParticleSystem::getBoundingRadius() const{
 }
 
 void ParticleSystem::_updateRenderQueue(Ogre::RenderQueue* queue){
-    Ogre::LogManager::getSingletonPtr()->logMessage(
-      "ParticleSystem::UpdateRenderQueue"
-    );
     for(unsigned int i = 0; i < techniques_.size(); ++ i){
         techniques_[i]->UpdateRenderQueue(queue);
     }
 }
 
+void ParticleSystem::_notifyCurrentCamera(Ogre::Camera* camera){
+    MovableObject::_notifyCurrentCamera(camera);
+    for (unsigned int i = 0; i < techniques_.size(); ++ i)
+        techniques_[i]->NotifyCurrentCamera(camera);
+}
+
 void ParticleSystem::Update(Ogre::Real time_elapsed){
-    Ogre::LogManager::getSingletonPtr()->logMessage(
-      "ParticleSystem::Update STARTED. Technique number: "
-      + Ogre::StringConverter::toString(techniques_.size())
-    );
-    for (unsigned int i = 0; i < techniques_.size(); ++ i){
-         techniques_[i]->Update(time_elapsed);
+    // Perform some initialisation type of activities (if needed). This must be done within the
+    // update-loop, because settings could be changed (i.e. changing quota), which must trigger a
+    // re-initialisation. It can create scene nodes, so it's done in this thread.
+    for (unsigned int i = 0; i < techniques_.size(); ++ i) techniques_[i]->Initialize();
+    if (cv_particle_parallel.GetB() == false){
+        for (unsigned int i = 0; i < techniques_.size(); ++ i) techniques_[i]->Update(time_elapsed);
+        return;
     }
+    // Techniques don't share particles, so they can be updated at the same time. Run returns
+    // when all of them are done, before anything is rendered.
+    ParticleWorkerPool* pool = &ParticleSystemManager::getSingleton().GetWorkerPool();
+    pool->Run(techniques_.size(), [this, time_elapsed, pool](size_t t){
+        techniques_[t]->Update(time_elapsed, pool);
+    });
 }
 
 ParticleTechnique*ParticleSystem::CreateTechnique(){
@@ -75,6 +75,15 @@ class ParticleSystem : public Ogre::MovableObject{
          */
         void _updateRenderQueue(Ogre::RenderQueue* queue);
 
+        /**
+         * Notifies the system of the camera it's being rendered with.
+         *
+         * Forwards the camera to the renderers of the techniques.
+         *
+         * @param[in] camera The camera.
+         */
+        void _notifyCurrentCamera(Ogre::Camera* camera);
+
         /**
          * Visits renderables.
          *
@@ -90,7 +99,8 @@ class ParticleSystem : public Ogre::MovableObject{
         /**
          * Updates the system.
          *
-         * Updates the system status based on the elapsed time.
+         * Updates the system status based on the elapsed time. Unless the "particle_parallel"
+         * config variable is disabled, the techniques are updated in the particle worker pool.
          *
          * @param[in] time_elapsed The elapsed time.
          */
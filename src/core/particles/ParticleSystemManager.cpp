@@ -13,11 +13,17 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
 #include <OgreLogManager.h>
 #include <OgreRoot.h>
 #include "core/particles/ParticleSystemManager.h"
+#include "core/particles/emitters/BoxEmitterFactory.h"
+#include "core/particles/emitters/CircleEmitterFactory.h"
+#include "core/particles/emitters/LineEmitterFactory.h"
 #include "core/particles/emitters/PointEmitterFactory.h"
+#include "core/particles/emitters/SphereEmitterFactory.h"
 #include "core/particles/ParticleSystemFactory.h"
+#include "core/particles/renderer/ParticleBillboardRendererFactory.h"
 #include "core/particles/renderer/ParticleEntityRendererFactory.h"
 
 /**
@@ -25,14 +31,21 @@
  */
 template<> ParticleSystemManager* Ogre::Singleton<ParticleSystemManager>::msSingleton = nullptr;
 
-ParticleSystemManager::ParticleSystemManager(){
+ParticleSystemManager::ParticleSystemManager():
+  worker_pool_(std::max(1u, boost::thread::hardware_concurrency()) - 1)
+{
     translator_manager_ = new ParticleSystemTranslatorManager();
     Ogre::ScriptCompilerManager::getSingleton().addTranslatorManager(translator_manager_);
     Ogre::ScriptCompilerManager::getSingleton().addScriptPattern("*.effects");
     particle_system_factory_ = new ParticleSystemFactory();
     Ogre::Root::getSingleton().addMovableObjectFactory(particle_system_factory_);
     AddEmitterFactory(new PointEmitterFactory());
+    AddEmitterFactory(new BoxEmitterFactory());
+    AddEmitterFactory(new SphereEmitterFactory());
+    AddEmitterFactory(new CircleEmitterFactory());
+    AddEmitterFactory(new LineEmitterFactory());
     AddRendererFactory(new ParticleEntityRendererFactory());
+    AddRendererFactory(new ParticleBillboardRendererFactory());
 }
 
 ParticleSystemManager::~ParticleSystemManager(){
@@ -184,6 +197,8 @@ void ParticleSystemManager::DestroyRenderer(ParticleRenderer* renderer){
     it->second->DestroyRenderer(renderer);
 }
 
+ParticleWorkerPool& ParticleSystemManager::GetWorkerPool(){return worker_pool_;}
+
 void ParticleSystemManager::AddEmitterFactory(ParticleEmitterFactory* factory){
     Ogre::String type = factory->GetEmitterType();
     emitter_factories_[type] = factory;
@@ -22,6 +22,7 @@
 #include "ParticleSystem.h"
 #include "ParticleSystemFactory.h"
 #include "ParticleTechnique.h"
+#include "ParticleWorkerPool.h"
 #include "ParticleSystemTranslatorManager.h"
 
 /**
@@ -150,6 +151,13 @@ class ParticleSystemManager: public Ogre::Singleton<ParticleSystemManager>{
          */
         void DestroyRenderer(ParticleRenderer* renderer);
 
+        /**
+         * Retrieves the worker pool particle systems are updated with.
+         *
+         * @return The worker pool.
+         */
+        ParticleWorkerPool& GetWorkerPool();
+
     private:
 
         /**
@@ -201,5 +209,11 @@ class ParticleSystemManager: public Ogre::Singleton<ParticleSystemManager>{
          * List of renderer factories.
          */
         RendererFactoryMap renderer_factories_;
+
+        /**
+         * Worker pool for particle updates. It has a thread less than the hardware supports,
+         * the main thread takes the remaining one.
+         */
+        ParticleWorkerPool worker_pool_;
 };
 
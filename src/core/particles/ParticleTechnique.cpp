@@ -13,12 +13,12 @@
  * GNU General Public License for more details.
  */
 
-#include <OgreLogManager.h>
-#include <OgreStringConverter.h>
+#include <algorithm>
 #include "core/particles/ParticleTechnique.h"
 #include "core/particles/ParticleSystemManager.h"
 #include "core/particles/ParticleVisual.h"
 
+const size_t ParticleTechnique::PARALLEL_PARTICLES = 2048;
 
 ParticleTechnique::ParticleTechnique():
   renderer_(nullptr),
@@ -61,6 +61,10 @@ void ParticleTechnique::UpdateRenderQueue(Ogre::RenderQueue* queue){
 
 }
 
+void ParticleTechnique::NotifyCurrentCamera(Ogre::Camera* camera){
+    if (renderer_) renderer_->NotifyCurrentCamera(camera);
+}
+
 void ParticleTechnique::Initialize(){
     if (renderer_ && renderer_->IsRendererInitialised() == false) renderer_->Initialize();
     // Create new visual particles if the quota has been increased
@@ -108,11 +112,7 @@ void ParticleTechnique::Initialize(){
     }
 }
 
-void ParticleTechnique::Update(Ogre::Real time_elapsed){
-    // Perform some initialisation type of activities (if needed). This must be done within the
-    // update-loop, because settings could be changed (i.e. changing quota), which must trigger a
-    // re-initialisation.
-    Initialize();
+void ParticleTechnique::Update(Ogre::Real time_elapsed, ParticleWorkerPool* pool){
     // Process the emitters.
     for (unsigned int i = 0; i < emitters_.size(); ++ i){
         // Wmitted particles handled in pool update.
@@ -124,19 +124,33 @@ void ParticleTechnique::Update(Ogre::Real time_elapsed){
     }
 
     if (visual_particles_pool_.IsEmpty() == false){
+        // Expire particles here, the pool lists can't be shared. The rest are updated after.
+        living_particles_.clear();
         VisualParticle* particle = visual_particles_pool_.GetFirst();
         while (!visual_particles_pool_.End()){
             if (particle != nullptr){
-                if (particle->time_to_live > time_elapsed) particle->Update(time_elapsed);
+                if (particle->time_to_live > time_elapsed) living_particles_.push_back(particle);
                 else{
                     particle->InitForExpiration();
                     visual_particles_pool_.LockLatestElement();
+                    // Decrement time to live
+                    particle->time_to_live -= time_elapsed;
                 }
-                // Decrement time to live
-                particle->time_to_live -= time_elapsed;
             }
             particle = visual_particles_pool_.GetNext();
         }
+        const size_t count = living_particles_.size();
+        auto update_range = [this, count, time_elapsed](size_t range){
+            const size_t end = std::min(count, (range + 1) * PARALLEL_PARTICLES);
+            for (size_t p = range * PARALLEL_PARTICLES; p < end; ++ p){
+                living_particles_[p]->Update(time_elapsed);
+                // Decrement time to live
+                living_particles_[p]->time_to_live -= time_elapsed;
+            }
+        };
+        const size_t ranges = (count + PARALLEL_PARTICLES - 1) / PARALLEL_PARTICLES;
+        if (pool != nullptr) pool->Run(ranges, update_range);
+        else for (size_t r = 0; r < ranges; ++ r) update_range(r);
     }
     // Process all particles
     if (particle_emitter_pool_.IsEmpty() == false){
@@ -235,10 +249,6 @@ void ParticleTechnique::ExecuteEmitParticles(
 ){
     // Only proceed if the emitter and technique are enabled
     if (emitter->IsEnabled() == false) return;
-    Ogre::LogManager::getSingletonPtr()->logMessage(
-      "ParticleTechnique::ExecuteEmitParticles request "
-      + Ogre::StringConverter::toString(requested) + " particles to emit."
-    );
     for (int j = 0; j < requested; ++ j){
         // Create a new particle & init using emitter
         Particle* particle = nullptr;
@@ -251,12 +261,7 @@ void ParticleTechnique::ExecuteEmitParticles(
                 break;
         }
         // Return if there is no particle left anymore, or the name cannot be found.
-        if (particle == nullptr){
-            Ogre::LogManager::getSingletonPtr()->logMessage(
-              "ParticleTechnique::ExecuteEmitParticles request there are no particles left."
-            );
-            return;
-        }
+        if (particle == nullptr) return;
         particle->InitForEmission();
         // Initialize the particle with data from the emitter.
         emitter->InitParticleForEmission(particle);
@@ -19,6 +19,7 @@
 #include "ParticleRenderer.h"
 #include "ParticlePool.h"
 #include "ParticlePoolMap.h"
+#include "ParticleWorkerPool.h"
 
 class ParticleSystem;
 
@@ -67,6 +68,13 @@ class ParticleTechnique{
          */
         void UpdateRenderQueue(Ogre::RenderQueue* queue);
 
+        /**
+         * Notifies the technique renderer of the camera the system is being rendered with.
+         *
+         * @param[in] camera The camera.
+         */
+        void NotifyCurrentCamera(Ogre::Camera* camera);
+
         /**
          * Initializes the tehnique.
          */
@@ -75,11 +83,14 @@ class ParticleTechnique{
         /**
          * Updates the technique.
          *
-         * Updates the technique status based on the elapsed time.
+         * Updates the technique status based on the elapsed time. The technique must have been
+         * initialized with {@see Initialize}, which can't be done from a worker thread.
          *
          * @param[in] time_elapsed The elapsed time.
+         * @param[in] pool Worker pool to update the visual particles with, in ranges of
+         * {@see PARALLEL_PARTICLES}. If null, they are updated in the calling thread.
          */
-        void Update(Ogre::Real time_elapsed);
+        void Update(Ogre::Real time_elapsed, ParticleWorkerPool* pool = nullptr);
 
         /**
          * Creates a renderer.
@@ -164,6 +175,11 @@ class ParticleTechnique{
 
     private:
 
+        /**
+         * Number of visual particles updated by each job of the worker pool.
+         */
+        static const size_t PARALLEL_PARTICLES;
+
         /**
          * The parent particle system.
          */
@@ -194,6 +210,13 @@ class ParticleTechnique{
          */
         std::vector<VisualParticle*> visual_particles_;
 
+        /**
+         * Visual particles that are still alive in the current update.
+         *
+         * Only used during {@see Update}, kept to avoid allocating it every frame.
+         */
+        std::vector<VisualParticle*> living_particles_;
+
         /**
          * The particle emitter quota.
          */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include "core/particles/ParticleWorkerPool.h"
+
+ParticleWorkerPool::ParticleWorkerPool(const unsigned int workers):
+  job_(nullptr), count_(0), next_(0), pending_(0), batch_(0), stop_(false)
+{
+    for (unsigned int w = 0; w < workers; ++ w)
+        thread_ids_.push_back(threads_.create_thread([this](){Work();})->get_id());
+}
+
+ParticleWorkerPool::~ParticleWorkerPool(){
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_condition_.notify_all();
+    threads_.join_all();
+}
+
+unsigned int ParticleWorkerPool::GetWorkers() const{return thread_ids_.size();}
+
+void ParticleWorkerPool::Run(const size_t count, const Job& job){
+    if (count == 0) return;
+    bool run_here = count == 1 || thread_ids_.empty()
+      || std::find(thread_ids_.begin(), thread_ids_.end(), boost::this_thread::get_id())
+        != thread_ids_.end();
+    if (!run_here){
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        if (job_ != nullptr) run_here = true;
+        else{
+            job_ = &job;
+            count_ = count;
+            next_ = 0;
+            pending_ = count;
+            ++ batch_;
+        }
+    }
+    if (run_here){
+        for (size_t i = 0; i < count; ++ i) job(i);
+        return;
+    }
+    start_condition_.notify_all();
+    RunJobs();
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    while (pending_ > 0) done_condition_.wait(lock);
+    job_ = nullptr;
+}
+
+void ParticleWorkerPool::Work(){
+    unsigned long long last_batch = 0;
+    for (;;){
+        {
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (!stop_ && (job_ == nullptr || batch_ == last_batch))
+                start_condition_.wait(lock);
+            if (stop_) return;
+            last_batch = batch_;
+        }
+        RunJobs();
+    }
+}
+
+void ParticleWorkerPool::RunJobs(){
+    for (;;){
+        const Job* job;
+        size_t index;
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            if (job_ == nullptr || next_ >= count_) return;
+            job = job_;
+            index = next_ ++;
+        }
+        (*job)(index);
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        if (-- pending_ == 0) done_condition_.notify_all();
+    }
+}
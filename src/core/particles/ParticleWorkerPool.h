@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <boost/thread.hpp>
+
+/**
+ * A pool of worker threads for particle updates.
+ *
+ * The pool runs batches of independent jobs, such as the techniques of a system or ranges of
+ * particles in a technique. The calling thread runs jobs too, and {@see Run} only returns when
+ * the whole batch is done, so the particles are never updated while they are being rendered.
+ */
+class ParticleWorkerPool{
+
+    public:
+
+        /**
+         * A job, called with its index in the batch.
+         */
+        typedef std::function<void(size_t)> Job;
+
+        /**
+         * Constructor.
+         *
+         * Starts the worker threads.
+         *
+         * @param[in] workers Number of worker threads, besides the calling thread. With 0, all
+         * jobs are run in the calling thread.
+         */
+        ParticleWorkerPool(const unsigned int workers);
+
+        /**
+         * Destructor.
+         *
+         * Waits for the worker threads to finish.
+         */
+        virtual ~ParticleWorkerPool();
+
+        /**
+         * Retrieves the number of worker threads.
+         *
+         * @return The number of worker threads, not counting the calling thread.
+         */
+        unsigned int GetWorkers() const;
+
+        /**
+         * Runs a batch of jobs and waits for all of them.
+         *
+         * Calls from a worker thread, or while another batch is running, run the jobs in the
+         * calling thread.
+         *
+         * @param[in] count Number of jobs. The job is called once for each index from 0 to
+         * count - 1.
+         * @param[in] job The job to run.
+         */
+        void Run(const size_t count, const Job& job);
+
+    private:
+
+        /**
+         * Worker thread loop.
+         */
+        void Work();
+
+        /**
+         * Runs the jobs of the current batch until there are none left.
+         *
+         * The mutex must not be locked by the caller.
+         */
+        void RunJobs();
+
+        /**
+         * Guards the batch and the state of the workers.
+         */
+        boost::mutex mutex_;
+
+        /**
+         * Signalled when a batch starts or the workers must stop.
+         */
+        boost::condition_variable start_condition_;
+
+        /**
+         * Signalled when the last job of a batch is finished.
+         */
+        boost::condition_variable done_condition_;
+
+        /**
+         * The job of the current batch. Null if there is no batch running.
+         */
+        const Job* job_;
+
+        /**
+         * Number of jobs in the current batch.
+         */
+        size_t count_;
+
+        /**
+         * Index of the next job to run.
+         */
+        size_t next_;
+
+        /**
+         * Number of jobs not finished yet.
+         */
+        size_t pending_;
+
+        /**
+         * Batch counter, so a worker doesn't take the same batch twice.
+         */
+        unsigned long long batch_;
+
+        /**
+         * Indicates if the worker threads must finish.
+         */
+        bool stop_;
+
+        /**
+         * The worker threads.
+         */
+        boost::thread_group threads_;
+
+        /**
+         * IDs of the worker threads.
+         */
+        std::vector<boost::thread::id> thread_ids_;
+};
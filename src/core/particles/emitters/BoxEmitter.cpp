@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include "core/particles/emitters/BoxEmitter.h"
+
+ShapeEmitterDictionary::BoxSize BoxEmitter::size_dictionary_;
+
+BoxEmitter::BoxEmitter(): ParticleEmitter(), half_size_(Ogre::Vector3(0.5f)){
+    emitter_type_ = "Box";
+    if (createParamDictionary("BoxEmitter")){
+        Ogre::ParamDictionary* dict = getParamDictionary();
+        AddBaseParameters(dict);
+        dict->addParameter(Ogre::ParameterDef("size", "", Ogre::PT_VECTOR3), &size_dictionary_);
+    }
+}
+
+void BoxEmitter::CopyAttributesTo(ParticleEmitter* emitter){
+    ParticleEmitter::CopyAttributesTo(emitter);
+    static_cast<BoxEmitter*>(emitter)->half_size_ = half_size_;
+}
+
+void BoxEmitter::InitParticleForEmission(Particle* particle){
+    ParticleEmitter::InitParticleForEmission(particle);
+    particle->position.x += RangeRandom(-half_size_.x, half_size_.x);
+    particle->position.y += RangeRandom(-half_size_.y, half_size_.y);
+    particle->position.z += RangeRandom(-half_size_.z, half_size_.z);
+}
+
+void BoxEmitter::SetSize(const Ogre::Vector3& size){half_size_ = size / 2;}
+
+Ogre::Vector3 BoxEmitter::GetSize() const{return half_size_ * 2;}
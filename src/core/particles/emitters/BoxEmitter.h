@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "../ParticleEmitter.h"
+#include "ShapeEmitterDictionary.h"
+
+/**
+ * An emitter that emits particles from random points inside a box.
+ *
+ * The box is centered on the emitter position and aligned with the axes.
+ */
+class BoxEmitter : public ParticleEmitter{
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        BoxEmitter();
+
+        /**
+         * Destructor.
+         */
+        virtual ~BoxEmitter(){};
+
+        /**
+         * Copies all atributes to a ParticleEmitter.
+         *
+         * @param[out] emitter Emmiter to copy attributes to.
+         */
+        virtual void CopyAttributesTo(ParticleEmitter* emitter);
+
+        /**
+         * Initializes a particle for emission inside the box.
+         *
+         * @param[out] particle The particle to initialize.
+         */
+        virtual void InitParticleForEmission(Particle* particle);
+
+        /**
+         * Sets the size of the box.
+         *
+         * @param[in] size The box width, height and depth.
+         */
+        void SetSize(const Ogre::Vector3& size);
+
+        /**
+         * Retrieves the size of the box.
+         *
+         * @return The box width, height and depth.
+         */
+        Ogre::Vector3 GetSize() const;
+
+    private:
+
+        /**
+         * Dictionary for the box size.
+         */
+        static ShapeEmitterDictionary::BoxSize size_dictionary_;
+
+        /**
+         * Half of the box size.
+         */
+        Ogre::Vector3 half_size_;
+};
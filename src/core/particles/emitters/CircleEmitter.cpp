@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include "core/particles/emitters/CircleEmitter.h"
+
+ShapeEmitterDictionary::CircleRadius CircleEmitter::radius_dictionary_;
+
+ShapeEmitterDictionary::CircleNormal CircleEmitter::normal_dictionary_;
+
+CircleEmitter::CircleEmitter():
+  ParticleEmitter(), radius_(1), orientation_(Ogre::Quaternion::IDENTITY)
+{
+    emitter_type_ = "Circle";
+    if (createParamDictionary("CircleEmitter")){
+        Ogre::ParamDictionary* dict = getParamDictionary();
+        AddBaseParameters(dict);
+        dict->addParameter(Ogre::ParameterDef("radius", "", Ogre::PT_REAL), &radius_dictionary_);
+        dict->addParameter(
+          Ogre::ParameterDef("normal", "", Ogre::PT_VECTOR3), &normal_dictionary_
+        );
+    }
+}
+
+void CircleEmitter::CopyAttributesTo(ParticleEmitter* emitter){
+    ParticleEmitter::CopyAttributesTo(emitter);
+    CircleEmitter* circle_emitter = static_cast<CircleEmitter*>(emitter);
+    circle_emitter->radius_ = radius_;
+    circle_emitter->orientation_ = orientation_;
+}
+
+void CircleEmitter::InitParticleForEmission(Particle* particle){
+    ParticleEmitter::InitParticleForEmission(particle);
+    const Ogre::Real angle = RangeRandom(0, Ogre::Math::TWO_PI);
+    particle->position += orientation_ * Ogre::Vector3(
+      radius_ * Ogre::Math::Cos(angle), 0, radius_ * Ogre::Math::Sin(angle)
+    );
+}
+
+void CircleEmitter::SetRadius(const Ogre::Real radius){radius_ = radius;}
+
+Ogre::Real CircleEmitter::GetRadius() const{return radius_;}
+
+void CircleEmitter::SetNormal(const Ogre::Vector3& normal){
+    orientation_ = Ogre::Vector3::UNIT_Y.getRotationTo(normal.normalisedCopy());
+}
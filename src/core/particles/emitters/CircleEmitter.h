@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "../ParticleEmitter.h"
+#include "ShapeEmitterDictionary.h"
+
+/**
+ * An emitter that emits particles from random points on a circle.
+ *
+ * The circle is centered on the emitter position. By default, it's horizontal (its normal is
+ * the Y axis).
+ */
+class CircleEmitter : public ParticleEmitter{
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        CircleEmitter();
+
+        /**
+         * Destructor.
+         */
+        virtual ~CircleEmitter(){};
+
+        /**
+         * Copies all atributes to a ParticleEmitter.
+         *
+         * @param[out] emitter Emmiter to copy attributes to.
+         */
+        virtual void CopyAttributesTo(ParticleEmitter* emitter);
+
+        /**
+         * Initializes a particle for emission on the circle.
+         *
+         * @param[out] particle The particle to initialize.
+         */
+        virtual void InitParticleForEmission(Particle* particle);
+
+        /**
+         * Sets the radius of the circle.
+         *
+         * @param[in] radius The circle radius.
+         */
+        void SetRadius(const Ogre::Real radius);
+
+        /**
+         * Retrieves the radius of the circle.
+         *
+         * @return The circle radius.
+         */
+        Ogre::Real GetRadius() const;
+
+        /**
+         * Sets the normal of the plane of the circle.
+         *
+         * @param[in] normal The plane normal. It doesn't need to be normalized.
+         */
+        void SetNormal(const Ogre::Vector3& normal);
+
+    private:
+
+        /**
+         * Dictionary for the circle radius.
+         */
+        static ShapeEmitterDictionary::CircleRadius radius_dictionary_;
+
+        /**
+         * Dictionary for the circle normal.
+         */
+        static ShapeEmitterDictionary::CircleNormal normal_dictionary_;
+
+        /**
+         * The circle radius.
+         */
+        Ogre::Real radius_;
+
+        /**
+         * Rotation from the XZ plane to the plane of the circle.
+         *
+         * Computed when the normal is set, so emission only rotates a vector.
+         */
+        Ogre::Quaternion orientation_;
+};
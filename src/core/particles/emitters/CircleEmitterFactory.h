@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "core/particles/ParticleEmitterFactory.h"
+#include "CircleEmitter.h"
+
+/**
+ * A circle emitter factory.
+ */
+class CircleEmitterFactory : public ParticleEmitterFactory{
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        CircleEmitterFactory();
+
+        /**
+         * Destructor.
+         */
+        virtual ~CircleEmitterFactory();
+
+        /**
+         * Retrieves the emitter type.
+         *
+         * @return The emitter type (always "Circle").
+         */
+        Ogre::String GetEmitterType() const;
+
+        /**
+         * Creates an emitter.
+         *
+         * @return A new {@see CircleEmitter}.
+         */
+        ParticleEmitter* CreateEmitter();
+};
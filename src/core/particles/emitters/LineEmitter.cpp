@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include "core/particles/emitters/LineEmitter.h"
+
+ShapeEmitterDictionary::LineEnd LineEmitter::end_dictionary_;
+
+LineEmitter::LineEmitter(): ParticleEmitter(), end_(Ogre::Vector3::UNIT_X){
+    emitter_type_ = "Line";
+    if (createParamDictionary("LineEmitter")){
+        Ogre::ParamDictionary* dict = getParamDictionary();
+        AddBaseParameters(dict);
+        dict->addParameter(Ogre::ParameterDef("end", "", Ogre::PT_VECTOR3), &end_dictionary_);
+    }
+}
+
+void LineEmitter::CopyAttributesTo(ParticleEmitter* emitter){
+    ParticleEmitter::CopyAttributesTo(emitter);
+    static_cast<LineEmitter*>(emitter)->end_ = end_;
+}
+
+void LineEmitter::InitParticleForEmission(Particle* particle){
+    ParticleEmitter::InitParticleForEmission(particle);
+    particle->position += end_ * UnitRandom();
+}
+
+void LineEmitter::SetEnd(const Ogre::Vector3& end){end_ = end;}
+
+const Ogre::Vector3& LineEmitter::GetEnd() const{return end_;}
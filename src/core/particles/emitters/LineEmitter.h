@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "../ParticleEmitter.h"
+#include "ShapeEmitterDictionary.h"
+
+/**
+ * An emitter that emits particles from random points on a line.
+ *
+ * The line goes from the emitter position to the end point, relative to it.
+ */
+class LineEmitter : public ParticleEmitter{
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        LineEmitter();
+
+        /**
+         * Destructor.
+         */
+        virtual ~LineEmitter(){};
+
+        /**
+         * Copies all atributes to a ParticleEmitter.
+         *
+         * @param[out] emitter Emmiter to copy attributes to.
+         */
+        virtual void CopyAttributesTo(ParticleEmitter* emitter);
+
+        /**
+         * Initializes a particle for emission on the line.
+         *
+         * @param[out] particle The particle to initialize.
+         */
+        virtual void InitParticleForEmission(Particle* particle);
+
+        /**
+         * Sets the end of the line.
+         *
+         * @param[in] end The line end, relative to the emitter position.
+         */
+        void SetEnd(const Ogre::Vector3& end);
+
+        /**
+         * Retrieves the end of the line.
+         *
+         * @return The line end, relative to the emitter position.
+         */
+        const Ogre::Vector3& GetEnd() const;
+
+    private:
+
+        /**
+         * Dictionary for the line end.
+         */
+        static ShapeEmitterDictionary::LineEnd end_dictionary_;
+
+        /**
+         * The line end, relative to the emitter position.
+         */
+        Ogre::Vector3 end_;
+};
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <OgreStringConverter.h>
+#include "core/particles/emitters/ShapeEmitterDictionary.h"
+#include "core/particles/emitters/BoxEmitter.h"
+#include "core/particles/emitters/CircleEmitter.h"
+#include "core/particles/emitters/LineEmitter.h"
+#include "core/particles/emitters/SphereEmitter.h"
+
+namespace ShapeEmitterDictionary{
+
+    void BoxSize::doSet(void* target, const Ogre::String& val){
+        static_cast<BoxEmitter*>(target)->SetSize(Ogre::StringConverter::parseVector3(val));
+    }
+
+    void SphereRadius::doSet(void* target, const Ogre::String& val){
+        static_cast<SphereEmitter*>(target)->SetRadius(Ogre::StringConverter::parseReal(val));
+    }
+
+    void CircleRadius::doSet(void* target, const Ogre::String& val){
+        static_cast<CircleEmitter*>(target)->SetRadius(Ogre::StringConverter::parseReal(val));
+    }
+
+    void CircleNormal::doSet(void* target, const Ogre::String& val){
+        static_cast<CircleEmitter*>(target)->SetNormal(Ogre::StringConverter::parseVector3(val));
+    }
+
+    void LineEnd::doSet(void* target, const Ogre::String& val){
+        static_cast<LineEmitter*>(target)->SetEnd(Ogre::StringConverter::parseVector3(val));
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <OgreStringInterface.h>
+
+/**
+ * Parameter commands for the emitters with a shape: {@see BoxEmitter}, {@see SphereEmitter},
+ * {@see CircleEmitter} and {@see LineEmitter}.
+ */
+namespace ShapeEmitterDictionary{
+
+    /**
+     * The size of a box emitter.
+     */
+    class BoxSize : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the size.
+             *
+             * @return The size.
+             */
+            Ogre::String doGet(const void* target) const{return "";};
+
+            /**
+             * Sets the size.
+             *
+             * @param[in] target The target.
+             * @param[in] val The box width, height and depth.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+
+    /**
+     * The radius of a sphere emitter.
+     */
+    class SphereRadius : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the radius.
+             *
+             * @return The radius.
+             */
+            Ogre::String doGet(const void* target) const{return "";};
+
+            /**
+             * Sets the radius.
+             *
+             * @param[in] target The target.
+             * @param[in] val The sphere radius.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+
+    /**
+     * The radius of a circle emitter.
+     */
+    class CircleRadius : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the radius.
+             *
+             * @return The radius.
+             */
+            Ogre::String doGet(const void* target) const{return "";};
+
+            /**
+             * Sets the radius.
+             *
+             * @param[in] target The target.
+             * @param[in] val The circle radius.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+
+    /**
+     * The normal of the plane of a circle emitter.
+     */
+    class CircleNormal : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the normal.
+             *
+             * @return The normal.
+             */
+            Ogre::String doGet(const void* target) const{return "";};
+
+            /**
+             * Sets the normal.
+             *
+             * @param[in] target The target.
+             * @param[in] val The plane normal.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+
+    /**
+     * The end of a line emitter, relative to the emitter position.
+     */
+    class LineEnd : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the end.
+             *
+             * @return The end.
+             */
+            Ogre::String doGet(const void* target) const{return "";};
+
+            /**
+             * Sets the end.
+             *
+             * @param[in] target The target.
+             * @param[in] val The line end.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include "core/particles/emitters/SphereEmitter.h"
+
+ShapeEmitterDictionary::SphereRadius SphereEmitter::radius_dictionary_;
+
+SphereEmitter::SphereEmitter(): ParticleEmitter(), radius_(1){
+    emitter_type_ = "Sphere";
+    if (createParamDictionary("SphereEmitter")){
+        Ogre::ParamDictionary* dict = getParamDictionary();
+        AddBaseParameters(dict);
+        dict->addParameter(Ogre::ParameterDef("radius", "", Ogre::PT_REAL), &radius_dictionary_);
+    }
+}
+
+void SphereEmitter::CopyAttributesTo(ParticleEmitter* emitter){
+    ParticleEmitter::CopyAttributesTo(emitter);
+    static_cast<SphereEmitter*>(emitter)->radius_ = radius_;
+}
+
+void SphereEmitter::InitParticleForEmission(Particle* particle){
+    ParticleEmitter::InitParticleForEmission(particle);
+    // A uniform height and angle give a uniform point on the surface, without rejection.
+    const Ogre::Real z = RangeRandom(-1, 1);
+    const Ogre::Real angle = RangeRandom(0, Ogre::Math::TWO_PI);
+    const Ogre::Real ring = radius_ * Ogre::Math::Sqrt(1 - z * z);
+    particle->position.x += ring * Ogre::Math::Cos(angle);
+    particle->position.y += ring * Ogre::Math::Sin(angle);
+    particle->position.z += radius_ * z;
+}
+
+void SphereEmitter::SetRadius(const Ogre::Real radius){radius_ = radius;}
+
+Ogre::Real SphereEmitter::GetRadius() const{return radius_;}
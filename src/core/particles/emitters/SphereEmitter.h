@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "../ParticleEmitter.h"
+#include "ShapeEmitterDictionary.h"
+
+/**
+ * An emitter that emits particles from random points on the surface of a sphere.
+ *
+ * The sphere is centered on the emitter position. Points are uniformly distributed.
+ */
+class SphereEmitter : public ParticleEmitter{
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        SphereEmitter();
+
+        /**
+         * Destructor.
+         */
+        virtual ~SphereEmitter(){};
+
+        /**
+         * Copies all atributes to a ParticleEmitter.
+         *
+         * @param[out] emitter Emmiter to copy attributes to.
+         */
+        virtual void CopyAttributesTo(ParticleEmitter* emitter);
+
+        /**
+         * Initializes a particle for emission on the sphere.
+         *
+         * @param[out] particle The particle to initialize.
+         */
+        virtual void InitParticleForEmission(Particle* particle);
+
+        /**
+         * Sets the radius of the sphere.
+         *
+         * @param[in] radius The sphere radius.
+         */
+        void SetRadius(const Ogre::Real radius);
+
+        /**
+         * Retrieves the radius of the sphere.
+         *
+         * @return The sphere radius.
+         */
+        Ogre::Real GetRadius() const;
+
+    private:
+
+        /**
+         * Dictionary for the sphere radius.
+         */
+        static ShapeEmitterDictionary::SphereRadius radius_dictionary_;
+
+        /**
+         * The sphere radius.
+         */
+        Ogre::Real radius_;
+};
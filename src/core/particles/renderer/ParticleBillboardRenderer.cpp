@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <OgreSceneNode.h>
+#include "core/particles/renderer/ParticleBillboardRenderer.h"
+#include "core/particles/ParticleSystem.h"
+#include "core/particles/ParticleTechnique.h"
+#include "core/particles/ParticleVisual.h"
+
+ParticleBillboardRendererDictionary::MaterialName
+  ParticleBillboardRenderer::material_name_dictionary_;
+
+ParticleBillboardRendererDictionary::DefaultWidth
+  ParticleBillboardRenderer::default_width_dictionary_;
+
+ParticleBillboardRendererDictionary::DefaultHeight
+  ParticleBillboardRenderer::default_height_dictionary_;
+
+ParticleBillboardRenderer::ParticleBillboardRenderer():
+    ParticleRenderer(),
+    billboard_set_(nullptr),
+    visible_(true),
+    material_name_(Ogre::BLANKSTRING),
+    default_width_(1),
+    default_height_(1)
+{
+    renderer_type_ = "Billboard";
+    if (createParamDictionary("ParticleBillboardRenderer")){
+        Ogre::ParamDictionary* dict = getParamDictionary();
+        dict->addParameter(
+          Ogre::ParameterDef("material_name", "", Ogre::PT_STRING), &material_name_dictionary_
+        );
+        dict->addParameter(
+          Ogre::ParameterDef("default_width", "", Ogre::PT_REAL), &default_width_dictionary_
+        );
+        dict->addParameter(
+          Ogre::ParameterDef("default_height", "", Ogre::PT_REAL), &default_height_dictionary_
+        );
+    }
+}
+
+ParticleBillboardRenderer::~ParticleBillboardRenderer(){
+    if (billboard_set_ != nullptr) OGRE_DELETE billboard_set_;
+}
+
+void ParticleBillboardRenderer::CopyAttributesTo(ParticleRenderer* renderer){
+    ParticleRenderer::CopyAttributesTo(renderer);
+    ParticleBillboardRenderer* billboard_renderer =
+      static_cast<ParticleBillboardRenderer*>(renderer);
+    billboard_renderer->material_name_ = material_name_;
+    billboard_renderer->default_width_ = default_width_;
+    billboard_renderer->default_height_ = default_height_;
+}
+
+const Ogre::String& ParticleBillboardRenderer::GetMaterialName() const{return material_name_;}
+
+void ParticleBillboardRenderer::SetMaterialName(const Ogre::String& material_name){
+    material_name_ = material_name;
+    if (billboard_set_ != nullptr && material_name_ != Ogre::BLANKSTRING)
+        billboard_set_->setMaterialName(material_name_);
+}
+
+Ogre::Real ParticleBillboardRenderer::GetDefaultWidth() const{return default_width_;}
+
+void ParticleBillboardRenderer::SetDefaultWidth(const Ogre::Real width){
+    default_width_ = width;
+    if (billboard_set_ != nullptr)
+        billboard_set_->setDefaultDimensions(default_width_, default_height_);
+}
+
+Ogre::Real ParticleBillboardRenderer::GetDefaultHeight() const{return default_height_;}
+
+void ParticleBillboardRenderer::SetDefaultHeight(const Ogre::Real height){
+    default_height_ = height;
+    if (billboard_set_ != nullptr)
+        billboard_set_->setDefaultDimensions(default_width_, default_height_);
+}
+
+void ParticleBillboardRenderer::SetVisible(bool visible){visible_ = visible;}
+
+void ParticleBillboardRenderer::Initialize(){
+    if (!parent_technique_ || renderer_initialized_) return;
+    const int quota = parent_technique_->GetVisualParticlesQuota();
+    if (billboard_set_ == nullptr){
+        // Not created through the scene manager: with external data, the set doesn't keep a
+        // billboard pool of its own, and it's only rendered when the technique is.
+        billboard_set_ = OGRE_NEW Ogre::BillboardSet(Ogre::BLANKSTRING, quota, true);
+        billboard_set_->setBounds(Ogre::AxisAlignedBox::BOX_INFINITE, 999);
+    }
+    else billboard_set_->setPoolSize(quota);
+    billboard_set_->setDefaultDimensions(default_width_, default_height_);
+    if (material_name_ != Ogre::BLANKSTRING) billboard_set_->setMaterialName(material_name_);
+    ParticleSystem* system = parent_technique_->GetParentSystem();
+    billboard_set_->_notifyAttached(system->getParentNode());
+    billboard_set_->setRenderQueueGroup(system->getRenderQueueGroup());
+    renderer_initialized_ = true;
+}
+
+void ParticleBillboardRenderer::NotifyCurrentCamera(Ogre::Camera* camera){
+    if (billboard_set_ != nullptr) billboard_set_->_notifyCurrentCamera(camera);
+}
+
+void ParticleBillboardRenderer::UpdateRenderQueue(
+  Ogre::RenderQueue* queue, ParticlePool<VisualParticle>& pool
+){
+    if (billboard_set_ == nullptr || !visible_ || pool.IsEmpty()) return;
+
+    // The system can be attached after the renderer is initialized.
+    ParticleSystem* system = parent_technique_->GetParentSystem();
+    if (billboard_set_->getParentNode() != system->getParentNode())
+        billboard_set_->_notifyAttached(system->getParentNode());
+
+    // Write all the live particles to the vertex buffer, locked only once.
+    billboard_set_->beginBillboards(pool.GetSize());
+    Ogre::Billboard billboard;
+    VisualParticle* particle = pool.GetFirst();
+    while (!pool.End()){
+        if (particle){
+            billboard.mPosition = particle->position;
+            billboard_set_->injectBillboard(billboard);
+        }
+        particle = pool.GetNext();
+    }
+    billboard_set_->endBillboards();
+    billboard_set_->_updateRenderQueue(queue);
+}
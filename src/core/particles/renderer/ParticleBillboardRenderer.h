@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <OgreBillboardSet.h>
+#include "ParticleBillboardRendererDictionary.h"
+#include "../ParticleRenderer.h"
+
+/**
+ * A particle billboard renderer.
+ *
+ * Draws every live particle of the technique as a camera facing quad. All the quads are written
+ * to a single dynamic vertex buffer each frame and drawn with one draw call, instead of using a
+ * scene node and an entity for each particle like {@see ParticleEntityRenderer} does.
+ */
+class ParticleBillboardRenderer : public ParticleRenderer{
+
+    public:
+
+        /**
+         * Constructor.
+         */
+        ParticleBillboardRenderer();
+
+        /**
+         * Destructor.
+         */
+        virtual ~ParticleBillboardRenderer();
+
+        /**
+         * Copies the atributtes to other renderer.
+         *
+         * @param[out] renderer Renderer to copy the attributes to.
+         */
+        virtual void CopyAttributesTo(ParticleRenderer* renderer);
+
+        /**
+         * Retrieves the particles material name.
+         *
+         * @return The material name.
+         */
+        const Ogre::String& GetMaterialName() const;
+
+        /**
+         * Sets the particles material name.
+         *
+         * @param[in] material_name The name of the material for the particles.
+         */
+        void SetMaterialName(const Ogre::String& material_name);
+
+        /**
+         * Retrieves the width of the particles.
+         *
+         * @return The particle width.
+         */
+        Ogre::Real GetDefaultWidth() const;
+
+        /**
+         * Sets the width of the particles.
+         *
+         * @param[in] width The particle width.
+         */
+        void SetDefaultWidth(const Ogre::Real width);
+
+        /**
+         * Retrieves the height of the particles.
+         *
+         * @return The particle height.
+         */
+        Ogre::Real GetDefaultHeight() const;
+
+        /**
+         * Sets the height of the particles.
+         *
+         * @param[in] height The particle height.
+         */
+        void SetDefaultHeight(const Ogre::Real height);
+
+        /**
+         * Toggles the particles visibility.
+         *
+         * @param[in] visible True to make the particles visible, false to make
+         * them invisible.
+         */
+        virtual void SetVisible(bool visible);
+
+        /**
+         * Initializes the renderer.
+         */
+        virtual void Initialize();
+
+        /**
+         * Notifies the renderer of the camera the particles are being rendered with.
+         *
+         * @param[in] camera The camera.
+         */
+        virtual void NotifyCurrentCamera(Ogre::Camera* camera);
+
+        /**
+         * Writes the live particles to the billboard buffer and adds it to the render queue.
+         *
+         * @param[in,out] queue The queue to add the billboards to.
+         * @param[in] pool The particle pool.
+         */
+        virtual void UpdateRenderQueue(
+          Ogre::RenderQueue* queue, ParticlePool<VisualParticle>& pool
+        );
+
+    private:
+
+        /**
+         * Billboard set holding the quad buffer.
+         *
+         * It uses external data, so the particles are injected into it every frame. It's not
+         * attached to any scene node, it's added to the queue by the renderer.
+         */
+        Ogre::BillboardSet* billboard_set_;
+
+        /**
+         * Indicates if the particles are visible.
+         */
+        bool visible_;
+
+        /**
+         * The material name for the particles.
+         */
+        Ogre::String material_name_;
+
+        /**
+         * The particle width.
+         */
+        Ogre::Real default_width_;
+
+        /**
+         * The particle height.
+         */
+        Ogre::Real default_height_;
+
+        /**
+         * Dictionary command for the material name.
+         */
+        static ParticleBillboardRendererDictionary::MaterialName material_name_dictionary_;
+
+        /**
+         * Dictionary command for the particle width.
+         */
+        static ParticleBillboardRendererDictionary::DefaultWidth default_width_dictionary_;
+
+        /**
+         * Dictionary command for the particle height.
+         */
+        static ParticleBillboardRendererDictionary::DefaultHeight default_height_dictionary_;
+};
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <OgreStringConverter.h>
+#include "core/particles/renderer/ParticleBillboardRendererDictionary.h"
+#include "core/particles/renderer/ParticleBillboardRenderer.h"
+
+namespace ParticleBillboardRendererDictionary{
+
+    Ogre::String MaterialName::doGet(const void* target) const{
+        return static_cast<const ParticleBillboardRenderer*>(target)->GetMaterialName();
+    }
+
+    void MaterialName::doSet(void* target, const Ogre::String& val){
+        static_cast<ParticleBillboardRenderer*>(target)->SetMaterialName(val);
+    }
+
+    Ogre::String DefaultWidth::doGet(const void* target) const{
+        return Ogre::StringConverter::toString(
+          static_cast<const ParticleBillboardRenderer*>(target)->GetDefaultWidth()
+        );
+    }
+
+    void DefaultWidth::doSet(void* target, const Ogre::String& val){
+        static_cast<ParticleBillboardRenderer*>(target)->SetDefaultWidth(
+          Ogre::StringConverter::parseReal(val)
+        );
+    }
+
+    Ogre::String DefaultHeight::doGet(const void* target) const{
+        return Ogre::StringConverter::toString(
+          static_cast<const ParticleBillboardRenderer*>(target)->GetDefaultHeight()
+        );
+    }
+
+    void DefaultHeight::doSet(void* target, const Ogre::String& val){
+        static_cast<ParticleBillboardRenderer*>(target)->SetDefaultHeight(
+          Ogre::StringConverter::parseReal(val)
+        );
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <OgreStringInterface.h>
+
+/**
+ * Parameter commands for {@see ParticleBillboardRenderer}.
+ */
+namespace ParticleBillboardRendererDictionary{
+
+    /**
+     * The "material_name" parameter.
+     */
+    class MaterialName : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the material name.
+             *
+             * @param[in] target The renderer.
+             * @return The material name.
+             */
+            Ogre::String doGet(const void* target) const;
+
+            /**
+             * Sets the material name.
+             *
+             * @param[in,out] target The renderer.
+             * @param[in] val The material name.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+
+    /**
+     * The "default_width" parameter.
+     */
+    class DefaultWidth : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the particle width.
+             *
+             * @param[in] target The renderer.
+             * @return The particle width.
+             */
+            Ogre::String doGet(const void* target) const;
+
+            /**
+             * Sets the particle width.
+             *
+             * @param[in,out] target The renderer.
+             * @param[in] val The particle width.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+
+    /**
+     * The "default_height" parameter.
+     */
+    class DefaultHeight : public Ogre::ParamCommand{
+
+        public:
+
+            /**
+             * Retrieves the particle height.
+             *
+             * @param[in] target The renderer.
+             * @return The particle height.
+             */
+            Ogre::String doGet(const void* target) const;
+
+            /**
+             * Sets the particle height.
+             *
+             * @param[in,out] target The renderer.
+             * @param[in] val The particle height.
+             */
+            void doSet(void* target, const Ogre::String& val);
+    };
+}
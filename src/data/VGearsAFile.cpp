@@ -14,6 +14,8 @@
  */
 
 
+#include <algorithm>
+#include <cmath>
 #include <OgreBone.h>
 #include <OgreLogManager.h>
 #include <OgreKeyFrame.h>
@@ -23,22 +25,132 @@
 
 namespace VGears{
 
-   const Ogre::Real AFile::FRAME_DURATION(1.0f / 30.0f);
+    const Ogre::Real AFile::FRAME_DURATION(1.0f / 30.0f);
 
-   const String AFile::RESOURCE_TYPE("VGearsAFile");
+    const String AFile::RESOURCE_TYPE("VGearsAFile");
 
-   AFile::AFile(
+    /**
+     * Quantized values in a full turn.
+     */
+    static const Ogre::Real QUANTIZED_TURN(65536.0f);
+
+    /**
+     * Retrieves the value of a track in a frame.
+     *
+     * @param[in] track The track. If it only has one value, it's used for every frame.
+     * @param[in] frame The frame index.
+     * @return The value for the frame.
+     */
+    template<typename Track> static const typename Track::value_type& Sample(
+      const Track &track, const size_t frame
+    ){
+        return track.size() == 1 ? track[0] : track[frame];
+    }
+
+    /**
+     * Drops all but the first value of a track, if all of them are equal.
+     *
+     * @param[in,out] track The track.
+     */
+    template<typename Track> static void DropConstant(Track &track){
+        for (size_t i(1); i < track.size(); ++ i)
+            if (!(track[i] == track[0])) return;
+        if (track.size() > 1) track.resize(1);
+        track.shrink_to_fit();
+    }
+
+    /**
+     * Quantizes an angle.
+     *
+     * @param[in] degrees The angle, in degrees.
+     * @return The angle, as a fraction of a full turn.
+     */
+    static uint16 QuantizeAngle(const Ogre::Real degrees){
+        Ogre::Real turns(degrees / 360.0f);
+        turns -= std::floor(turns);
+        return static_cast<uint16>(std::lround(turns * QUANTIZED_TURN) & 0xFFFF);
+    }
+
+    /**
+     * Converts a quantized angle back to degrees.
+     *
+     * @param[in] angle The quantized angle.
+     * @return The angle.
+     */
+    static Ogre::Degree DequantizeAngle(const uint16 angle){
+        return Ogre::Degree(angle * 360.0f / QUANTIZED_TURN);
+    }
+
+    AFile::AFile(
      Ogre::ResourceManager *creator, const String &name,
      Ogre::ResourceHandle handle, const String &group,
      bool is_manual, Ogre::ManualResourceLoader *loader
    ) :
-     Resource(creator, name, handle, group, is_manual, loader), bone_count_(0)
+     Resource(creator, name, handle, group, is_manual, loader), bone_count_(0), frame_count_(0)
    {}
 
     AFile::~AFile(){unload();}
 
     void AFile::SetBoneCount(const uint32 bone_count){bone_count_ = bone_count;}
 
+    uint32 AFile::GetBoneCount() const{return bone_count_;}
+
+    uint32 AFile::GetFrameCount() const{return frame_count_;}
+
+    void AFile::SetFrames(const FrameList &frames){
+        frame_count_ = static_cast<uint32>(frames.size());
+        root_translation_.clear();
+        root_rotation_.clear();
+        bone_rotations_.assign(bone_count_, RotationTrack());
+        root_translation_.reserve(frames.size());
+        root_rotation_.reserve(frames.size());
+        for (RotationTrack& track : bone_rotations_) track.reserve(frames.size());
+        for (const Frame& frame : frames){
+            root_translation_.push_back(frame.root_translation);
+            root_rotation_.push_back(Quantize(frame.root_rotation));
+            for (uint32 i(0); i < bone_count_; ++ i)
+                bone_rotations_[i].push_back(Quantize(frame.bone_rotations[i]));
+        }
+        DropConstant(root_translation_);
+        DropConstant(root_rotation_);
+        for (RotationTrack& track : bone_rotations_) DropConstant(track);
+    }
+
+    const Ogre::Vector3& AFile::GetRootTranslation(const size_t frame) const{
+        return Sample(root_translation_, frame);
+    }
+
+    Ogre::Quaternion AFile::GetRootRotation(const size_t frame) const{
+        return ToQuaternion(Sample(root_rotation_, frame));
+    }
+
+    Ogre::Quaternion AFile::GetBoneRotation(const uint32 bone, const size_t frame) const{
+        return ToQuaternion(Sample(bone_rotations_[bone], frame));
+    }
+
+    bool AFile::IsBoneAnimated(const uint32 bone) const{
+        return bone_rotations_[bone].size() > 1;
+    }
+
+    AFile::QuantizedRotation AFile::Quantize(const Ogre::Vector3 &rotation){
+        QuantizedRotation quantized;
+        quantized.x = QuantizeAngle(rotation.x);
+        quantized.y = QuantizeAngle(rotation.y);
+        quantized.z = QuantizeAngle(rotation.z);
+        return quantized;
+    }
+
+    Ogre::Quaternion AFile::ToQuaternion(const QuantizedRotation &rotation){
+        Ogre::Quaternion rot;
+        Ogre::Matrix3 mat;
+        mat.FromEulerAnglesZXY(
+          Ogre::Radian(-DequantizeAngle(rotation.y)), Ogre::Radian(-DequantizeAngle(rotation.x)),
+          Ogre::Radian(-DequantizeAngle(rotation.z))
+        );
+        rot.FromRotationMatrix(mat);
+        return rot;
+    }
+
     void AFile::loadImpl(){
         AFileSerializer serializer;
         Ogre::DataStreamPtr stream(openResource());
@@ -47,55 +159,35 @@ namespace VGears{
 
     void AFile::unloadImpl(){
         bone_count_ = 0;
-        frames_.clear();
+        frame_count_ = 0;
+        root_translation_.clear();
+        root_rotation_.clear();
+        bone_rotations_.clear();
     }
 
     size_t AFile::CalculateSize() const{
-        size_t size(0);
-        FrameList::const_iterator it(frames_.begin()), it_end(frames_.end());
-        while( it != it_end){
-            size += sizeof(it->root_rotation);
-            size += sizeof(it->root_translation);
-            size
-              += sizeof(BoneRotationList::value_type)
-                * it->bone_rotations.size();
-            ++ it;
-        }
+        size_t size(sizeof(TranslationTrack::value_type) * root_translation_.size());
+        size += sizeof(RotationTrack::value_type) * root_rotation_.size();
+        for (const RotationTrack& track : bone_rotations_)
+            size += sizeof(RotationTrack::value_type) * track.size();
         return size;
     }
 
-    void AFile::SetFrameRotation(
-      Ogre::TransformKeyFrame* key_frame, const Ogre::Vector3& v
-    ) const{
-        Ogre::Quaternion rot;
-        Ogre::Matrix3 mat;
-        mat.FromEulerAnglesZXY(
-          Ogre::Radian(Ogre::Degree(-v.y)), Ogre::Radian(Ogre::Degree(-v.x)),
-          Ogre::Radian(Ogre::Degree(-v.z))
-        );
-        rot.FromRotationMatrix(mat);
-        key_frame->setRotation(rot);
-    }
-
     void AFile::AddTo(Ogre::SkeletonPtr skeleton, const String& name) const{
         if(skeleton->hasAnimation(name)) return;
-        Ogre::Real length((frames_.size() - 1) * FRAME_DURATION);
+        Ogre::Real length((frame_count_ - 1) * FRAME_DURATION);
         Ogre::Animation *anim(skeleton->createAnimation(name, length));
         uint16 track_handle(0);
         Ogre::Bone* bone(skeleton->getBone("root"));
         Ogre::NodeAnimationTrack* track;
         track = anim->createNodeTrack(track_handle++, bone);
-        Ogre::Real time;
-        size_t index(0);
-        for(
-          FrameList::const_iterator frame(frames_.begin());
-          frame != frames_.end();
-          ++ frame
-        ){
-            time = (index++) * FRAME_DURATION;
-            Ogre::TransformKeyFrame* key_frame(track->createNodeKeyFrame(time));
-            key_frame->setTranslate(frame->root_translation);
-            SetFrameRotation(key_frame, frame->root_rotation);
+        const size_t root_frames(std::max(root_translation_.size(), root_rotation_.size()));
+        for (size_t frame(0); frame < root_frames; ++ frame){
+            Ogre::TransformKeyFrame* key_frame(
+              track->createNodeKeyFrame(frame * FRAME_DURATION)
+            );
+            key_frame->setTranslate(GetRootTranslation(frame));
+            key_frame->setRotation(GetRootRotation(frame));
         }
         for(uint32 i(0); i < bone_count_; ++ i){
             if (i + 1 >= skeleton->getNumBones()){
@@ -109,18 +201,11 @@ namespace VGears{
             else{
                 bone = skeleton->getBone(i + 1);
                 track = anim->createNodeTrack(track_handle ++, bone);
-                time = 0;
-                for (
-                  FrameList::const_iterator frame(frames_.begin());
-                  frame != frames_.end();
-                  ++ frame
-                ){
-                    const Ogre::Vector3& rot(frame->bone_rotations[i]);
+                for (size_t frame(0); frame < bone_rotations_[i].size(); ++ frame){
                     Ogre::TransformKeyFrame* key_frame(
-                      track->createNodeKeyFrame(time)
+                      track->createNodeKeyFrame(frame * FRAME_DURATION)
                     );
-                    SetFrameRotation(key_frame, rot);
-                    time += FRAME_DURATION;
+                    key_frame->setRotation(GetBoneRotation(i, frame));
                 }
             }
         }
@@ -72,6 +72,8 @@ namespace VGears{
             /**
              * Adds an animation to an skeleton.
              *
+             * Tracks that don't change during the animation get a single key frame.
+             *
              * @param[in,out] skeleton Skeleton to add the animation to.
              * @param[in] name Animation name.
              */
@@ -80,7 +82,7 @@ namespace VGears{
             typedef std::vector<Ogre::Vector3> BoneRotationList;
 
             /**
-             * A frame in an animation.
+             * A frame in an animation, as stored in the file.
              */
             struct Frame{
 
@@ -103,11 +105,59 @@ namespace VGears{
             typedef std::vector<Frame> FrameList;
 
             /**
-             * Retrieves the list of frames in the file.
+             * A rotation, as Euler angles quantized to 16 bits.
+             *
+             * Each angle is stored as a fraction of a full turn, so the precision is 360 / 65536
+             * degrees.
+             */
+            struct QuantizedRotation{
+
+                /**
+                 * Rotation around the X axis.
+                 */
+                uint16 x;
+
+                /**
+                 * Rotation around the Y axis.
+                 */
+                uint16 y;
+
+                /**
+                 * Rotation around the Z axis.
+                 */
+                uint16 z;
+
+                /**
+                 * Compares two rotations.
+                 *
+                 * @param[in] other The rotation to compare to.
+                 * @return True if both rotations are equal, false otherwise.
+                 */
+                bool operator==(const QuantizedRotation &other) const{
+                    return x == other.x && y == other.y && z == other.z;
+                }
+            };
+
+            /**
+             * A rotation for each frame, or a single rotation if it's the same in all of them.
+             */
+            typedef std::vector<QuantizedRotation> RotationTrack;
+
+            /**
+             * A translation for each frame, or a single one if it's the same in all of them.
+             */
+            typedef std::vector<Ogre::Vector3> TranslationTrack;
+
+            /**
+             * Sets the frames of the animation.
+             *
+             * The frames are not kept. Rotations are quantized, and stored by bone instead of by
+             * frame. Bones that don't move during the animation only keep one rotation.
+             * {@see SetBoneCount} must be called first.
              *
-             * @return The list of frames.
+             * @param[in] frames The frames, as stored in the file.
              */
-            FrameList& GetFrames(){return frames_;}
+            void SetFrames(const FrameList &frames);
 
             /**
              * Sets the number of bones.
@@ -116,36 +166,88 @@ namespace VGears{
              */
             void SetBoneCount(const uint32 bone_count);
 
-        protected:
+            /**
+             * Retrieves the number of bones.
+             *
+             * @return The number of bones.
+             */
+            uint32 GetBoneCount() const;
 
             /**
-             * Loads the file.
+             * Retrieves the number of frames.
+             *
+             * @return The number of frames.
              */
-            virtual void loadImpl() override final;
+            uint32 GetFrameCount() const;
 
             /**
-             * Unloads the file.
+             * Retrieves the translation of the whole skeleton in a frame.
+             *
+             * @param[in] frame The frame index. Must be lower than {@see GetFrameCount}.
+             * @return The translation.
              */
-            virtual void unloadImpl() override final;
+            const Ogre::Vector3& GetRootTranslation(const size_t frame) const;
+
+            /**
+             * Retrieves the rotation of the whole skeleton in a frame.
+             *
+             * @param[in] frame The frame index. Must be lower than {@see GetFrameCount}.
+             * @return The rotation.
+             */
+            Ogre::Quaternion GetRootRotation(const size_t frame) const;
+
+            /**
+             * Retrieves the rotation of a bone in a frame.
+             *
+             * @param[in] bone The bone index. Must be lower than {@see GetBoneCount}.
+             * @param[in] frame The frame index. Must be lower than {@see GetFrameCount}.
+             * @return The rotation.
+             */
+            Ogre::Quaternion GetBoneRotation(const uint32 bone, const size_t frame) const;
+
+            /**
+             * Checks if a bone moves during the animation.
+             *
+             * @param[in] bone The bone index. Must be lower than {@see GetBoneCount}.
+             * @return True if the bone has a different rotation in some frame, false if it's
+             * the same during the whole animation.
+             */
+            bool IsBoneAnimated(const uint32 bone) const;
 
             /**
-             * Calculates the size of the file.
+             * Calculates the size of the animation data.
              *
-             * @return The size of the file.
-             * @todo Units?
+             * @return The size of the animation data, in bytes.
              */
             size_t CalculateSize() const;
 
             /**
-             * Sets the rotation for a frame.
+             * Quantizes a rotation.
              *
-             * @param[in] key_frame The frame.
-             * @param[in] rotation The rotation for the frame
+             * @param[in] rotation Euler angles, in degrees, as stored in the file.
+             * @return The quantized rotation.
+             */
+            static QuantizedRotation Quantize(const Ogre::Vector3 &rotation);
+
+            /**
+             * Converts a quantized rotation to a quaternion.
+             *
+             * @param[in] rotation The quantized rotation.
+             * @return The rotation, as applied to the bones.
+             */
+            static Ogre::Quaternion ToQuaternion(const QuantizedRotation &rotation);
+
+        protected:
+
+            /**
+             * Loads the file.
              */
-            void SetFrameRotation(
-              Ogre::TransformKeyFrame *key_frame,
-              const Ogre::Vector3 &rotation
-            ) const;
+            virtual void loadImpl() override final;
+
+            /**
+             * Unloads the file.
+             */
+            virtual void unloadImpl() override final;
 
         private:
 
@@ -155,9 +257,24 @@ namespace VGears{
             uint32 bone_count_;
 
             /**
-             * The list of frames.
+             * The number of frames.
+             */
+            uint32 frame_count_;
+
+            /**
+             * Translation of the whole skeleton.
+             */
+            TranslationTrack root_translation_;
+
+            /**
+             * Rotation of the whole skeleton.
+             */
+            RotationTrack root_rotation_;
+
+            /**
+             * Rotation of each bone.
              */
-            FrameList frames_;
+            std::vector<RotationTrack> bone_rotations_;
     };
 
     typedef Ogre::SharedPtr<AFile> AFilePtr;
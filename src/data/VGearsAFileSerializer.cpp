@@ -60,7 +60,9 @@ namespace VGears{
             );
         }
         dest->SetBoneCount(header_.bone_count);
-        ReadVector(stream, dest->GetFrames(), header_.frame_count);
+        AFile::FrameList frames;
+        ReadVector(stream, frames, header_.frame_count);
+        dest->SetFrames(frames);
     }
 
 }
@@ -15,6 +15,7 @@
 
 #include <OgreMesh.h>
 #include "data/VGearsHRCMeshLoader.h"
+#include "common/VGearsManualObject.h"
 #include "common/VGearsStringUtil.h"
 #include "data/VGearsPFile.h"
 #include "data/VGearsPFileManager.h"
@@ -43,11 +44,14 @@ namespace VGears{
         StringUtil::splitPath(hrc_file_.getName(), path);
         BoneList::const_iterator it(hrc_file_.GetBones().begin());
         BoneList::const_iterator end(hrc_file_.GetBones().end());
-        while(it != end) LoadBone(mesh, *(it++), path);
+        PFile::MaterialGeometryList geometries;
+        while(it != end) LoadBone(mesh, *(it++), path, geometries);
+        AddSubMeshes(mesh, geometries);
     }
 
     void HRCMeshLoader::LoadBone(
-      Ogre::Mesh *mesh, const Bone &bone, const String &path
+      Ogre::Mesh *mesh, const Bone &bone, const String &path,
+      PFile::MaterialGeometryList &geometries
     ){
         const String &bone_name(bone.name);
         RSDNameList::const_iterator it(bone.rsd_names.begin());
@@ -68,9 +72,33 @@ namespace VGears{
               pfile_name_, hrc_file_.getGroup()
             ).staticCast<PFile>();
             assert(p_file != nullptr);
-            p_file->AddGroups(mesh, bone_name, rsd_file);
+            p_file->CollectGroups(mesh, bone_name, rsd_file, geometries);
             ++ it;
         }
     }
 
+    void HRCMeshLoader::AddSubMeshes(
+      Ogre::Mesh *mesh, const PFile::MaterialGeometryList &geometries
+    ){
+        ManualObject mo(mesh);
+        PFile::MaterialGeometryList::const_iterator it(geometries.begin());
+        for (; it != geometries.end(); ++ it){
+            const PFile::GroupGeometry &geometry(it->geometry);
+            if (geometry.positions.empty()) continue;
+            mo.begin(
+              it->material_name, it->material_name,
+              geometry.positions.size(), geometry.indices.size()
+            );
+            for (size_t v(0); v < geometry.positions.size(); ++ v){
+                mo.position(geometry.positions[v]);
+                mo.colour(geometry.colours[v]);
+                mo.normal(geometry.normals[v]);
+                if (it->has_texture) mo.textureCoord(geometry.texture_coordinates[v]);
+                mo.bone(v, it->bones[v]);
+            }
+            for (const uint32 index : geometry.indices) mo.index(index);
+            mo.end();
+        }
+    }
+
 }
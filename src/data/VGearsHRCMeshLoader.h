@@ -17,6 +17,7 @@
 
 #include <OgreResource.h>
 #include "VGearsHRCFile.h"
+#include "VGearsPFile.h"
 
 namespace VGears{
 
@@ -51,12 +52,30 @@ namespace VGears{
             /**
              * Loads a bone.
              *
+             * The groups of the bone are collected by material, and added to the mesh after all
+             * bones are loaded.
+             *
              * @param[in,out] mesh The mesh to add the bone to.
              * @param[in] bone The bone to add.
              * @param[in] path Path to the file with the bone info.
+             * @param[in,out] geometries The geometries of each material in the mesh.
              */
             virtual void LoadBone(
-              Ogre::Mesh *mesh, const HRCFile::Bone &bone, const String &path
+              Ogre::Mesh *mesh, const HRCFile::Bone &bone, const String &path,
+              PFile::MaterialGeometryList &geometries
+            );
+
+            /**
+             * Adds a submesh for each material to a mesh.
+             *
+             * This way, a model is drawn with a call for each material, instead of one for each
+             * group of each bone.
+             *
+             * @param[in,out] mesh The mesh to add the submeshes to.
+             * @param[in] geometries The geometries of each material in the mesh.
+             */
+            virtual void AddSubMeshes(
+              Ogre::Mesh *mesh, const PFile::MaterialGeometryList &geometries
             );
 
         private:
@@ -13,6 +13,10 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <string>
 //#include <OgreThreadDefines.h>
@@ -23,13 +27,16 @@
 
 namespace VGears{
 
-    LGPArchive::LGPArchive(const String &name, const String &arch_type) :
-      Ogre::Archive(name, arch_type){}
+    LGPArchive::LGPArchive(const String &name, const String &arch_type, const bool read_only) :
+      Ogre::Archive(name, arch_type)
+    {mReadOnly = read_only;}
 
     LGPArchive::~LGPArchive(){unload();}
 
     void LGPArchive::load(){
         //OGRE_LOCK_AUTO_MUTEX
+        // A writable archive may not exist yet, it will be written on the first change.
+        if (!mReadOnly && !std::ifstream(mName.c_str(), std::ifstream::binary).is_open()) return;
         std::ifstream *ifs(
           OGRE_NEW_T(std::ifstream,Ogre::MEMCATEGORY_GENERAL)
             (mName.c_str(), std::ifstream::binary)
@@ -57,8 +64,6 @@ namespace VGears{
             file_infos_.push_back(file_info);
             ++ it;
         }
-        // Writing not implemented
-        mReadOnly = true;
     }
 
     void LGPArchive::unload(){
@@ -94,19 +99,79 @@ namespace VGears{
     }
 
     Ogre::DataStreamPtr LGPArchive::create(const String& filename) const{
-        OGRE_EXCEPT(
-          Ogre::Exception::ERR_NOT_IMPLEMENTED,
-          "Modification of lgp archives is not supported",
-          "LGPArchive::create"
-        );
+        if (mReadOnly){
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_INVALIDPARAMS,
+              "Cannot create a file in a read-only archive",
+              "LGPArchive::create"
+            );
+        }
+        return Ogre::DataStreamPtr(OGRE_NEW FileWriteStream(filename, this));
     }
 
     void LGPArchive::remove(const String& filename) const{
-        OGRE_EXCEPT(
-          Ogre::Exception::ERR_NOT_IMPLEMENTED,
-          "Modification of lgp archives is not supported",
-          "LGPArchive::remove"
+        if (mReadOnly){
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_INVALIDPARAMS,
+              "Cannot remove a file from a read-only archive",
+              "LGPArchive::remove"
+            );
+        }
+        Rewrite(filename, nullptr);
+    }
+
+    void LGPArchive::Rewrite(const String& filename, const std::vector<uint8>* data) const{
+        // Keep the current data order, so related files stay together.
+        FileList existing(files_);
+        std::stable_sort(
+          existing.begin(), existing.end(), [](const FileEntry &a, const FileEntry &b){
+              return a.data_offset < b.data_offset;
+          }
         );
+        std::vector<String> file_names;
+        bool found = false;
+        for (const FileEntry &file : existing){
+            if (file.file_name == filename){
+                found = true;
+                if (data == nullptr) continue;
+            }
+            file_names.push_back(file.file_name);
+        }
+        if (!found){
+            if (data == nullptr) return;
+            file_names.push_back(filename);
+        }
+
+        const String temp_name(mName + ".tmp");
+        try{
+            std::ofstream out(temp_name.c_str(), std::ofstream::binary | std::ofstream::trunc);
+            LGPArchiveSerializer serializer;
+            serializer.ExportLGPArchive(
+              out, file_names, [this, &filename, data](const String &name) -> Ogre::DataStreamPtr{
+                  if (name != filename) return open(name);
+                  return Ogre::DataStreamPtr(new Ogre::MemoryDataStream(
+                    const_cast<uint8*>(data->data()), data->size(), false, true
+                  ));
+              }
+            );
+        }
+        catch (...){
+            std::remove(temp_name.c_str());
+            throw;
+        }
+
+        // Replace the archive file and reload it.
+        LGPArchive* self(const_cast<LGPArchive*>(this));
+        self->unload();
+        std::remove(mName.c_str());
+        if (std::rename(temp_name.c_str(), mName.c_str()) != 0){
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_CANNOT_WRITE_TO_FILE,
+              "Cannot replace archive " + mName,
+              "LGPArchive::Rewrite"
+            );
+        }
+        self->load();
     }
 
     Ogre::StringVectorPtr LGPArchive::list(bool recursive, bool dirs) const{
@@ -201,4 +266,53 @@ namespace VGears{
 
     LGPArchive::FileList& LGPArchive::GetFiles(void){return files_;}
 
+    LGPArchive::FileWriteStream::FileWriteStream(
+      const String& name, const LGPArchive* archive
+    ):
+      Ogre::DataStream(
+        name, static_cast<Ogre::uint16>(Ogre::DataStream::READ | Ogre::DataStream::WRITE)
+      ),
+      archive_(archive), position_(0)
+    {}
+
+    LGPArchive::FileWriteStream::~FileWriteStream(){
+        try{close();}
+        catch (const Ogre::Exception &e){LOG_ERROR(e.getFullDescription());}
+    }
+
+    size_t LGPArchive::FileWriteStream::read(void *buf, size_t count){
+        count = std::min(count, data_.size() - position_);
+        memcpy(buf, data_.data() + position_, count);
+        position_ += count;
+        return count;
+    }
+
+    size_t LGPArchive::FileWriteStream::write(const void *buf, size_t count){
+        if (position_ + count > data_.size()) data_.resize(position_ + count);
+        memcpy(data_.data() + position_, buf, count);
+        position_ += count;
+        mSize = data_.size();
+        return count;
+    }
+
+    void LGPArchive::FileWriteStream::skip(long count){
+        if (count < 0 && static_cast<size_t>(-count) > position_) position_ = 0;
+        else seek(position_ + count);
+    }
+
+    void LGPArchive::FileWriteStream::seek(size_t pos){
+        position_ = std::min(pos, data_.size());
+    }
+
+    size_t LGPArchive::FileWriteStream::tell() const{return position_;}
+
+    bool LGPArchive::FileWriteStream::eof() const{return position_ >= data_.size();}
+
+    void LGPArchive::FileWriteStream::close(){
+        if (archive_ == nullptr) return;
+        const LGPArchive* archive(archive_);
+        archive_ = nullptr;
+        archive->Rewrite(getName(), &data_);
+    }
+
 }
@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <vector>
 #include <OgreArchive.h>
 #include "common/TypeDefine.h"
 
@@ -32,8 +33,10 @@ namespace VGears{
              *
              * @param[in] name Name for the archive.
              * @param[in] arch_type Archive type code.
+             * @param[in] read_only False to allow creating and removing files. If the archive
+             * file doesn't exist, an empty archive will be created on the first change.
              */
-            LGPArchive(const String &name, const String &arch_type);
+            LGPArchive(const String &name, const String &arch_type, const bool read_only = true);
 
             /**
              * Destructor.
@@ -71,16 +74,18 @@ namespace VGears{
             /**
              * Creates a new file (or overwrite one already there).
              *
-             * If the archive is read-only then this method will fail.
+             * If the archive is read-only then this method will fail. The file is added to the
+             * archive, and the archive file is rewritten, when the returned stream is closed.
              *
              * @param[in] filename Path to the file.
+             * @return A stream to write the file contents to.
              */
             Ogre::DataStreamPtr create(const String& filename) const;
 
             /**
              * Deletes a named file.
              *
-             * Not possible on read-only archives
+             * Not possible on read-only archives. The archive file is rewritten without it.
              *
              * @param[in] filename Path to the file.
              */
@@ -181,7 +186,8 @@ namespace VGears{
                 uint8  unknown1;
 
                 /**
-                 * Unknown data.
+                 * Index of the file's entry in the path table, starting at 1. 0 if the file
+                 * is not in a directory.
                  */
                 uint16 unknown2;
 
@@ -221,6 +227,113 @@ namespace VGears{
 
         private:
 
+            /**
+             * Stream returned by {@see create}.
+             *
+             * Data is kept in memory and added to the archive when the stream is closed.
+             */
+            class FileWriteStream : public Ogre::DataStream{
+
+                public:
+
+                    /**
+                     * Constructor.
+                     *
+                     * @param[in] name Name of the file in the archive.
+                     * @param[in] archive The archive to add the file to.
+                     */
+                    FileWriteStream(const String& name, const LGPArchive* archive);
+
+                    /**
+                     * Destructor.
+                     *
+                     * Closes the stream, if it wasn't.
+                     */
+                    virtual ~FileWriteStream();
+
+                    /**
+                     * Reads from the data written so far.
+                     *
+                     * @param[out] buf Buffer to read to.
+                     * @param[in] count Number of bytes to read.
+                     * @return Number of bytes read.
+                     */
+                    virtual size_t read(void *buf, size_t count) override;
+
+                    /**
+                     * Writes data at the current position.
+                     *
+                     * @param[in] buf Data to write.
+                     * @param[in] count Number of bytes to write.
+                     * @return Number of bytes written.
+                     */
+                    virtual size_t write(const void *buf, size_t count) override;
+
+                    /**
+                     * Moves the current position.
+                     *
+                     * @param[in] count Number of bytes to move.
+                     */
+                    virtual void skip(long count) override;
+
+                    /**
+                     * Sets the current position.
+                     *
+                     * @param[in] pos The new position.
+                     */
+                    virtual void seek(size_t pos) override;
+
+                    /**
+                     * Retrieves the current position.
+                     *
+                     * @return The current position.
+                     */
+                    virtual size_t tell() const override;
+
+                    /**
+                     * Checks if the current position is at the end of the data.
+                     *
+                     * @return True if there is no data after the current position.
+                     */
+                    virtual bool eof() const override;
+
+                    /**
+                     * Closes the stream and adds the file to the archive.
+                     */
+                    virtual void close() override;
+
+                private:
+
+                    /**
+                     * The archive to add the file to. Null once the stream is closed.
+                     */
+                    const LGPArchive* archive_;
+
+                    /**
+                     * Data written so far.
+                     */
+                    std::vector<uint8> data_;
+
+                    /**
+                     * Current position.
+                     */
+                    size_t position_;
+            };
+
+            /**
+             * Rewrites the archive file with a file added, replaced or removed.
+             *
+             * The archive is reloaded afterwards. Existing files keep their position in the
+             * archive data, and new ones are added at the end.
+             *
+             * Modifying an archive changes its state, but Ogre declares {@see create} and
+             * {@see remove} as const, hence this method being const too.
+             *
+             * @param[in] filename Name of the file to add, replace or remove.
+             * @param[in] data New contents of the file, or null to remove it.
+             */
+            void Rewrite(const String& filename, const std::vector<uint8>* data) const;
+
             /**
              * List of file sin the archive.
              */
@@ -57,7 +57,7 @@ namespace VGears{
             Ogre::Archive* createInstance(
               const String& name, bool readOnly
             ) override final{
-                return OGRE_NEW LGPArchive(name, ARCHIVE_TYPE);
+                return OGRE_NEW LGPArchive(name, ARCHIVE_TYPE, readOnly);
             }
 
             /**
@@ -13,12 +13,21 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <set>
 #include <OgreLogManager.h>
 #include <OgreException.h>
 #include "data/VGearsLGPArchiveSerializer.h"
+#include "common/VGearsStringUtil.h"
 
 namespace VGears{
 
+    const String LGPArchiveSerializer::MAGIC_STRING("SQUARESOFT");
+
+    const String LGPArchiveSerializer::TAG_FILE_END("FINAL FANTASY7");
+
     LGPArchiveSerializer::LGPArchiveSerializer() : Serializer(){}
 
     LGPArchiveSerializer::~LGPArchiveSerializer(){}
@@ -31,6 +40,7 @@ namespace VGears{
         ReadUInt32(stream, file_count);
         FileList& files(dest->GetFiles());
         ReadVector(stream, files, file_count);
+        ReadPaths(stream, files);
         FileList::iterator it(files.begin());
         FileList::const_iterator it_end(files.end());
         while (it != it_end){
@@ -55,10 +65,7 @@ namespace VGears{
         stream->read(&file_entry.unknown1, sizeof(file_entry.unknown1));
         ReadShort(stream, file_entry.unknown2);
 
-        if (
-          (file_entry.unknown1 != 14 && file_entry.unknown1 != 11)
-          || file_entry.unknown2 != 0
-        ){
+        if (file_entry.unknown1 != FILE_TYPE && file_entry.unknown1 != 11){
             Ogre::LogManager::getSingleton().stream()
               << "file_name: " << file_entry.file_name
               << " file_offset: " << file_entry.file_offset
@@ -67,4 +74,208 @@ namespace VGears{
         }
     }
 
+    void LGPArchiveSerializer::ReadPaths(Ogre::DataStreamPtr &stream, FileList &files){
+        stream->skip(LOOKUP_TABLE_SIZE * 4);
+        uint16 path_count(0);
+        ReadShort(stream, path_count);
+        for (uint16 p = 0; p < path_count && !stream->eof(); p ++){
+            uint16 entry_count(0);
+            ReadShort(stream, entry_count);
+            for (uint16 e = 0; e < entry_count; e ++){
+                String dir(readString(stream, PATH_NAME_LENGTH));
+                uint16 toc_index(0);
+                ReadShort(stream, toc_index);
+                if (toc_index >= files.size() || dir.empty()) continue;
+                std::replace(dir.begin(), dir.end(), '\\', '/');
+                files[toc_index].file_name = dir + "/" + files[toc_index].file_name;
+            }
+        }
+    }
+
+    void LGPArchiveSerializer::ExportLGPArchive(
+      std::ostream &out, const std::vector<String> &file_names, const FileOpener &open
+    ){
+        // Split names into directory and file name, and sort the table of contents by lookup
+        // index. Data is written in the order of the list.
+        struct TocEntry{
+            String dir;
+            String name;
+            int lookup;
+            size_t data_index;
+        };
+        std::vector<TocEntry> toc;
+        std::set<String> unique;
+        for (size_t i = 0; i < file_names.size(); i ++){
+            String full_name(file_names[i]);
+            std::replace(full_name.begin(), full_name.end(), '\\', '/');
+            if (!unique.insert(full_name).second){
+                OGRE_EXCEPT(
+                  Ogre::Exception::ERR_DUPLICATE_ITEM,
+                  "Duplicate file in LGP archive: " + full_name,
+                  "LGPArchiveSerializer::ExportLGPArchive"
+                );
+            }
+            TocEntry entry;
+            StringUtil::splitFilename(full_name, entry.name, entry.dir);
+            if (!entry.dir.empty() && entry.dir.back() == '/') entry.dir.pop_back();
+            entry.lookup = GetLookupIndex(entry.name);
+            entry.data_index = i;
+            if (
+              entry.lookup < 0 || entry.name.size() >= FILE_NAME_LENGTH
+              || entry.dir.size() >= PATH_NAME_LENGTH
+            ){
+                OGRE_EXCEPT(
+                  Ogre::Exception::ERR_INVALIDPARAMS,
+                  "File name can't be stored in a LGP archive: " + full_name,
+                  "LGPArchiveSerializer::ExportLGPArchive"
+                );
+            }
+            toc.push_back(entry);
+        }
+        std::stable_sort(toc.begin(), toc.end(), [](const TocEntry &a, const TocEntry &b){
+            if (a.lookup != b.lookup) return a.lookup < b.lookup;
+            return a.name < b.name;
+        });
+
+        // Files in directories go to the path table, grouped by name.
+        std::map<String, std::vector<size_t>> paths;
+        for (size_t t = 0; t < toc.size(); t ++)
+            if (!toc[t].dir.empty()) paths[toc[t].name].push_back(t);
+        std::vector<uint16> path_index(toc.size(), 0);
+        uint16 next_path = 1;
+        for (const auto &path : paths){
+            for (size_t t : path.second) path_index[t] = next_path;
+            next_path ++;
+        }
+
+        // Header.
+        WriteUInt16(out, 0);
+        WriteString(out, MAGIC_STRING, MAGIC_STRING_LENGTH);
+        WriteUInt32(out, static_cast<uint32>(toc.size()));
+
+        // Table of contents. Offsets are not known yet, it's written again at the end.
+        const std::streampos toc_start(out.tellp());
+        out.seekp(toc.size() * (FILE_NAME_LENGTH + 7), std::ios::cur);
+
+        // Lookup table: for each lookup index, first entry (starting at 1) and count.
+        std::vector<uint16> lookup_first(LOOKUP_TABLE_SIZE, 0);
+        std::vector<uint16> lookup_count(LOOKUP_TABLE_SIZE, 0);
+        for (size_t t = 0; t < toc.size(); t ++){
+            if (lookup_count[toc[t].lookup] == 0)
+                lookup_first[toc[t].lookup] = static_cast<uint16>(t + 1);
+            lookup_count[toc[t].lookup] ++;
+        }
+        for (size_t l = 0; l < LOOKUP_TABLE_SIZE; l ++){
+            WriteUInt16(out, lookup_first[l]);
+            WriteUInt16(out, lookup_count[l]);
+        }
+
+        // Path table.
+        WriteUInt16(out, static_cast<uint16>(paths.size()));
+        for (const auto &path : paths){
+            WriteUInt16(out, static_cast<uint16>(path.second.size()));
+            for (size_t t : path.second){
+                WriteString(out, toc[t].dir, PATH_NAME_LENGTH);
+                WriteUInt16(out, static_cast<uint16>(t));
+            }
+        }
+
+        // File data, in the requested order.
+        std::vector<size_t> data_to_toc(toc.size());
+        for (size_t t = 0; t < toc.size(); t ++) data_to_toc[toc[t].data_index] = t;
+        std::vector<uint32> offsets(toc.size(), 0);
+        std::vector<char> buffer(64 * 1024);
+        for (size_t d = 0; d < data_to_toc.size(); d ++){
+            const size_t t = data_to_toc[d];
+            offsets[t] = static_cast<uint32>(out.tellp());
+            Ogre::DataStreamPtr data(open(file_names[d]));
+            if (data == nullptr){
+                OGRE_EXCEPT(
+                  Ogre::Exception::ERR_FILE_NOT_FOUND,
+                  "Can't open file to add to LGP archive: " + file_names[d],
+                  "LGPArchiveSerializer::ExportLGPArchive"
+                );
+            }
+            WriteString(out, toc[t].name, FILE_NAME_LENGTH);
+            WriteUInt32(out, static_cast<uint32>(data->size()));
+            size_t remaining = data->size();
+            while (remaining > 0 && !data->eof()){
+                const size_t read = data->read(buffer.data(), std::min(remaining, buffer.size()));
+                if (read == 0) break;
+                out.write(buffer.data(), read);
+                remaining -= read;
+            }
+            data->close();
+        }
+        out.write(TAG_FILE_END.data(), TAG_FILE_END.size());
+        const std::streampos end(out.tellp());
+
+        // Now that the offsets are known, write the table of contents.
+        out.seekp(toc_start);
+        for (size_t t = 0; t < toc.size(); t ++){
+            WriteString(out, toc[t].name, FILE_NAME_LENGTH);
+            WriteUInt32(out, offsets[t]);
+            out.put(static_cast<char>(FILE_TYPE));
+            WriteUInt16(out, path_index[t]);
+        }
+        out.seekp(end);
+        if (!out){
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_CANNOT_WRITE_TO_FILE,
+              "Error writing LGP archive",
+              "LGPArchiveSerializer::ExportLGPArchive"
+            );
+        }
+    }
+
+    void LGPArchiveSerializer::SortByLocality(std::vector<String> &file_names){
+        std::stable_sort(
+          file_names.begin(), file_names.end(), [](const String &a, const String &b){
+              String a_base, a_dir, a_name, a_ext, b_base, b_dir, b_name, b_ext;
+              StringUtil::splitFilename(a, a_base, a_dir);
+              StringUtil::splitBaseFilename(a_base, a_name, a_ext);
+              StringUtil::splitFilename(b, b_base, b_dir);
+              StringUtil::splitBaseFilename(b_base, b_name, b_ext);
+              if (a_dir != b_dir) return a_dir < b_dir;
+              if (a_name != b_name) return a_name < b_name;
+              return a_ext < b_ext;
+          }
+        );
+    }
+
+    int LGPArchiveSerializer::GetLookupIndex(const String &file_name){
+        if (file_name.empty()) return -1;
+        const int first = GetLookupValue(file_name[0]);
+        const int second = (file_name.size() > 1 ? GetLookupValue(file_name[1]) : -1);
+        if (first < 0 || second < -1) return -1;
+        return first * LOOKUP_VALUE_MAX + second + 1;
+    }
+
+    int LGPArchiveSerializer::GetLookupValue(const char c){
+        char lower = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        if (lower == '.') return -1;
+        if (lower >= '0' && lower <= '9') lower += 'a' - '0';
+        else if (lower == '_') lower = 'k';
+        else if (lower == '-') lower = 'l';
+        else if (lower < 'a' || lower > 'z') return -2;
+        return lower - 'a';
+    }
+
+    void LGPArchiveSerializer::WriteUInt16(std::ostream &out, const uint16 value){
+        out.put(static_cast<char>(value & 0xFF));
+        out.put(static_cast<char>((value >> 8) & 0xFF));
+    }
+
+    void LGPArchiveSerializer::WriteUInt32(std::ostream &out, const uint32 value){
+        for (int i = 0; i < 4; i ++) out.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+
+    void LGPArchiveSerializer::WriteString(
+      std::ostream &out, const String &value, const size_t length
+    ){
+        String field(value.substr(0, length));
+        field.resize(length, '\0');
+        out.write(field.data(), length);
+    }
+
 }
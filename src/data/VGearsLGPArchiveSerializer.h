@@ -15,6 +15,9 @@
 
 #pragma once
 
+#include <functional>
+#include <ostream>
+#include <vector>
 #include "VGearsSerializer.h"
 #include "VGearsLGPArchive.h"
 
@@ -47,6 +50,53 @@ namespace VGears{
               Ogre::DataStreamPtr &stream, LGPArchive* dest
             );
 
+            /**
+             * Opens the contents of a file to write into an archive.
+             *
+             * Receives the name of the file, as passed to {@see ExportLGPArchive}.
+             */
+            typedef std::function<Ogre::DataStreamPtr(const String&)> FileOpener;
+
+            /**
+             * Writes a LGP archive.
+             *
+             * File data is written in the order of the list, so files that are used together
+             * should be next to each other (see {@see SortByLocality}). The table of contents
+             * is sorted by lookup value, and the lookup table is generated from it. Files in
+             * subdirectories are recorded in the path table.
+             *
+             * Files are opened one at a time, after the previous one has been written.
+             *
+             * @param[out] out Stream to write the archive to. It must be seekable.
+             * @param[in] file_names Names of the files to write, with forward slash separated
+             * directories.
+             * @param[in] open Function to open the contents of each file.
+             * @throws Ogre::Exception If a name can't be stored in a LGP archive, or if there
+             * are duplicate names.
+             */
+            virtual void ExportLGPArchive(
+              std::ostream &out, const std::vector<String> &file_names,
+              const FileOpener &open
+            );
+
+            /**
+             * Sorts file names so that related files are together.
+             *
+             * Files are grouped by directory, and inside it, by name without the extension,
+             * so that, for instance, all the files of a field or a model are contiguous.
+             *
+             * @param[in,out] file_names Names of the files to sort.
+             */
+            static void SortByLocality(std::vector<String> &file_names);
+
+            /**
+             * Calculates the lookup table index for a file name.
+             *
+             * @param[in] file_name The file name, without directory.
+             * @return Index in the lookup table, or -1 if the name can't be looked up.
+             */
+            static int GetLookupIndex(const String &file_name);
+
             enum {
                 /**
                  * Magic MIME string length.
@@ -56,7 +106,27 @@ namespace VGears{
                 /**
                  * Max file name length.
                  */
-                FILE_NAME_LENGTH = 20
+                FILE_NAME_LENGTH = 20,
+
+                /**
+                 * Max directory name length, in the path table.
+                 */
+                PATH_NAME_LENGTH = 128,
+
+                /**
+                 * Number of possible lookup values for a character.
+                 */
+                LOOKUP_VALUE_MAX = 30,
+
+                /**
+                 * Number of entries in the lookup table.
+                 */
+                LOOKUP_TABLE_SIZE = LOOKUP_VALUE_MAX * LOOKUP_VALUE_MAX,
+
+                /**
+                 * File type written in the table of contents.
+                 */
+                FILE_TYPE = 14
             };
 
             typedef LGPArchive::FileEntry FileEntry;
@@ -65,6 +135,61 @@ namespace VGears{
 
         protected:
 
+            /**
+             * Creator string written at the start of the archive.
+             */
+            static const String MAGIC_STRING;
+
+            /**
+             * String written at the end of the archive.
+             */
+            static const String TAG_FILE_END;
+
+            /**
+             * Reads the path table and adds directory names to the files in it.
+             *
+             * The stream must be at the start of the lookup table, right after the table of
+             * contents.
+             *
+             * @param[in] stream The contents of the LGP archive.
+             * @param[in,out] files The files in the table of contents.
+             */
+            virtual void ReadPaths(Ogre::DataStreamPtr &stream, FileList &files);
+
+            /**
+             * Calculates the lookup value of a character.
+             *
+             * @param[in] c The character.
+             * @return The lookup value, -1 for a dot, or less than -1 if the character can't be
+             * looked up.
+             */
+            static int GetLookupValue(const char c);
+
+            /**
+             * Writes a 16 bit little endian integer.
+             *
+             * @param[out] out The stream to write to.
+             * @param[in] value The value to write.
+             */
+            static void WriteUInt16(std::ostream &out, const uint16 value);
+
+            /**
+             * Writes a 32 bit little endian integer.
+             *
+             * @param[out] out The stream to write to.
+             * @param[in] value The value to write.
+             */
+            static void WriteUInt32(std::ostream &out, const uint32 value);
+
+            /**
+             * Writes a string in a fixed length field, padded with zeros.
+             *
+             * @param[out] out The stream to write to.
+             * @param[in] value The string to write. It must be shorter than the field.
+             * @param[in] length Length of the field.
+             */
+            static void WriteString(std::ostream &out, const String &value, const size_t length);
+
             /**
              * Reads an archive header and sets the instance data.
              *
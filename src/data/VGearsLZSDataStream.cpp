@@ -13,11 +13,14 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
 #include <OgreException.h>
 #include "data/VGearsLZSDataStream.h"
 
 namespace VGears{
 
+    const size_t LZSDataStream::CHECKPOINT_INTERVAL(64 * 1024);
+
     LZSDataStream::LZSDataStream(const Ogre::DataStreamPtr &compressed_stream) :
       Ogre::DataStream(compressed_stream->getAccessMode()),
       compressed_stream_(compressed_stream),
@@ -48,6 +51,13 @@ namespace VGears{
         FlipEndian(available_compressed_);
 #endif
         mSize = available_compressed_; // so the base size() works
+        checkpoints_.clear();
+        Checkpoint start;
+        start.position = 0;
+        start.compressed_position = compressed_stream_->tell();
+        start.available_compressed = available_compressed_;
+        start.buffer = buffer_;
+        checkpoints_.push_back(start);
     }
 
     void LZSDataStream::FlipEndian(uint32 &inout_data){
@@ -68,8 +78,8 @@ namespace VGears{
             ));
             count -= read;
             read_total += read;
+            position_ += read;
         }
-        position_ += read_total;
         return read_total;
     }
 
@@ -81,6 +91,19 @@ namespace VGears{
               "LZSDataStream::DecompressChunk"
             );
         }
+        // Chunks are only decompressed when all previous data has been read, so position_ is
+        // also the amount of data decompressed so far.
+        if (
+          !buffer_.Available()
+          && position_ >= checkpoints_.back().position + CHECKPOINT_INTERVAL
+        ){
+            Checkpoint checkpoint;
+            checkpoint.position = position_;
+            checkpoint.compressed_position = compressed_stream_->tell();
+            checkpoint.available_compressed = available_compressed_;
+            checkpoint.buffer = buffer_;
+            checkpoints_.push_back(checkpoint);
+        }
         uint8 data;
         uint8 control_byte;
         uint8 ref[2];
@@ -123,19 +146,34 @@ namespace VGears{
     }
 
     void LZSDataStream::skip(long count){
-        OGRE_EXCEPT(
-          Ogre::Exception::ERR_NOT_IMPLEMENTED,
-          "not yet implemented",
-          "LZSDataStream::skip"
-        );
+        if (count < 0){
+            const size_t back = static_cast<size_t>(-count);
+            seek(back > position_ ? 0 : position_ - back);
+        }
+        else Discard(static_cast<size_t>(count));
     }
 
     void LZSDataStream::seek(size_t pos){
-        OGRE_EXCEPT(
-          Ogre::Exception::ERR_NOT_IMPLEMENTED,
-          "not yet implemented",
-          "LZSDataStream::seek"
-        );
+        if (pos < position_){
+            // Find the last checkpoint before the position and restore the decoder state.
+            auto checkpoint = checkpoints_.rbegin();
+            while (checkpoint->position > pos) ++ checkpoint;
+            compressed_stream_->seek(checkpoint->compressed_position);
+            available_compressed_ = checkpoint->available_compressed;
+            buffer_ = checkpoint->buffer;
+            position_ = checkpoint->position;
+        }
+        Discard(pos - position_);
+    }
+
+    void LZSDataStream::Discard(size_t count){
+        uint8 discarded[256];
+        while (count && !eof()){
+            if (!buffer_.Available()) DecompressChunk();
+            size_t read(buffer_.Read(discarded, std::min(count, sizeof(discarded))));
+            count -= read;
+            position_ += read;
+        }
     }
 
     bool LZSDataStream::eof() const{
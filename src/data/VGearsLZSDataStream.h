@@ -13,6 +13,7 @@
  * GNU General Public License for more details.
  */
 
+#include <vector>
 #include <OgreDataStream.h>
 #include "common/TypeDefine.h"
 
@@ -152,20 +153,22 @@ namespace VGears{
             virtual bool eof() const override;
 
             /**
-             * Unimplemented.
+             * Skips a number of bytes.
              *
-             * Not required, can use read instead.
+             * Skipped data is decompressed and discarded. Negative counts seek backwards.
              *
-             * @param[in] count Unused.
+             * @param[in] count Number of bytes to skip.
              */
             virtual void skip(long count) override;
 
             /**
-             * Unimplemented.
+             * Moves the stream cursor to a position of the decompressed data.
              *
-             * Not required.
+             * When seeking backwards, decompression restarts from the nearest checkpoint before
+             * the position, not from the start of the stream. The compressed stream must be
+             * seekable for that.
              *
-             * @param[in] pos Unused.
+             * @param[in] pos Position in the decompressed data.
              */
             virtual void seek(size_t pos) override;
 
@@ -215,14 +218,58 @@ namespace VGears{
             /**
              * Decompresses the stream.
              *
-             * @todo The whole stream?
+             * Decompresses the data of one control byte, up to 8 literals or references.
+             * Checkpoints are recorded here.
              */
             virtual void DecompressChunk();
 
+            /**
+             * Number of decompressed bytes between checkpoints.
+             */
+            static const size_t CHECKPOINT_INTERVAL;
+
+            /**
+             * Saved decoder state, from which decompression can be restarted.
+             */
+            struct Checkpoint{
+
+                /**
+                 * Position in the decompressed data.
+                 */
+                size_t position;
+
+                /**
+                 * Position in the compressed stream.
+                 */
+                size_t compressed_position;
+
+                /**
+                 * Compressed bytes left to read at this point.
+                 */
+                uint32 available_compressed;
+
+                /**
+                 * Decoder window at this point.
+                 */
+                RingBuffer<4096> buffer;
+            };
+
+            /**
+             * Decompresses and discards data.
+             *
+             * @param[in] count Number of decompressed bytes to discard.
+             */
+            void Discard(size_t count);
+
             Ogre::DataStreamPtr compressed_stream_;
             uint32              available_compressed_;
             size_t              position_;
             RingBuffer<4096>    buffer_;
+
+            /**
+             * Checkpoints, in order of position.
+             */
+            std::vector<Checkpoint> checkpoints_;
     };
 
     typedef Ogre::SharedPtr<LZSDataStream>  LZSDataStreamPtr;
@@ -13,17 +13,81 @@
  * GNU General Public License for more details.
  */
 
+#include <functional>
 #include <iostream>
+#include <unordered_map>
 #include <OgreBone.h>
 #include <OgreLogManager.h>
 #include <OgreStringConverter.h>
 #include "data/VGearsPFile.h"
-#include "common/VGearsStringUtil.h"
 #include "data/VGearsPFileSerializer.h"
 #include "data/VGearsHRCFile.h"
 
 namespace VGears{
 
+    /**
+     * A polygon corner, as read from a P file.
+     */
+    struct PolygonCorner{
+
+        /**
+         * Corner position.
+         */
+        Ogre::Vector3 position;
+
+        /**
+         * Corner normal.
+         */
+        Ogre::Vector3 normal;
+
+        /**
+         * Corner texture coordinate. Zero if the group has no texture.
+         */
+        Ogre::Vector2 texture_coordinate;
+
+        /**
+         * Corner colour.
+         */
+        Ogre::ColourValue colour;
+
+        /**
+         * Checks if two corners are identical.
+         *
+         * @param[in] other The corner to compare with.
+         * @return True if all attributes are equal, false otherwise.
+         */
+        bool operator==(const PolygonCorner &other) const{
+            return position == other.position && normal == other.normal
+              && texture_coordinate == other.texture_coordinate && colour == other.colour;
+        }
+    };
+
+    /**
+     * Hash function for polygon corners.
+     */
+    struct PolygonCornerHash{
+
+        /**
+         * Hashes a polygon corner.
+         *
+         * @param[in] corner The corner to hash.
+         * @return The corner hash.
+         */
+        size_t operator()(const PolygonCorner &corner) const{
+            const float values[] = {
+              corner.position.x, corner.position.y, corner.position.z,
+              corner.normal.x, corner.normal.y, corner.normal.z,
+              corner.texture_coordinate.x, corner.texture_coordinate.y,
+              corner.colour.r, corner.colour.g, corner.colour.b, corner.colour.a
+            };
+            std::hash<float> hash;
+            size_t seed(0);
+            for (const float value : values)
+                seed ^= hash(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
     const String PFile::RESOURCE_TYPE("VGearsPFile");
 
     const Ogre::Quaternion PFile::STATIC_ROTATION(PFile::CreateStaticRotation());
@@ -125,17 +189,51 @@ namespace VGears{
         return true;
     }
 
-    void PFile::AddGroups(Ogre::Mesh *mesh, const String &bone_name, const RSDFilePtr &rsd) const{
-        const Ogre::SkeletonPtr skeleton(mesh->getSkeleton());
+    void PFile::CollectGroups(
+      Ogre::Mesh *mesh, const String &bone_name, const RSDFilePtr &rsd,
+      MaterialGeometryList &geometries
+    ) const{
+        const Ogre::Bone *bone(mesh->getSkeleton()->getBone(bone_name));
+        const uint16 bone_handle(bone->getHandle());
+        const Ogre::Vector3 bone_position(GetPosition(bone));
         const String material_base_name(rsd->GetMaterialBaseName());
-        String rsd_base;
-        StringUtil::splitBase(rsd->getName(), rsd_base);
-        ManualObject mo(mesh);
+        GroupGeometry group_geometry;
         for (size_t g(0); g < groups_.size(); ++ g){
-            const String sub_name(
-              bone_name + "/" + rsd_base + "/" + Ogre::StringConverter::toString(g)
+            const Group &group(groups_[g]);
+            size_t material_index(0);
+            if (group.has_texture) material_index = group.texture_index + 1;
+            const String material_name(
+              material_base_name + "/" + Ogre::StringConverter::toString(material_index)
+            );
+            MaterialGeometryList::iterator it(geometries.begin());
+            while (it != geometries.end() && it->material_name != material_name) ++ it;
+            if (it == geometries.end()){
+                geometries.push_back(MaterialGeometry());
+                it = geometries.end() - 1;
+                it->material_name = material_name;
+                it->has_texture = group.has_texture != 0;
+            }
+            BuildGroupGeometry(group, bone_position, group_geometry);
+            GroupGeometry &geometry(it->geometry);
+            const uint32 first_vertex(geometry.positions.size());
+            geometry.positions.insert(
+              geometry.positions.end(),
+              group_geometry.positions.begin(), group_geometry.positions.end()
+            );
+            geometry.normals.insert(
+              geometry.normals.end(), group_geometry.normals.begin(), group_geometry.normals.end()
+            );
+            geometry.colours.insert(
+              geometry.colours.end(), group_geometry.colours.begin(), group_geometry.colours.end()
             );
-            AddGroup(groups_[g], mo, sub_name, material_base_name, skeleton->getBone(bone_name));
+            geometry.texture_coordinates.insert(
+              geometry.texture_coordinates.end(),
+              group_geometry.texture_coordinates.begin(), group_geometry.texture_coordinates.end()
+            );
+            for (const uint32 index : group_geometry.indices)
+                geometry.indices.push_back(first_vertex + index);
+            // The bone of each vertex, in vertex order, so the skinning data is contiguous.
+            it->bones.resize(geometry.positions.size(), bone_handle);
         }
     }
 
@@ -149,39 +247,43 @@ namespace VGears{
         return pos;
     }
 
-    void PFile::AddGroup(
-      const Group &group, ManualObject &mo, const String &sub_name,
-      const String &material_base_name, const Ogre::Bone *bone
+    void PFile::BuildGroupGeometry(
+      const Group &group, const Ogre::Vector3 &offset, GroupGeometry &geometry
     ) const{
-        size_t material_index(0);
-        if (group.has_texture) material_index = group.texture_index + 1;
-        String material_name(
-          material_base_name + "/" + Ogre::StringConverter::toString(material_index)
-        );
-        const uint16 bone_handle(bone->getHandle());
-        const Ogre::Vector3 bone_position(GetPosition(bone));
-        size_t index(0);
-        size_t vertex_count(group.num_polygons * 3);
-        size_t index_count(vertex_count);
+        geometry = GroupGeometry();
+        // The rotation and the scale are applied once for each welded vertex, as a matrix.
+        Ogre::Matrix3 rotation;
+        STATIC_ROTATION.ToRotationMatrix(rotation);
+        const Ogre::Matrix3 position_transform(rotation * (1.0f / HRCFile::DOWN_SCALER));
+        const size_t corner_count(group.num_polygons * 3);
+        std::unordered_map<PolygonCorner, uint32, PolygonCornerHash> welded;
+        welded.reserve(corner_count);
+        geometry.indices.reserve(corner_count);
+        PolygonCorner corner;
+        corner.texture_coordinate = Ogre::Vector2::ZERO;
         size_t polygon_end_index(group.polygon_start_index + group.num_polygons);
-        mo.begin(sub_name, material_name, vertex_count, index_count);
         for (size_t p(group.polygon_start_index); p < polygon_end_index; ++ p){
             const PolygonDefinition& polygon(polygon_definitions_[p]);
             for (int i(3); i --;){
                 uint32 v(group.vertex_start_index + polygon.vertex[i]);
                 uint32 n(0 + polygon.normal[i]);
                 uint32 t(group.texture_coordinate_start_index + polygon.vertex[i]);
-                Ogre::Vector3 pos(vertices_[v]);
-                mo.position((STATIC_ROTATION * (pos / HRCFile::DOWN_SCALER)) + bone_position);
-                mo.colour(vertex_colours_[v]);
-                if (n < normals_.size()) mo.normal(STATIC_ROTATION * normals_[n]);
-                else mo.normal(STATIC_ROTATION * Ogre::Vector3(1.0f, 1.0f, 1.0f));
-                if (group.has_texture) mo.textureCoord(texture_coordinates_[t]);
-                mo.bone(index, bone_handle);
-                mo.index(index++);
+                corner.position = vertices_[v];
+                corner.colour = vertex_colours_[v];
+                if (n < normals_.size()) corner.normal = normals_[n];
+                else corner.normal = Ogre::Vector3(1.0f, 1.0f, 1.0f);
+                if (group.has_texture) corner.texture_coordinate = texture_coordinates_[t];
+                const auto inserted(welded.emplace(corner, geometry.positions.size()));
+                if (inserted.second){
+                    geometry.positions.push_back(position_transform * corner.position + offset);
+                    geometry.normals.push_back(rotation * corner.normal);
+                    geometry.colours.push_back(corner.colour);
+                    if (group.has_texture)
+                        geometry.texture_coordinates.push_back(corner.texture_coordinate);
+                }
+                geometry.indices.push_back(inserted.first->second);
             }
         }
-        mo.end();
     }
 
     Ogre::Quaternion PFile::CreateStaticRotation(){
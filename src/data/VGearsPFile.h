@@ -21,7 +21,6 @@
 #include <OgreResource.h>
 #include <Ogre.h>
 #include "common/TypeDefine.h"
-#include "common/VGearsManualObject.h"
 #include "data/VGearsRSDFile.h"
 
 namespace VGears{
@@ -78,20 +77,6 @@ namespace VGears{
              */
             virtual bool IsPolygonDefinitionListValid();
 
-            /**
-             * Adds a resource group.
-             *
-             * A resource group includes a bone, a mesh and a graphical resource.
-             *
-             * @param[in] mesh The mesh to add to the group.
-             * @param[in] bone_name The bone in the skeleton to which to add the group. The bone
-             * must be in a skeleton assigned to MESH.
-             * @param[in] rsd File with the resource to add to the group.
-             */
-            virtual void AddGroups(
-              Ogre::Mesh *mesh, const String &bone_name, const RSDFilePtr &rsd
-            ) const;
-
             /**
              * An edge.
              */
@@ -266,6 +251,72 @@ namespace VGears{
 
             typedef std::vector<BBoxEntry> BBoxList;
 
+            /**
+             * The geometry of a group, as it's added to a mesh.
+             *
+             * Polygon corners with the same position, normal, texture coordinate and colour
+             * share a vertex, and polygons are triangles indexing them.
+             */
+            struct GroupGeometry{
+
+                /**
+                 * Vertex positions, rotated, scaled and moved to the bone position.
+                 */
+                std::vector<Ogre::Vector3> positions;
+
+                /**
+                 * Vertex normals, rotated.
+                 */
+                std::vector<Ogre::Vector3> normals;
+
+                /**
+                 * Vertex colours.
+                 */
+                std::vector<Colour> colours;
+
+                /**
+                 * Vertex texture coordinates. Empty if the group has no texture.
+                 */
+                std::vector<Ogre::Vector2> texture_coordinates;
+
+                /**
+                 * Vertex indices, three for each polygon.
+                 */
+                std::vector<uint32> indices;
+            };
+
+            /**
+             * The geometry of all the groups of a model that use the same material.
+             *
+             * It becomes a single submesh. Groups of different bones can share it, since each
+             * vertex is fully assigned to a single bone.
+             */
+            struct MaterialGeometry{
+
+                /**
+                 * Name of the material.
+                 */
+                String material_name;
+
+                /**
+                 * Indicates if the material has a texture, so the vertices have texture
+                 * coordinates.
+                 */
+                bool has_texture;
+
+                /**
+                 * The vertices and triangles of all the groups.
+                 */
+                GroupGeometry geometry;
+
+                /**
+                 * Handle of the bone each vertex is assigned to.
+                 */
+                std::vector<uint16> bones;
+            };
+
+            typedef std::vector<MaterialGeometry> MaterialGeometryList;
+
             /**
              * The type of resource.
              */
@@ -343,6 +394,33 @@ namespace VGears{
              */
             virtual BBoxList& GetBBoxes();
 
+            /**
+             * Builds the geometry of a group.
+             *
+             * @param[in] group The group.
+             * @param[in] offset Position of the bone the group is added to.
+             * @param[out] geometry The group geometry. Previous contents are discarded.
+             */
+            virtual void BuildGroupGeometry(
+              const Group &group, const Ogre::Vector3 &offset, GroupGeometry &geometry
+            ) const;
+
+            /**
+             * Adds the groups of the file to the geometries of their materials.
+             *
+             * Each group is appended to the geometry with the same material, which is created
+             * if there is none yet.
+             *
+             * @param[in] mesh The mesh the groups are for. It must have a skeleton.
+             * @param[in] bone_name The bone in the skeleton the groups are attached to.
+             * @param[in] rsd File with the resources of the groups.
+             * @param[in,out] geometries The geometries of each material.
+             */
+            virtual void CollectGroups(
+              Ogre::Mesh *mesh, const String &bone_name, const RSDFilePtr &rsd,
+              MaterialGeometryList &geometries
+            ) const;
+
         protected:
             /**
              * Loads the file.
@@ -362,22 +440,6 @@ namespace VGears{
              */
             virtual size_t calculateSize() const override;
 
-            /**
-             * Add a group to the file.
-             *
-             * A resource group includes a bone, a mesh and a graphical resource.
-             *
-             * @param[in] group The group to add to the file.
-             * @param[in,out] mo The object to add to the group.
-             * @param[in] sub_name Name for mo.
-             * @param[in] material_base_name Name of the material for mo.
-             * @param[in] bone The bone to assign to bo.
-             */
-            virtual void AddGroup(
-              const Group &group, ManualObject &mo, const String &sub_name,
-              const String &material_base_name, const Ogre::Bone *bone
-            ) const;
-
             /**
              * Retrieves the position of a bone.
              *
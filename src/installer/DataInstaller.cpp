@@ -13,12 +13,24 @@
  * GNU General Public License for more details.
  */
 
-#include <QtCore/QDir>
 #include <boost/filesystem.hpp>
 #include "DataInstaller.h"
 
 float DataInstaller::LINE_SCALE_FACTOR = 0.0078124970964f;
 
+const std::map<std::string, DataInstaller::CachedGroup> DataInstaller::CACHED_GROUPS = {
+    {"battle_data", {{"data/battle/scene.bin"}, 1, "battle_models"}},
+    {"battle_models", {{"data/battle/battle.lgp", "data/battle/magic.lgp"}, 1, ""}},
+    {"kernel", {{"data/kernel/KERNEL.BIN", "ff7.exe"}, 1, ""}},
+    {"images", {{"data/menu/menu_us.lgp", "data/kernel/WINDOW.BIN"}, 1, ""}},
+    {"sounds", {{"data/sound/audio.fmt", "data/sound/audio.dat"}, 1, ""}},
+    {"music", {{"data/midi/midi.lgp", "data/music"}, 1, ""}},
+    {"fields", {{"data/field/flevel.lgp", "data/field/char.lgp"}, 5, "field_models"}},
+    {"field_models", {{"data/field/flevel.lgp", "data/field/char.lgp"}, 1, ""}},
+    {"wm", {{"data/wm"}, 1, "wm_models"}},
+    {"wm_models", {{"data/wm/world_us.lgp"}, 1, ""}}
+};
+
 DataInstaller::DataInstaller(
   const std::string input_dir, const std::string output_dir, AdvancedOptions options,
   std::function<void(std::string, int, bool)> write_output_line
@@ -65,10 +77,11 @@ float DataInstaller::Progress(){
             return CalcProgress();
         case INITIALIZE:
             write_output_line_("Initializing installers...", 2, true);
+            cache_ = std::make_unique<InstallCache>(input_dir_, output_dir_);
             kernel_installer_ = std::make_unique<KernelDataInstaller>(input_dir_);
             media_installer_ = std::make_unique<MediaDataInstaller>(
               input_dir_, output_dir_, options_.keep_originals,
-              options_.no_ffmpeg, options_.no_timidity
+              options_.no_ffmpeg, options_.no_timidity, options_.workers
             );
             field_installer_ = std::make_unique<FieldDataInstaller>(input_dir_, output_dir_);
             battle_installer_ = std::make_unique<BattleDataInstaller>(
@@ -86,6 +99,11 @@ float DataInstaller::Progress(){
                 installation_state_ = BATTLE_MODELS_INIT;
                 return CalcProgress();
             }
+            if (ReuseCachedGroup("battle_data")){
+                write_output_line_("Battle data unchanged, skipping...", 2, true);
+                installation_state_ = BATTLE_MODELS_INIT;
+                return CalcProgress();
+            }
             write_output_line_("Parsing battle scenes...", 2, true);
             substeps_ = battle_installer_->InitializeScenes();
             cur_substep_ = 0;
@@ -114,6 +132,7 @@ float DataInstaller::Progress(){
             cur_substep_ = 0;
             substeps_ = 0;
             battle_installer_->WriteFormations();
+            CommitCachedGroup("battle_data");
             // TODO: DEBUG
             installation_state_ = BATTLE_MODELS_INIT; // NORMAL
             //installation_state_ = SPELL_MODELS_INIT; // SKIP BATTLE MODELS
@@ -125,6 +144,11 @@ float DataInstaller::Progress(){
                 installation_state_ = KERNEL_PRICES;
                 return CalcProgress();
             }
+            if (ReuseCachedGroup("battle_models")){
+                write_output_line_("Battle models unchanged, skipping...", 2, true);
+                installation_state_ = KERNEL_PRICES;
+                return CalcProgress();
+            }
             write_output_line_("Extracting battle models...", 2, true);
             substeps_ = battle_installer_->InitializeBattleModels();
             cur_substep_ = 0;
@@ -170,7 +194,10 @@ float DataInstaller::Progress(){
             return CalcProgress();
         case SPELL_MODELS_CONVERT:
             cur_substep_ = battle_installer_->ConvertSpellModel();
-            if (cur_substep_ >= substeps_) installation_state_ = KERNEL_PRICES;
+            if (cur_substep_ >= substeps_){
+                CommitCachedGroup("battle_models");
+                installation_state_ = KERNEL_PRICES;
+            }
             return CalcProgress();
         case KERNEL_PRICES:
             // Skip kernel data if option is set.
@@ -179,6 +206,11 @@ float DataInstaller::Progress(){
                 installation_state_ = MEDIA_SOUNDS_INIT;
                 return CalcProgress();
             }
+            if (ReuseCachedGroup("kernel")){
+                write_output_line_("Kernel data unchanged, skipping...", 2, true);
+                installation_state_ = MEDIA_IMAGES;
+                return CalcProgress();
+            }
             write_output_line_("Parsing item and materia prices...", 2, true);
             kernel_installer_->ReadPrices();
             installation_state_ = KERNEL_COMMANDS;
@@ -253,6 +285,7 @@ float DataInstaller::Progress(){
             write_output_line_("Extracting the initial savemap...", 2, true);
             kernel_installer_->ReadInitialSaveMap();
             kernel_installer_->WriteInitialSaveMap(output_dir_ + "gamedata/initial_savemap.lua");
+            CommitCachedGroup("kernel");
             installation_state_ = MEDIA_IMAGES;
             return CalcProgress();
         case MEDIA_IMAGES:
@@ -262,8 +295,14 @@ float DataInstaller::Progress(){
                 installation_state_ = MEDIA_SOUNDS_INIT;
                 return CalcProgress();
             }
+            if (ReuseCachedGroup("images")){
+                write_output_line_("Game images unchanged, skipping...", 2, true);
+                installation_state_ = MEDIA_SOUNDS_INIT;
+                return CalcProgress();
+            }
             write_output_line_("Extracting game images...", 2, true);
             media_installer_->InstallSprites();
+            CommitCachedGroup("images");
             installation_state_ = MEDIA_SOUNDS_INIT;
             return CalcProgress();
         case MEDIA_SOUNDS_INIT:
@@ -273,19 +312,24 @@ float DataInstaller::Progress(){
                 installation_state_ = MEDIA_MUSICS_INIT;
                 return CalcProgress();
             }
+            if (ReuseCachedGroup("sounds")){
+                write_output_line_("Sound effects unchanged, skipping...", 2, true);
+                installation_state_ = MEDIA_MUSICS_INIT;
+                return CalcProgress();
+            }
             write_output_line_("Extracting sounds...", 2, true);
             substeps_ = media_installer_->InstallSoundsInit();
             installation_state_ = MEDIA_SOUNDS;
             cur_substep_ = 0;
             return CalcProgress();
         case MEDIA_SOUNDS:
-            if (media_installer_->InstallSounds() == true)
-                installation_state_ = MEDIA_SOUNDS_INDEX;
-            else cur_substep_ ++;
+            cur_substep_ = media_installer_->InstallSounds();
+            if (cur_substep_ >= substeps_) installation_state_ = MEDIA_SOUNDS_INDEX;
             return CalcProgress();
         case MEDIA_SOUNDS_INDEX:
             write_output_line_("Building sound index...", 2, true);
             media_installer_->WriteSoundIndex();
+            CommitCachedGroup("sounds");
             installation_state_ = MEDIA_MUSICS_INIT;
             return CalcProgress();
         case MEDIA_MUSICS_INIT:
@@ -295,15 +339,19 @@ float DataInstaller::Progress(){
                 installation_state_ = FIELD_SPAWN_POINTS_AND_SCALE_FACTORS_INIT;
                 return CalcProgress();
             }
+            if (ReuseCachedGroup("music")){
+                write_output_line_("Music tracks unchanged, skipping...", 2, true);
+                installation_state_ = FIELD_SPAWN_POINTS_AND_SCALE_FACTORS_INIT;
+                return CalcProgress();
+            }
             write_output_line_("Extracting music...", 2, true);
             substeps_ = media_installer_->InstallMusicsInit();
             installation_state_ = MEDIA_MUSICS;
             cur_substep_ = 0;
             return CalcProgress();
         case MEDIA_MUSICS:
-            if (media_installer_->InstallMusics() == true)
-                installation_state_ = MEDIA_MUSICS_HQ;
-            else cur_substep_ ++;
+            cur_substep_ = media_installer_->InstallMusics();
+            if (cur_substep_ >= substeps_) installation_state_ = MEDIA_MUSICS_HQ;
             return CalcProgress();
         case MEDIA_MUSICS_HQ:
             substeps_ = 0;
@@ -314,6 +362,7 @@ float DataInstaller::Progress(){
         case MEDIA_MUSICS_INDEX:
             write_output_line_("Building music track index...", 2, true);
             media_installer_->WriteMusicsIndex();
+            CommitCachedGroup("music");
             installation_state_ = FIELD_SPAWN_POINTS_AND_SCALE_FACTORS_INIT;
             return CalcProgress();
         case FIELD_SPAWN_POINTS_AND_SCALE_FACTORS_INIT:
@@ -323,6 +372,11 @@ float DataInstaller::Progress(){
                 installation_state_ = WM_INIT;
                 return CalcProgress();
             }
+            if (ReuseCachedGroup("fields")){
+                write_output_line_("Field maps unchanged, skipping...", 2, true);
+                installation_state_ = FIELD_CONVERT_MODELS_INIT;
+                return CalcProgress();
+            }
             write_output_line_("Collecting spawn points and scale factors...", 2, true);
             substeps_ = field_installer_->CollectSpawnAndScaleFactorsInit(application_.ResMgr());
             cur_substep_ = 0;
@@ -360,6 +414,7 @@ float DataInstaller::Progress(){
             return CalcProgress();
         case FIELD_WRITE_END:
             field_installer_->WriteEnd();
+            CommitCachedGroup("fields");
             installation_state_ = FIELD_CONVERT_MODELS_INIT;
             return CalcProgress();
         case FIELD_CONVERT_MODELS_INIT:
@@ -369,6 +424,11 @@ float DataInstaller::Progress(){
                 installation_state_ = WM_INIT;
                 return CalcProgress();
             }
+            if (ReuseCachedGroup("field_models")){
+                write_output_line_("Field models unchanged, skipping...", 2, true);
+                installation_state_ = WM_INIT;
+                return CalcProgress();
+            }
             write_output_line_("Converting field models...", 2, true);
             field_model_names_ = field_installer_->ConvertModelsInit();
             substeps_ = field_model_names_.size();
@@ -379,6 +439,7 @@ float DataInstaller::Progress(){
             field_installer_->ConvertModels(field_model_names_[cur_substep_]);
             cur_substep_ ++;
             if (cur_substep_ == substeps_){
+                CommitCachedGroup("field_models");
                 installation_state_ = WM_INIT;
                 cur_substep_ = 0;
             }
@@ -390,6 +451,11 @@ float DataInstaller::Progress(){
                 installation_state_ = CLEAN;
                 return CalcProgress();
             }
+            if (ReuseCachedGroup("wm")){
+                write_output_line_("World map data unchanged, skipping...", 2, true);
+                installation_state_ = WM_MODELS;
+                return CalcProgress();
+            }
             write_output_line_("Extracting world map data...", 2, true);
             substeps_ = world_installer_->Initialize();
             cur_substep_ = 0;
@@ -403,6 +469,7 @@ float DataInstaller::Progress(){
             if (world_installer_->ProcessMap() == false) cur_substep_ ++;
             else{
                 // TODO: Next step: map scripts, etc
+                CommitCachedGroup("wm");
                 installation_state_ = WM_MODELS;
                 cur_substep_ = 0;
             }
@@ -410,7 +477,12 @@ float DataInstaller::Progress(){
         case WM_MODELS:
             if (options_.skip_wm_models)
                 write_output_line_("Skipping world map model installation...", 2, true);
-            else world_installer_->ProcessModels();
+            else if (ReuseCachedGroup("wm_models"))
+                write_output_line_("World map models unchanged, skipping...", 2, true);
+            else{
+                world_installer_->ProcessModels();
+                CommitCachedGroup("wm_models");
+            }
             installation_state_ = CLEAN;
             return CalcProgress();
         case CLEAN:
@@ -426,6 +498,21 @@ float DataInstaller::Progress(){
     }
 }
 
+std::string DataInstaller::GetCurrentGroup() const{
+    if (installation_state_ < BATTLE_SCENES_INIT) return "setup";
+    if (installation_state_ < BATTLE_MODELS_INIT) return "battle_data";
+    if (installation_state_ < KERNEL_PRICES) return "battle_models";
+    if (installation_state_ < MEDIA_IMAGES) return "kernel";
+    if (installation_state_ < MEDIA_SOUNDS_INIT) return "images";
+    if (installation_state_ < MEDIA_MUSICS_INIT) return "sounds";
+    if (installation_state_ < FIELD_SPAWN_POINTS_AND_SCALE_FACTORS_INIT) return "music";
+    if (installation_state_ < FIELD_CONVERT_MODELS_INIT) return "fields";
+    if (installation_state_ < WM_INIT) return "field_models";
+    if (installation_state_ < WM_MODELS) return "wm";
+    if (installation_state_ < CLEAN) return "wm_models";
+    return "cleanup";
+}
+
 const float DataInstaller::CalcProgress(){
     float weight_total = 0; // Sum of every step weight.
     float weight_done = 0; // Sum of every previous step weight.
@@ -520,10 +607,48 @@ void DataInstaller::CreateDirectories(){
     );
 }
 
+bool DataInstaller::ReuseCachedGroup(const std::string& group){
+    const CachedGroup& info = CACHED_GROUPS.at(group);
+    bool cached = cache_->IsCached(group, info.inputs, info.version, CacheOptions(group));
+    if (cached && !options_.no_cache && info.dependent != ""){
+        bool dependent_skipped
+          = (info.dependent == "battle_models" && options_.skip_battle_models)
+          || (info.dependent == "field_models" && options_.skip_field_models)
+          || (info.dependent == "wm_models" && options_.skip_wm_models);
+        if (!dependent_skipped){
+            const CachedGroup& dependent = CACHED_GROUPS.at(info.dependent);
+            cached = cache_->IsCached(
+              info.dependent, dependent.inputs, dependent.version, CacheOptions(info.dependent)
+            );
+        }
+    }
+    if (cached && !options_.no_cache) return true;
+    cache_->Begin(group);
+    return false;
+}
+
+std::vector<std::string> DataInstaller::GetGroupInputs(const std::string& group){
+    auto info = CACHED_GROUPS.find(group);
+    return (info == CACHED_GROUPS.end()) ? std::vector<std::string>() : info->second.inputs;
+}
+
+void DataInstaller::CommitCachedGroup(const std::string& group){cache_->Commit(group);}
+
+std::string DataInstaller::CacheOptions(const std::string& group) const{
+    std::string options;
+    if (group == "sounds" || group == "music")
+        options += std::string("ffmpeg=") + (options_.no_ffmpeg ? "0" : "1") + ";";
+    if (group == "music")
+        options += std::string("timidity=") + (options_.no_timidity ? "0" : "1") + ";";
+    if (group == "sounds" || group == "music" || group == "wm" || group == "wm_models")
+        options += std::string("keep=") + (options_.keep_originals ? "1" : "0") + ";";
+    return options;
+}
+
 void DataInstaller::CleanInstall(){boost::filesystem::remove_all(output_dir_ + "data/temp/");}
 
 void DataInstaller::CreateDir(const std::string& path){
-    QString target = QString::fromStdString(output_dir_ + path);
-    QDir dir(target);
-    if (!dir.mkpath(".")) throw std::runtime_error("Failed to mkpath");
+    boost::system::error_code error;
+    boost::filesystem::create_directories(output_dir_ + path, error);
+    if (error) throw std::runtime_error("Failed to mkpath");
 }
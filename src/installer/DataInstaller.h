@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -25,6 +26,7 @@
 #include "BattleDataInstaller.h"
 #include "WorldInstaller.h"
 #include "ModelsAndAnimationsDb.h"
+#include "InstallCache.h"
 
 /**
  * The data installer.
@@ -102,6 +104,20 @@ class DataInstaller{
              * Option to avoid calls to the timidity executable
              */
             bool no_timidity;
+
+            /**
+             * Maximum number of external conversion processes to run at the same time.
+             *
+             * Used for sound effects and music conversion.
+             */
+            unsigned int workers;
+
+            /**
+             * Option to ignore outputs from previous installations and convert everything.
+             *
+             * The installation cache is still updated.
+             */
+            bool no_cache;
         };
 
         /**
@@ -137,8 +153,57 @@ class DataInstaller{
          */
         float Progress();
 
+        /**
+         * Retrieves the group of steps the installation is currently at.
+         *
+         * The groups are the same ones the installation cache and the advanced options work
+         * with: "battle_data", "battle_models", "kernel", "images", "sounds", "music", "fields",
+         * "field_models", "wm" and "wm_models"; plus "setup" before them and "cleanup" after.
+         *
+         * @return The name of the current group of steps.
+         */
+        std::string GetCurrentGroup() const;
+
+        /**
+         * Retrieves the original files a group of steps reads.
+         *
+         * @param[in] group Name of the group, as in {@see GetCurrentGroup}.
+         * @return Files and directories read by the group, relative to the input directory.
+         * Empty for unknown groups.
+         */
+        static std::vector<std::string> GetGroupInputs(const std::string& group);
+
     private:
 
+        /**
+         * A group of installation steps tracked by the installation cache.
+         */
+        struct CachedGroup{
+
+            /**
+             * Original files read by the group, relative to the input directory.
+             */
+            std::vector<std::string> inputs;
+
+            /**
+             * Version of the converters used by the group.
+             *
+             * Increase it whenever a change in the installer changes the output of the group,
+             * so previous installations are not reused.
+             */
+            unsigned int version;
+
+            /**
+             * Group that needs the state left in the installers by this one, or empty if none.
+             */
+            std::string dependent;
+        };
+
+        /**
+         * Groups of installation steps tracked by the installation cache, by name.
+         */
+        static const std::map<std::string, CachedGroup> CACHED_GROUPS;
+
         /**
          * Calculates the installation progress.
          *
@@ -166,6 +231,33 @@ class DataInstaller{
          */
         void CleanInstall();
 
+        /**
+         * Checks if a group of installation steps can reuse a previous installation.
+         *
+         * If it can't, the installation cache starts tracking the files the group writes.
+         * Groups whose state is needed by a later group are only reused if the later group is
+         * reused or skipped too.
+         *
+         * @param[in] group Name of the group of steps.
+         * @return True if the group doesn't need to be run, false otherwise.
+         */
+        bool ReuseCachedGroup(const std::string& group);
+
+        /**
+         * Records a group of installation steps as complete in the installation cache.
+         *
+         * @param[in] group Name of the group of steps.
+         */
+        void CommitCachedGroup(const std::string& group);
+
+        /**
+         * Builds a string with the options that affect the output of a group of steps.
+         *
+         * @param[in] group Name of the group of steps.
+         * @return The options, as a string.
+         */
+        std::string CacheOptions(const std::string& group) const;
+
         /**
          * Installation steps.
          */
@@ -492,6 +584,11 @@ class DataInstaller{
          */
         VGears::Application application_;
 
+        /**
+         * Manifest of previous installations, to skip unchanged work.
+         */
+        std::unique_ptr<InstallCache> cache_;
+
         /**
          * LGP archive with field data.
          */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/program_options.hpp>
+#include <OgreException.h>
+#include <OgreLogManager.h>
+#include <tinyxml.h>
+#include "map/VGearsFieldBundle.h"
+
+namespace bpo = boost::program_options;
+
+/**
+ * Reads the list of map files from a field index.
+ *
+ * @param[in] path Path to the field index (_fields.xml).
+ * @param[out] maps The map files in the index are added here.
+ * @return True if the index could be read, false otherwise.
+ */
+static bool ReadFieldIndex(const std::string& path, std::vector<std::string>& maps){
+    TiXmlDocument doc(path);
+    if (!doc.LoadFile()) return false;
+    const TiXmlElement* root = doc.RootElement();
+    if (root == nullptr || root->ValueStr() != "maps") return false;
+    for (
+      const TiXmlElement* map = root->FirstChildElement("map");
+      map != nullptr;
+      map = map->NextSiblingElement("map")
+    ){
+        const char* file_name = map->Attribute("file_name");
+        if (file_name != nullptr && *file_name != '\0') maps.push_back(file_name);
+    }
+    return true;
+}
+
+/**
+ * Field bundle compiler main function.
+ *
+ * Compiles the XML files of fields into binary field bundles, the same way the installer does.
+ *
+ * @param[in] argc Number of arguments passed to the application.
+ * @param[in] argv List of arguments passed to the application.
+ * @return The application return code. 0 is OK, 1 if any field failed to compile.
+ */
+int main(int argc, char *argv[]){
+    bpo::options_description cli("Options");
+    cli.add_options()
+      ("help,h", "This help message")
+      (
+        "directory,d", bpo::value<std::string>()->default_value("./data/fields/"),
+        "Fields directory. Map files are relative to it"
+      )
+      (
+        "map,m", bpo::value<std::vector<std::string>>(),
+        "Map files to compile. If none is given, all fields in _fields.xml are compiled"
+      );
+    bpo::positional_options_description positional;
+    positional.add("map", -1);
+    bpo::variables_map vm;
+    try{
+        bpo::store(
+          bpo::command_line_parser(argc, argv).options(cli).positional(positional).run(), vm
+        );
+        bpo::notify(vm);
+    }
+    catch (const std::exception& ex){
+        std::cerr << ex.what() << std::endl << cli << std::endl;
+        return 1;
+    }
+    if (vm.count("help")){
+        std::cout << "Usage: " << argv[0] << " [options] [map.xml]..." << std::endl;
+        std::cout << cli << std::endl;
+        return 0;
+    }
+
+    std::string directory(vm["directory"].as<std::string>());
+    if (!directory.empty() && directory.back() != '/' && directory.back() != '\\')
+        directory += "/";
+    std::vector<std::string> maps;
+    if (vm.count("map")) maps = vm["map"].as<std::vector<std::string>>();
+    else if (!ReadFieldIndex(directory + "_fields.xml", maps)){
+        std::cerr << "Can't read field index " << directory << "_fields.xml" << std::endl;
+        return 1;
+    }
+
+    // Resources log through Ogre.
+    std::unique_ptr<Ogre::LogManager> log_manager(new Ogre::LogManager());
+    log_manager->createLog("v-gears-field-compile.log", true, false, true);
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t compiled = 0;
+    for (const std::string& map : maps){
+        try{
+            VGears::FieldBundle::Compile(directory, map);
+            ++ compiled;
+        }
+        catch (const Ogre::Exception& ex){
+            std::cerr << "[ERROR] " << map << ": " << ex.getDescription() << std::endl;
+        }
+        catch (const std::exception& ex){
+            std::cerr << "[ERROR] " << map << ": " << ex.what() << std::endl;
+        }
+    }
+    const double elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+    std::cout << "Compiled " << compiled << " of " << maps.size() << " fields in "
+      << elapsed << " s" << std::endl;
+    return compiled == maps.size() ? 0 : 1;
+}
@@ -15,7 +15,6 @@
 
 #include <string>
 #include <boost/filesystem.hpp>
-#include <QtCore/QDir>
 #include "FieldDataInstaller.h"
 #include "TexFile.h"
 #include "common/File.h"
@@ -24,6 +23,7 @@
 #include "data/VGearsHRCFileManager.h"
 #include "data/VGearsLGPArchive.h"
 #include "data/VGearsAFileManager.h"
+#include "map/VGearsFieldBundle.h"
 
 float FieldDataInstaller::LINE_SCALE_FACTOR(0.0078124970964f);
 
@@ -142,9 +142,9 @@ bool FieldDataInstaller::IsTestField(const Ogre::String& resource_name){
 }
 
 void FieldDataInstaller::CreateDir(const std::string& path){
-    QString target = QString::fromStdString(output_dir_ + path);
-    QDir dir(target);
-    if (!dir.mkpath(".")) throw std::runtime_error("Failed to mkpath");
+    boost::system::error_code error;
+    boost::filesystem::create_directories(output_dir_ + path, error);
+    if (error) throw std::runtime_error("Failed to mkpath");
 }
 
 void FieldDataInstaller::CollectFieldScaleFactors(
@@ -292,6 +292,19 @@ void FieldDataInstaller::Write(int field_index){
     xml_element->SetAttribute("name", map);
     xml_element->SetAttribute("file_name", map + "/map.xml");
     element_->LinkEndChild(xml_element.release());
+    // Precompile the field, so the engine doesn't have to parse all the XML files on load.
+    try{
+        VGears::FieldBundle::Compile(output_dir_ + FIELD_MAPS_DIR + "/", map + "/map.xml");
+    }
+    catch (const Ogre::Exception& ex){
+        write_output_line_("[ERROR] Ogre exception bundling field " + map + ": " + ex.what());
+        std::cerr << "[ERROR] Ogre exception bundling field "
+          << map << ": " << ex.what() << std::endl;
+    }
+    catch (const std::exception& ex){
+        write_output_line_("[ERROR] Exception bundling field " + map + ": " + ex.what());
+        std::cerr << "[ERROR] Exception bundling field " << map << ": " << ex.what() << std::endl;
+    }
 }
 
 void FieldDataInstaller::WriteEnd(){
@@ -519,6 +532,33 @@ void FieldDataInstaller::PcFieldToVGearsField(VGears::FLevelFilePtr& field){
         );
         if (script_file.is_open()){
             script_file << decompiled.luaScript;
+            script_file.close();
+            // Precompiled copy, for when the field is loaded without its bundle. It's only used
+            // if it's newer than the source, so it's dated a second after it.
+            const std::string bytecode(
+              VGears::FieldBundle::CompileScript(
+                decompiled.luaScript, "@./data/fields/" + field->getName() + "/script.lua"
+              )
+            );
+            if (bytecode != decompiled.luaScript){
+                std::ofstream bytecode_file(
+                  output_dir_ + "/" + FIELD_MAPS_DIR + "/" + field->getName() + "/script.luac",
+                  std::ofstream::binary
+                );
+                bytecode_file.write(bytecode.data(), bytecode.size());
+                bytecode_file.close();
+                const std::string map_dir(
+                  output_dir_ + "/" + FIELD_MAPS_DIR + "/" + field->getName()
+                );
+                boost::system::error_code time_error;
+                const std::time_t source_time
+                  = boost::filesystem::last_write_time(map_dir + "/script.lua", time_error);
+                if (!time_error){
+                    boost::filesystem::last_write_time(
+                      map_dir + "/script.luac", source_time + 1, time_error
+                    );
+                }
+            }
             field_text_writer_.Begin(
               output_dir_ + "/" + FIELD_MAPS_DIR + "/" + field->getName() + "/text.xml"
             );
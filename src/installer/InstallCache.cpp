@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <boost/filesystem.hpp>
+#include "InstallCache.h"
+
+namespace bfs = boost::filesystem;
+
+const std::string InstallCache::MANIFEST = "install_cache.xml";
+
+const std::uint64_t InstallCache::FNV_OFFSET = 0xcbf29ce484222325ULL;
+
+const std::uint64_t InstallCache::FNV_PRIME = 0x100000001b3ULL;
+
+InstallCache::InstallCache(const std::string& input_dir, const std::string& output_dir):
+  input_dir_(input_dir), output_dir_(output_dir)
+{Load();}
+
+InstallCache::~InstallCache(){}
+
+bool InstallCache::IsCached(
+  const std::string& step, const std::vector<std::string>& inputs,
+  const unsigned int version, const std::string& options
+){
+    StepRecord record;
+    record.version = version;
+    record.options = options;
+    record.input_hash = HashInputs(inputs);
+    pending_[step] = record;
+    auto cached = steps_.find(step);
+    if (cached == steps_.end()) return false;
+    if (cached->second.version != version) return false;
+    if (cached->second.options != options) return false;
+    if (cached->second.input_hash != record.input_hash) return false;
+    // Every output must still be there, as written.
+    for (const auto& output : cached->second.outputs){
+        bfs::path path(output_dir_ + output.first);
+        boost::system::error_code error;
+        if (!bfs::is_regular_file(path, error)) return false;
+        if (bfs::file_size(path, error) != output.second.size || error) return false;
+        if (bfs::last_write_time(path, error) != output.second.time || error) return false;
+    }
+    return true;
+}
+
+void InstallCache::Begin(const std::string& step){
+    // Until it's committed, the step can't be trusted. Forget it and save the manifest, so an
+    // interruption in the middle of the step doesn't leave a stale record.
+    if (steps_.erase(step) > 0) Save();
+    snapshots_[step] = ScanOutputs();
+}
+
+void InstallCache::Commit(const std::string& step){
+    auto pending = pending_.find(step);
+    auto snapshot = snapshots_.find(step);
+    if (pending == pending_.end() || snapshot == snapshots_.end()) return;
+    StepRecord record = pending->second;
+    for (const auto& file : ScanOutputs()){
+        auto before = snapshot->second.find(file.first);
+        if (
+          before == snapshot->second.end()
+          || before->second.size != file.second.size
+          || before->second.time != file.second.time
+        ){
+            record.outputs[file.first] = file.second;
+        }
+    }
+    steps_[step] = record;
+    pending_.erase(pending);
+    snapshots_.erase(snapshot);
+    Save();
+}
+
+void InstallCache::Load(){
+    TiXmlDocument xml(output_dir_ + MANIFEST);
+    if (!xml.LoadFile()) return;
+    TiXmlElement* root = xml.RootElement();
+    if (root == nullptr || root->ValueStr() != "install_cache") return;
+    for (
+      TiXmlElement* node = root->FirstChildElement(); node != nullptr;
+      node = node->NextSiblingElement()
+    ){
+        const char* name = node->Attribute("name");
+        if (name == nullptr) continue;
+        if (node->ValueStr() == "input"){
+            FileRecord input;
+            input.size = ReadNumber(node, "size");
+            input.time = static_cast<std::time_t>(ReadNumber(node, "time"));
+            input.hash = ReadNumber(node, "hash", 16);
+            inputs_[name] = input;
+        }
+        else if (node->ValueStr() == "step"){
+            StepRecord record;
+            record.version = static_cast<unsigned int>(ReadNumber(node, "version"));
+            const char* options = node->Attribute("options");
+            record.options = (options == nullptr ? "" : options);
+            record.input_hash = ReadNumber(node, "hash", 16);
+            for (
+              TiXmlElement* out = node->FirstChildElement("output"); out != nullptr;
+              out = out->NextSiblingElement("output")
+            ){
+                const char* file = out->Attribute("name");
+                if (file == nullptr) continue;
+                FileRecord output;
+                output.size = ReadNumber(out, "size");
+                output.time = static_cast<std::time_t>(ReadNumber(out, "time"));
+                output.hash = 0;
+                record.outputs[file] = output;
+            }
+            steps_[name] = record;
+        }
+    }
+}
+
+void InstallCache::Save() const{
+    TiXmlDocument xml;
+    std::unique_ptr<TiXmlElement> container(new TiXmlElement("install_cache"));
+    for (const auto& input : inputs_){
+        std::unique_ptr<TiXmlElement> xml_input(new TiXmlElement("input"));
+        xml_input->SetAttribute("name", input.first);
+        xml_input->SetAttribute("size", std::to_string(input.second.size));
+        xml_input->SetAttribute(
+          "time", std::to_string(static_cast<long long>(input.second.time))
+        );
+        xml_input->SetAttribute("hash", ToHex(input.second.hash));
+        container->LinkEndChild(xml_input.release());
+    }
+    for (const auto& step : steps_){
+        std::unique_ptr<TiXmlElement> xml_step(new TiXmlElement("step"));
+        xml_step->SetAttribute("name", step.first);
+        xml_step->SetAttribute("version", step.second.version);
+        xml_step->SetAttribute("options", step.second.options);
+        xml_step->SetAttribute("hash", ToHex(step.second.input_hash));
+        for (const auto& output : step.second.outputs){
+            std::unique_ptr<TiXmlElement> xml_output(new TiXmlElement("output"));
+            xml_output->SetAttribute("name", output.first);
+            xml_output->SetAttribute("size", std::to_string(output.second.size));
+            xml_output->SetAttribute(
+              "time", std::to_string(static_cast<long long>(output.second.time))
+            );
+            xml_step->LinkEndChild(xml_output.release());
+        }
+        container->LinkEndChild(xml_step.release());
+    }
+    xml.LinkEndChild(container.release());
+    xml.SaveFile(output_dir_ + MANIFEST);
+}
+
+std::uint64_t InstallCache::HashInputs(const std::vector<std::string>& inputs){
+    // Expand directories into their files, sorted so the hash doesn't depend on the order the
+    // file system lists them.
+    std::vector<std::string> files;
+    for (const std::string& input : inputs){
+        bfs::path path(input_dir_ + input);
+        boost::system::error_code error;
+        if (bfs::is_directory(path, error)){
+            std::vector<std::string> dir_files;
+            for (
+              bfs::recursive_directory_iterator it(path, error), end; it != end;
+              it.increment(error)
+            ){
+                if (error) break;
+                if (!bfs::is_regular_file(it->status())) continue;
+                dir_files.push_back(
+                  GenericPath(input + "/" + bfs::relative(it->path(), path).string())
+                );
+            }
+            std::sort(dir_files.begin(), dir_files.end());
+            files.insert(files.end(), dir_files.begin(), dir_files.end());
+        }
+        else files.push_back(GenericPath(input));
+    }
+    std::uint64_t hash = FNV_OFFSET;
+    for (const std::string& file : files){
+        hash = FnvAdd(hash, file);
+        bfs::path path(input_dir_ + file);
+        boost::system::error_code error;
+        if (!bfs::is_regular_file(path, error)){
+            // Missing inputs are part of the hash too: if they appear later, the step must run.
+            hash = FnvAdd(hash, std::string("<missing>"));
+            continue;
+        }
+        FileRecord record;
+        record.size = bfs::file_size(path, error);
+        record.time = bfs::last_write_time(path, error);
+        auto known = inputs_.find(file);
+        if (
+          known != inputs_.end()
+          && known->second.size == record.size && known->second.time == record.time
+        ){
+            record.hash = known->second.hash;
+        }
+        else{
+            record.hash = HashFile(path.string());
+            inputs_[file] = record;
+        }
+        hash = FnvAdd(hash, record.hash);
+    }
+    return hash;
+}
+
+std::uint64_t InstallCache::HashFile(const std::string& path){
+    std::ifstream file(path, std::ios::binary);
+    std::uint64_t hash = FNV_OFFSET;
+    std::vector<char> buffer(1 << 16);
+    while (file){
+        file.read(buffer.data(), buffer.size());
+        hash = FnvAdd(hash, buffer.data(), static_cast<std::size_t>(file.gcount()));
+    }
+    return hash;
+}
+
+std::map<std::string, InstallCache::FileRecord> InstallCache::ScanOutputs() const{
+    std::map<std::string, FileRecord> files;
+    bfs::path root(output_dir_);
+    boost::system::error_code error;
+    if (!bfs::is_directory(root, error)) return files;
+    for (bfs::recursive_directory_iterator it(root, error), end; it != end; it.increment(error)){
+        if (error) break;
+        if (!bfs::is_regular_file(it->status())) continue;
+        std::string name = GenericPath(bfs::relative(it->path(), root).string());
+        if (name == MANIFEST || name.compare(0, 5, "temp/") == 0) continue;
+        FileRecord record;
+        record.size = bfs::file_size(it->path(), error);
+        record.time = bfs::last_write_time(it->path(), error);
+        record.hash = 0;
+        files[name] = record;
+    }
+    return files;
+}
+
+std::uint64_t InstallCache::FnvAdd(std::uint64_t hash, const char* data, const std::size_t size){
+    for (std::size_t i = 0; i < size; i ++){
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+std::uint64_t InstallCache::FnvAdd(std::uint64_t hash, const std::string& str){
+    return FnvAdd(hash, str.c_str(), str.size() + 1);
+}
+
+std::uint64_t InstallCache::FnvAdd(std::uint64_t hash, std::uint64_t value){
+    for (int i = 0; i < 8; i ++){
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+std::string InstallCache::ToHex(std::uint64_t value){
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; i --){
+        hex[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    return hex;
+}
+
+std::uint64_t InstallCache::ReadNumber(const TiXmlElement* node, const char* name, int base){
+    const char* value = node->Attribute(name);
+    if (value == nullptr) return 0;
+    return std::strtoull(value, nullptr, base);
+}
+
+std::string InstallCache::GenericPath(const std::string& path){
+    std::string generic = path;
+    std::replace(generic.begin(), generic.end(), '\\', '/');
+    return generic;
+}
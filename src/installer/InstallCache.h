@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+#include <tinyxml.h>
+
+/**
+ * Manifest of previous installations, used to skip unchanged work.
+ *
+ * For each installation step, the cache records a content hash of the original files the step
+ * reads, the version of the converter used, the options that affect the output and the list of
+ * files the step wrote. When the installer is run again, a step can be skipped if all of them
+ * match and every recorded output is still in place, untouched.
+ *
+ * The manifest is saved in the output directory as an XML file, after every completed step, so
+ * an interrupted installation still benefits from the steps it finished.
+ */
+class InstallCache{
+
+    public:
+
+        /**
+         * Name of the manifest file, relative to the output directory.
+         */
+        static const std::string MANIFEST;
+
+        /**
+         * Constructor.
+         *
+         * Reads the manifest, if there is one.
+         *
+         * @param[in] input_dir Path to the directory containing the original data.
+         * @param[in] output_dir Path to the directory where the V-Gears data is written.
+         */
+        InstallCache(const std::string& input_dir, const std::string& output_dir);
+
+        /**
+         * Destructor.
+         */
+        ~InstallCache();
+
+        /**
+         * Checks if the outputs of a step from a previous installation can be reused.
+         *
+         * The input hash is computed here and remembered, so it doesn't need to be computed
+         * again when the step is committed.
+         *
+         * @param[in] step Name of the step.
+         * @param[in] inputs Paths of the files or directories read by the step, relative to the
+         * input directory.
+         * @param[in] version Version of the converter used by the step. Increase it whenever the
+         * output of the step changes.
+         * @param[in] options Any option that affects the output of the step, as a string.
+         * @return True if the step doesn't need to be run, false otherwise.
+         */
+        bool IsCached(
+          const std::string& step, const std::vector<std::string>& inputs,
+          const unsigned int version, const std::string& options = ""
+        );
+
+        /**
+         * Marks the start of a step.
+         *
+         * Takes a snapshot of the output directory, to find out later which files were written
+         * by the step. {@see IsCached} must have been called for the step before.
+         *
+         * @param[in] step Name of the step.
+         */
+        void Begin(const std::string& step);
+
+        /**
+         * Marks the end of a step.
+         *
+         * Records every file written since {@see Begin} as an output of the step, and saves
+         * the manifest.
+         *
+         * @param[in] step Name of the step.
+         */
+        void Commit(const std::string& step);
+
+        /**
+         * Saves the manifest to the output directory.
+         */
+        void Save() const;
+
+    private:
+
+        /**
+         * FNV-1a 64-bit offset basis.
+         */
+        static const std::uint64_t FNV_OFFSET;
+
+        /**
+         * FNV-1a 64-bit prime.
+         */
+        static const std::uint64_t FNV_PRIME;
+
+        /**
+         * Information about a file in the disk.
+         */
+        struct FileRecord{
+
+            /**
+             * File size, in bytes.
+             */
+            std::uintmax_t size;
+
+            /**
+             * Last modification time.
+             */
+            std::time_t time;
+
+            /**
+             * Content hash. Only calculated for input files.
+             */
+            std::uint64_t hash;
+        };
+
+        /**
+         * Information about a completed step.
+         */
+        struct StepRecord{
+
+            /**
+             * Converter version.
+             */
+            unsigned int version;
+
+            /**
+             * Options that affected the output.
+             */
+            std::string options;
+
+            /**
+             * Combined hash of all the input files.
+             */
+            std::uint64_t input_hash;
+
+            /**
+             * Files written by the step, relative to the output directory.
+             */
+            std::map<std::string, FileRecord> outputs;
+        };
+
+        /**
+         * Loads the manifest from the output directory.
+         *
+         * A missing or malformed manifest is not an error, the cache is just empty.
+         */
+        void Load();
+
+        /**
+         * Calculates the combined hash of a list of inputs.
+         *
+         * Files whose size and modification time haven't changed since they were last hashed
+         * are not read again.
+         *
+         * @param[in] inputs Paths of the files or directories, relative to the input
+         * directory.
+         * @return The hash of all the inputs.
+         */
+        std::uint64_t HashInputs(const std::vector<std::string>& inputs);
+
+        /**
+         * Calculates the hash of a file's contents.
+         *
+         * @param[in] path Full path to the file.
+         * @return The 64-bit FNV-1a hash of the file contents.
+         */
+        static std::uint64_t HashFile(const std::string& path);
+
+        /**
+         * Adds bytes to a FNV-1a hash.
+         *
+         * @param[in] hash Current hash value.
+         * @param[in] data Bytes to add.
+         * @param[in] size Number of bytes to add.
+         * @return The updated hash.
+         */
+        static std::uint64_t FnvAdd(std::uint64_t hash, const char* data, const std::size_t size);
+
+        /**
+         * Adds a string, including its terminator, to a FNV-1a hash.
+         *
+         * @param[in] hash Current hash value.
+         * @param[in] str String to add.
+         * @return The updated hash.
+         */
+        static std::uint64_t FnvAdd(std::uint64_t hash, const std::string& str);
+
+        /**
+         * Adds a 64 bit value to a FNV-1a hash.
+         *
+         * @param[in] hash Current hash value.
+         * @param[in] value Value to add.
+         * @return The updated hash.
+         */
+        static std::uint64_t FnvAdd(std::uint64_t hash, std::uint64_t value);
+
+        /**
+         * Converts a 64 bit value to a hexadecimal string.
+         *
+         * @param[in] value The value to convert.
+         * @return The value as a 16 character hexadecimal string.
+         */
+        static std::string ToHex(std::uint64_t value);
+
+        /**
+         * Reads a numeric attribute from an XML element.
+         *
+         * @param[in] node The XML element.
+         * @param[in] name The attribute name.
+         * @param[in] base Numeric base of the attribute value.
+         * @return The attribute value, or 0 if not found.
+         */
+        static std::uint64_t ReadNumber(const TiXmlElement* node, const char* name, int base = 10);
+
+        /**
+         * Converts a path to the generic, slash separated, format.
+         *
+         * Paths are stored this way in the manifest, so it can be shared between systems.
+         *
+         * @param[in] path The path to convert.
+         * @return The generic path.
+         */
+        static std::string GenericPath(const std::string& path);
+
+        /**
+         * Lists all regular files in the output directory.
+         *
+         * The temporary directory and the manifest itself are excluded.
+         *
+         * @return Files, relative to the output directory, with size and modification time.
+         */
+        std::map<std::string, FileRecord> ScanOutputs() const;
+
+        /**
+         * The path to the directory from which to read the PC game data.
+         */
+        std::string input_dir_;
+
+        /**
+         * The path to the directory where to save the V-Gears data.
+         */
+        std::string output_dir_;
+
+        /**
+         * Completed steps, by name.
+         */
+        std::map<std::string, StepRecord> steps_;
+
+        /**
+         * Known input files, relative to the input directory.
+         */
+        std::map<std::string, FileRecord> inputs_;
+
+        /**
+         * Steps checked but not yet committed, with their new records.
+         */
+        std::map<std::string, StepRecord> pending_;
+
+        /**
+         * Snapshots of the output directory taken at the start of each running step.
+         */
+        std::map<std::string, std::map<std::string, FileRecord>> snapshots_;
+};
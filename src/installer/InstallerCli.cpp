@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+#include "DataInstaller.h"
+
+namespace bpo = boost::program_options;
+
+/**
+ * Groups of installation steps that can be selected from the command line.
+ *
+ * Each one is mapped to the advanced option that skips it.
+ */
+static const std::vector<std::pair<std::string, bool DataInstaller::AdvancedOptions::*>> GROUPS = {
+    {"battle_data", &DataInstaller::AdvancedOptions::skip_battle_data},
+    {"battle_models", &DataInstaller::AdvancedOptions::skip_battle_models},
+    {"kernel", &DataInstaller::AdvancedOptions::skip_kernel},
+    {"images", &DataInstaller::AdvancedOptions::skip_images},
+    {"sounds", &DataInstaller::AdvancedOptions::skip_sounds},
+    {"music", &DataInstaller::AdvancedOptions::skip_music},
+    {"fields", &DataInstaller::AdvancedOptions::skip_fields},
+    {"field_models", &DataInstaller::AdvancedOptions::skip_field_models},
+    {"wm", &DataInstaller::AdvancedOptions::skip_wm},
+    {"wm_models", &DataInstaller::AdvancedOptions::skip_wm_models}
+};
+
+/**
+ * Parses a comma separated list of step groups.
+ *
+ * @param[in] list The list to parse.
+ * @return The names of the groups in the list.
+ * @throws std::runtime_error If a name is not a valid group.
+ */
+static std::vector<std::string> ParseGroups(const std::string& list){
+    std::vector<std::string> names;
+    boost::split(names, list, boost::is_any_of(","), boost::token_compress_on);
+    names.erase(
+      std::remove_if(names.begin(), names.end(), [](const std::string& n){return n.empty();}),
+      names.end()
+    );
+    for (const std::string& name : names){
+        bool valid = std::any_of(
+          GROUPS.begin(), GROUPS.end(), [&name](const auto& group){return group.first == name;}
+        );
+        if (!valid) throw std::runtime_error("Unknown step '" + name + "'");
+    }
+    return names;
+}
+
+/**
+ * Normalizes a directory path so it ends with a separator.
+ *
+ * @param[in] path The path to normalize.
+ * @return The path, with a trailing slash.
+ */
+static std::string NormalizeDir(std::string path){
+    std::replace(path.begin(), path.end(), '\\', '/');
+    if (path.empty() || path.back() != '/') path += "/";
+    return path;
+}
+
+/**
+ * Command line installer main function.
+ *
+ * Runs the same installation as the V-Gears-Installer, without user interface, printing progress
+ * to the standard output and a summary of the time spent in each group of steps at the end.
+ *
+ * @param[in] argc Number of arguments passed to the application.
+ * @param[in] argv List of arguments passed to the application.
+ * @return The application return code. 0 is OK.
+ */
+int main(int argc, char *argv[]){
+    std::string step_list;
+    for (const auto& group : GROUPS) step_list += (step_list.empty() ? "" : ", ") + group.first;
+    bpo::options_description cli("Options");
+    cli.add_options()
+      ("help,h", "This help message")
+      ("input,i", bpo::value<std::string>(), "Directory with the original, extracted, game data")
+      ("output,o", bpo::value<std::string>(), "Directory where the V-Gears data will be written")
+      (
+        "steps,s", bpo::value<std::string>(),
+        ("Comma separated list of steps to run. Default is all of them: " + step_list).c_str()
+      )
+      ("skip", bpo::value<std::string>(), "Comma separated list of steps not to run")
+      (
+        "workers,j",
+        bpo::value<unsigned int>()->default_value(
+          std::max(boost::thread::hardware_concurrency(), 1u)
+        ),
+        "Maximum number of sound and music conversions to run at the same time"
+      )
+      ("no-cache", "Ignore previous installations and convert everything")
+      ("no-ffmpeg", "Don't call the ffmpeg executable")
+      ("no-timidity", "Don't call the timidity executable")
+      ("keep-originals", "Keep original data after installation")
+      ("quiet,q", "Only print errors and the timing summary");
+    bpo::positional_options_description positional;
+    positional.add("input", 1).add("output", 1);
+
+    bpo::variables_map vm;
+    try{
+        bpo::store(
+          bpo::command_line_parser(argc, argv).options(cli).positional(positional).run(), vm
+        );
+        bpo::notify(vm);
+    }
+    catch (const std::exception& ex){
+        std::cerr << ex.what() << std::endl << cli << std::endl;
+        return 1;
+    }
+    if (vm.count("help") || !vm.count("input") || !vm.count("output")){
+        std::cout << "Usage: " << argv[0] << " [options] <input> <output>" << std::endl;
+        std::cout << cli << std::endl;
+        return vm.count("help") ? 0 : 1;
+    }
+
+    const std::string input = NormalizeDir(vm["input"].as<std::string>());
+    const std::string output = NormalizeDir(vm["output"].as<std::string>());
+    DataInstaller::AdvancedOptions options;
+    options.keep_originals = vm.count("keep-originals") > 0;
+    options.no_ffmpeg = vm.count("no-ffmpeg") > 0;
+    options.no_timidity = vm.count("no-timidity") > 0;
+    options.no_cache = vm.count("no-cache") > 0;
+    options.workers = std::max(vm["workers"].as<unsigned int>(), 1u);
+    try{
+        std::vector<std::string> selected;
+        if (vm.count("steps")) selected = ParseGroups(vm["steps"].as<std::string>());
+        std::vector<std::string> skipped;
+        if (vm.count("skip")) skipped = ParseGroups(vm["skip"].as<std::string>());
+        for (const auto& group : GROUPS){
+            bool run = selected.empty()
+              || std::find(selected.begin(), selected.end(), group.first) != selected.end();
+            if (std::find(skipped.begin(), skipped.end(), group.first) != skipped.end())
+                run = false;
+            options.*(group.second) = !run;
+            if (!run) continue;
+            // Only the files read by the selected groups are required.
+            for (const std::string& file : DataInstaller::GetGroupInputs(group.first)){
+                if (!boost::filesystem::exists(input + file)){
+                    std::cerr << "Missing input file: " << input << file << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+    catch (const std::exception& ex){
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    const bool quiet = vm.count("quiet") > 0;
+    // Time spent in each group, in order of appearance.
+    std::vector<std::pair<std::string, double>> timings;
+    try{
+        float progress = 0;
+        DataInstaller installer(
+          input, output, options,
+          [quiet, &progress](const std::string line, int level, bool as_progress){
+              if (quiet) return;
+              std::cout << "[" << std::fixed << std::setprecision(1) << std::setw(5) << progress
+                << "%] " << line << std::endl;
+          }
+        );
+        const auto start = std::chrono::steady_clock::now();
+        while (progress < 100){
+            const std::string group = installer.GetCurrentGroup();
+            const auto step_start = std::chrono::steady_clock::now();
+            progress = installer.Progress();
+            const double elapsed = std::chrono::duration<double>(
+              std::chrono::steady_clock::now() - step_start
+            ).count();
+            if (timings.empty() || timings.back().first != group)
+                timings.push_back(std::make_pair(group, 0.0));
+            timings.back().second += elapsed;
+        }
+        const double total = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start
+        ).count();
+
+        std::cout << std::endl << "Time per step:" << std::endl;
+        for (const auto& timing : timings){
+            std::cout << "  " << std::left << std::setw(16) << timing.first << std::right
+              << std::fixed << std::setprecision(3) << std::setw(10) << timing.second << " s"
+              << std::endl;
+        }
+        std::cout << "  " << std::left << std::setw(16) << "total" << std::right
+          << std::fixed << std::setprecision(3) << std::setw(10) << total << " s" << std::endl;
+    }
+    catch (const std::exception& ex){
+        std::cerr << "Exception: " << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <OgreLogManager.h>
+#include "data/VGearsLGPArchive.h"
+#include "data/VGearsLGPArchiveSerializer.h"
+
+namespace bfs = boost::filesystem;
+namespace bpo = boost::program_options;
+
+/**
+ * Packs files and archives into a single LGP archive.
+ */
+class LgpRepack{
+
+    public:
+
+        /**
+         * Adds all files in a directory, recursively.
+         *
+         * Files are named by their path relative to the directory. If a file with the same
+         * name was already added, it's replaced.
+         *
+         * @param[in] dir Path to the directory.
+         */
+        void AddDirectory(const std::string& dir){
+            const bfs::path root(dir);
+            for (bfs::recursive_directory_iterator it(root), end; it != end; ++ it){
+                if (!bfs::is_regular_file(it->status())) continue;
+                std::string name(bfs::relative(it->path(), root).generic_string());
+                sources_[name] = Source{it->path().string(), nullptr};
+            }
+        }
+
+        /**
+         * Adds all files in a LGP archive.
+         *
+         * If a file with the same name was already added, it's replaced.
+         *
+         * @param[in] path Path to the archive.
+         */
+        void AddArchive(const std::string& path){
+            std::shared_ptr<VGears::LGPArchive> archive(new VGears::LGPArchive(path, "LGP"));
+            archive->load();
+            for (const VGears::LGPArchive::FileEntry& file : archive->GetFiles())
+                sources_[file.file_name] = Source{"", archive};
+        }
+
+        /**
+         * Writes the archive.
+         *
+         * @param[in] path Path to the archive to write.
+         * @param[in] order Names of files to place first, in this order. The rest are sorted
+         * by locality.
+         * @return Number of files written.
+         */
+        size_t Write(const std::string& path, const std::vector<std::string>& order){
+            std::vector<std::string> first;
+            std::vector<std::string> rest;
+            std::set<std::string> placed;
+            for (const std::string& name : order)
+                if (sources_.count(name) && placed.insert(name).second) first.push_back(name);
+            for (const auto& source : sources_)
+                if (placed.count(source.first) == 0) rest.push_back(source.first);
+            VGears::LGPArchiveSerializer::SortByLocality(rest);
+            first.insert(first.end(), rest.begin(), rest.end());
+
+            const std::string temp_path(path + ".tmp");
+            {
+                std::ofstream out(temp_path, std::ofstream::binary | std::ofstream::trunc);
+                VGears::LGPArchiveSerializer serializer;
+                serializer.ExportLGPArchive(
+                  out, first, [this](const Ogre::String& name){return Open(name);}
+                );
+            }
+            // Inputs can include the output archive, so it's only replaced at the end.
+            sources_.clear();
+            bfs::rename(temp_path, path);
+            return first.size();
+        }
+
+    private:
+
+        /**
+         * Where to read a file from.
+         */
+        struct Source{
+
+            /**
+             * Path to a loose file. Empty if the file is in an archive.
+             */
+            std::string path;
+
+            /**
+             * Archive containing the file. Null for loose files.
+             */
+            std::shared_ptr<VGears::LGPArchive> archive;
+        };
+
+        /**
+         * Opens a file to add it to the archive.
+         *
+         * @param[in] name Name of the file.
+         * @return The contents of the file.
+         */
+        Ogre::DataStreamPtr Open(const std::string& name){
+            const Source& source(sources_.at(name));
+            if (source.archive != nullptr) return source.archive->open(name);
+            std::ifstream file(source.path, std::ifstream::binary | std::ifstream::ate);
+            if (!file.is_open()) return Ogre::DataStreamPtr();
+            const size_t size(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            Ogre::MemoryDataStream* data(new Ogre::MemoryDataStream(size));
+            file.read(reinterpret_cast<char*>(data->getPtr()), size);
+            return Ogre::DataStreamPtr(data);
+        }
+
+        /**
+         * Files to write, by name.
+         */
+        std::map<std::string, Source> sources_;
+};
+
+/**
+ * LGP repacker main function.
+ *
+ * @param[in] argc Number of arguments passed to the application.
+ * @param[in] argv List of arguments passed to the application.
+ * @return The application return code. 0 is OK.
+ */
+int main(int argc, char *argv[]){
+    bpo::options_description cli("Options");
+    cli.add_options()
+      ("help,h", "This help message")
+      ("output,o", bpo::value<std::string>(), "LGP archive to write")
+      (
+        "input,i", bpo::value<std::vector<std::string>>(),
+        "Directories and LGP archives to pack. Later inputs replace files of earlier ones"
+      )
+      (
+        "order", bpo::value<std::string>(),
+        "Text file with one file name per line. Those files are placed first, in that order"
+      );
+    bpo::positional_options_description positional;
+    positional.add("output", 1).add("input", -1);
+    bpo::variables_map vm;
+    try{
+        bpo::store(
+          bpo::command_line_parser(argc, argv).options(cli).positional(positional).run(), vm
+        );
+        bpo::notify(vm);
+    }
+    catch (const std::exception& ex){
+        std::cerr << ex.what() << std::endl << cli << std::endl;
+        return 1;
+    }
+    if (vm.count("help") || !vm.count("output") || !vm.count("input")){
+        std::cout << "Usage: " << argv[0] << " [options] <output.lgp> <input>..." << std::endl;
+        std::cout << cli << std::endl;
+        return vm.count("help") ? 0 : 1;
+    }
+
+    // Archives log through Ogre.
+    std::unique_ptr<Ogre::LogManager> log_manager(new Ogre::LogManager());
+    log_manager->createLog("v-gears-lgp-repack.log", true, false, true);
+
+    std::vector<std::string> order;
+    if (vm.count("order")){
+        std::ifstream order_file(vm["order"].as<std::string>());
+        std::string line;
+        while (std::getline(order_file, line)){
+            line.erase(line.find_last_not_of("\r\n ") + 1);
+            if (!line.empty()) order.push_back(line);
+        }
+    }
+
+    try{
+        const auto start = std::chrono::steady_clock::now();
+        LgpRepack repack;
+        for (const std::string& input : vm["input"].as<std::vector<std::string>>()){
+            if (bfs::is_directory(input)) repack.AddDirectory(input);
+            else if (bfs::is_regular_file(input)) repack.AddArchive(input);
+            else{
+                std::cerr << "Input not found: " << input << std::endl;
+                return 1;
+            }
+        }
+        const std::string output(vm["output"].as<std::string>());
+        const size_t count = repack.Write(output, order);
+        const double elapsed = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start
+        ).count();
+        std::cout << "Packed " << count << " files into " << output << " ("
+          << bfs::file_size(output) << " bytes) in " << elapsed << " s" << std::endl;
+    }
+    catch (const Ogre::Exception& ex){
+        std::cerr << ex.getDescription() << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex){
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
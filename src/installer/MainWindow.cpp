@@ -13,6 +13,7 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -23,6 +24,7 @@
 #include <QtWidgets/QMessageBox>
 #include <QtCore/QTimer>
 #include <QtWidgets/QCheckBox>
+#include <boost/thread.hpp>
 #include "DataInstaller.h"
 #include "MainWindow.h"
 #include "ui_MainWindow.h"
@@ -279,6 +281,8 @@ void MainWindow::on_btn_data_run_clicked(){
             options.no_ffmpeg = (Qt::Checked == main_window_->chk_no_ffmpeg->checkState());
             options.no_timidity = (Qt::Checked == main_window_->chk_no_timidity->checkState());
             options.keep_originals = (Qt::Checked == main_window_->chk_keep_original->checkState());
+            options.no_cache = (Qt::Checked == main_window_->chk_no_cache->checkState());
+            options.workers = std::max(boost::thread::hardware_concurrency(), 1u);
 
             installer_created = true;
             installer_ = std::make_unique<DataInstaller>(
@@ -13,6 +13,7 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <cstdio>
@@ -24,6 +25,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/predef/os.h>
 #include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
 #include <tinyxml.h>
 #include "MediaDataInstaller.h"
 #include "data/VGearsLGPArchive.h"
@@ -48,10 +50,10 @@ int MediaDataInstaller::TOTAL_SOUNDS = 750;
 
 MediaDataInstaller::MediaDataInstaller(
   const std::string input_dir, const std::string output_dir, const bool keep_originals,
-  const bool no_ffmpeg, const bool no_timidity
+  const bool no_ffmpeg, const bool no_timidity, const unsigned int workers
 ):
   input_dir_(input_dir), output_dir_(output_dir), keep_originals_(keep_originals),
-  no_ffmpeg_(no_ffmpeg), no_timidity_(no_timidity),
+  no_ffmpeg_(no_ffmpeg), no_timidity_(no_timidity), workers_(std::max(workers, 1u)),
   menu_(input_dir + "data/menu/menu_us.lgp", "LGP"), window_(input_dir + "data/kernel/WINDOW.BIN"),
   midi_(input_dir + "data/midi/midi.lgp", "LGP")
 {PopulateMaps();}
@@ -1383,34 +1385,39 @@ int MediaDataInstaller::InstallSoundsInit(){
     return TOTAL_SOUNDS;
 }
 
-bool MediaDataInstaller::InstallSounds(){
+int MediaDataInstaller::InstallSounds(){
+    // Convert a batch of sounds, one per worker. Each conversion is an independent ffmpeg
+    // process, so they can all run at the same time.
+    int batch_end = std::min(processed_sounds_ + static_cast<int>(workers_), TOTAL_SOUNDS);
     if (!no_ffmpeg_){
-        std::string f_path
-          = output_dir_ + "audio/sounds/" + std::to_string(processed_sounds_) + ".wav";
-        std::ifstream file(f_path);
-        if (file.is_open()){
-            file.close();
-             std::string command = (boost::format(
-              "ffmpeg -hide_banner -loglevel panic -y "
-              "-i %1%audio/sounds/%2%.wav %1%audio/sounds/%2%.ogg"
-            ) % output_dir_ % processed_sounds_).str();
-            std::system(command.c_str());
-            //std::cout << "    ADD SOUND " << processed_sounds_ << ".ogg" << std::endl;
-            sounds_.push_back("audio/sounds/" + std::to_string(processed_sounds_) + ".ogg");
-            // Remove the wav file.
-            if (!keep_originals_)
-                std::remove((
-                  output_dir_ + "audio/sounds/" + std::to_string(processed_sounds_) + ".wav"
-                ).c_str());
-        }
-        else{
-            sounds_.push_back("audio/sounds/INVALID.ogg");
-            //std::cout << "    -- ADD SOUND INVALID.ogg" << std::endl;
+        boost::thread_group conversions;
+        for (int sound = processed_sounds_; sound < batch_end; sound ++){
+            std::string f_path = output_dir_ + "audio/sounds/" + std::to_string(sound) + ".wav";
+            std::ifstream file(f_path);
+            if (file.is_open()){
+                file.close();
+                std::string command = (boost::format(
+                  "ffmpeg -hide_banner -loglevel panic -y "
+                  "-i %1%audio/sounds/%2%.wav %1%audio/sounds/%2%.ogg"
+                ) % output_dir_ % sound).str();
+                bool remove = !keep_originals_;
+                conversions.create_thread([command, f_path, remove](){
+                    std::system(command.c_str());
+                    // Remove the wav file.
+                    if (remove) std::remove(f_path.c_str());
+                });
+                //std::cout << "    ADD SOUND " << sound << ".ogg" << std::endl;
+                sounds_.push_back("audio/sounds/" + std::to_string(sound) + ".ogg");
+            }
+            else{
+                sounds_.push_back("audio/sounds/INVALID.ogg");
+                //std::cout << "    -- ADD SOUND INVALID.ogg" << std::endl;
+            }
         }
+        conversions.join_all();
     }
-    processed_sounds_ ++;
-    if (processed_sounds_ >= TOTAL_SOUNDS) return true;
-    else return false;
+    processed_sounds_ = batch_end;
+    return processed_sounds_;
 }
 
 void MediaDataInstaller::WriteSoundIndex(){
@@ -1461,41 +1468,48 @@ int MediaDataInstaller::InstallMusicsInit(){
     return midi_.list(true, true)->size();
 }
 
-bool MediaDataInstaller::InstallMusics(){
-    VGears::LGPArchive::FileEntry f = midi_.GetFiles().at(processed_musics_);
-
-    // Find the index in the map.
-    int index = 1000 + processed_musics_;
-    for (auto const& m : musics_map_){
-        if (m.second + ".mid" == f.file_name){
-            index = m.first;
-            break;
-        }
-    }
-
+int MediaDataInstaller::InstallMusics(){
+    const int total = midi_.list(true, true)->size();
+    const int batch_end = std::min(processed_musics_ + static_cast<int>(workers_), total);
     File midi(input_dir_ + "data/midi/midi.lgp");
+    boost::thread_group conversions;
+    for (; processed_musics_ < batch_end; processed_musics_ ++){
+        VGears::LGPArchive::FileEntry f = midi_.GetFiles().at(processed_musics_);
 
-    std::fstream out;
-    out.open(output_dir_ + "audio/musics/" + std::to_string(index) + ".mid", std::ios::out);
-    midi.SetOffset(f.data_offset);
-    for (int j = 0; j < f.data_size; j ++) out << midi.readU8();
-    out.close();
+        // Find the index in the map.
+        int index = 1000 + processed_musics_;
+        for (auto const& m : musics_map_){
+            if (m.second + ".mid" == f.file_name){
+                index = m.first;
+                break;
+            }
+        }
 
-    // Convert to ogg (TiMidity + FFMpeg)
-    std::string command = (boost::format(
-      "timidity --quiet=3 %1%audio/musics/%2%.mid -Ow -o - "
-      "| ffmpeg -hide_banner -loglevel panic -y -i - %1%audio/musics/%2%.ogg"
-    ) % output_dir_ % index).str();
-    if (!no_ffmpeg_ && !no_timidity_) std::system(command.c_str());
+        std::string mid_path = output_dir_ + "audio/musics/" + std::to_string(index) + ".mid";
+        std::fstream out;
+        out.open(mid_path, std::ios::out);
+        midi.SetOffset(f.data_offset);
+        for (int j = 0; j < f.data_size; j ++) out << midi.readU8();
+        out.close();
 
-    // Remove the midi file.
-    if (!keep_originals_)
-        std::remove((output_dir_ + "audio/musics/" + std::to_string(index) + ".mid").c_str());
+        // Convert to ogg (TiMidity + FFMpeg). Each track is converted by its own processes, so
+        // all tracks in the batch can be converted at the same time.
+        std::string command = (boost::format(
+          "timidity --quiet=3 %1%audio/musics/%2%.mid -Ow -o - "
+          "| ffmpeg -hide_banner -loglevel panic -y -i - %1%audio/musics/%2%.ogg"
+        ) % output_dir_ % index).str();
+        bool convert = !no_ffmpeg_ && !no_timidity_;
+        bool remove = !keep_originals_;
+        conversions.create_thread([command, mid_path, convert, remove](){
+            if (convert) std::system(command.c_str());
+            // Remove the midi file.
+            if (remove) std::remove(mid_path.c_str());
+        });
 
-    musics_.push_back("audio/musics/" + std::to_string(processed_musics_) + ".ogg");
-    processed_musics_ ++;
-    if (processed_musics_ == midi_.list(true, true)->size()) return true;
-    else return false;
+        musics_.push_back("audio/musics/" + std::to_string(processed_musics_) + ".ogg");
+    }
+    conversions.join_all();
+    return processed_musics_;
 }
 
 void MediaDataInstaller::InstallHQMusics(){
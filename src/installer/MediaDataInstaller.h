@@ -36,10 +36,11 @@ class MediaDataInstaller{
          * @param[in] keep_originals True to keep original data after conversion, false to remove.
          * @param[in] no_ffmpeg True to prevent system calls to ffmpeg command, false to allow.
          * @param[in] no_timidity True to prevent system calls to timidity command, false to allow.
+         * @param[in] workers Maximum number of sound or music conversions to run at the same time.
          */
         MediaDataInstaller(
           const std::string input_dir, const std::string output_dir, const bool keep_originals,
-          const bool no_ffmpeg, const bool no_timidity
+          const bool no_ffmpeg, const bool no_timidity, const unsigned int workers
         );
 
         /**
@@ -68,11 +69,13 @@ class MediaDataInstaller{
         int InstallSoundsInit();
 
         /**
-         * Extracts the next sound file contained in the audio.dat file and installs it.
+         * Extracts the next batch of sound files contained in the audio.dat file and installs it.
          *
-         * @return True if there are no more sounds to extract, false otherwise.
+         * The batch has one sound per worker, and they are converted concurrently.
+         *
+         * @return The number of sounds already processed.
          */
-        bool InstallSounds();
+        int InstallSounds();
 
         /**
          * Writes the XML file with all audio entries.
@@ -87,11 +90,14 @@ class MediaDataInstaller{
         int InstallMusicsInit();
 
         /**
-         * Extracts the next music file contained in the midi.lgp, converts it and installs it.
+         * Extracts the next batch of music files contained in the midi.lgp, converts them and
+         * installs them.
+         *
+         * The batch has one music track per worker, and they are converted concurrently.
          *
-         * @return True if there are no more musics to extract, false otherwise.
+         * @return The number of music tracks already processed.
          */
-        bool InstallMusics();
+        int InstallMusics();
 
         /**
          * Converts high quality musiscs to OGG.
@@ -195,4 +201,9 @@ class MediaDataInstaller{
          */
         bool no_timidity_;
 
+        /**
+         * Maximum number of conversions to run at the same time.
+         */
+        unsigned int workers_;
+
 };
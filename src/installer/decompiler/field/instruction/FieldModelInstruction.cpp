@@ -126,7 +126,7 @@ void FieldModelInstruction::ProcessInst(
         case OPCODES::ASPED: code_gen->WriteTodo(md.GetEntityName(), "ASPED"); break;
         case OPCODES::CC: ProcessCC(code_gen, eng); break;
         case OPCODES::JUMP: ProcessJUMP(code_gen, md.GetEntityName()); break;
-        case OPCODES::AXYZI: ProcessAXYZI(code_gen); break;
+        case OPCODES::AXYZI: ProcessAXYZI(code_gen, eng); break;
         case OPCODES::LADER: ProcessLADER(code_gen, md.GetEntityName()); break;
         case OPCODES::OFST: ProcessOFST(code_gen, md.GetEntityName()); break;
         case OPCODES::OFSTW:
@@ -369,7 +369,7 @@ void FieldModelInstruction::ProcessGETAI(CodeGenerator* code_gen, const FieldEng
     );
     const auto& entity = engine.EntityByIndex(params_[2]->GetUnsigned());
     code_gen->AddOutputLine(
-      (boost::format("%1% = entity_manager:get_entity(\"%2%\"):get_move_triangle_id()")
+      (boost::format("%1% = fast_binds.entity_get_move_triangle_id(\"%2%\")")
       % variable % entity.GetName()
     ).str());
 }
@@ -463,13 +463,14 @@ void FieldModelInstruction::ProcessJUMP(CodeGenerator* code_gen, const std::stri
     code_gen->AddOutputLine((boost::format("self.%1%:jump_sync()") % entity).str());
 }
 
-void FieldModelInstruction::ProcessAXYZI(CodeGenerator* code_gen){
+void FieldModelInstruction::ProcessAXYZI(CodeGenerator* code_gen, const FieldEngine& engine){
     FieldCodeGenerator* cg = static_cast<FieldCodeGenerator*>(code_gen);
     const float scale = 128.0f * cg->GetScaleFactor();
+    const auto& entity = engine.EntityByIndex(params_[4]->GetUnsigned());
     code_gen->AddOutputLine((
-      boost::format("axyzi(%1%, %2%, %3%, %4%, %5%, %6%, %7%, %8%, %9%, %10%)")
+      boost::format("axyzi(%1%, %2%, %3%, %4%, \"%5%\", %6%, %7%, %8%, %9%, %10%)")
       % params_[0]->GetSigned() % params_[1]->GetSigned() % params_[2]->GetSigned()
-      % params_[3]->GetSigned() % params_[4]->GetSigned() % params_[5]->GetSigned()
+      % params_[3]->GetSigned() % entity.GetName() % params_[5]->GetSigned()
       % params_[6]->GetSigned() % params_[7]->GetSigned() % params_[8]->GetSigned()
       % scale
     ).str());
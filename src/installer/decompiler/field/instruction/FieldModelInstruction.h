@@ -280,8 +280,9 @@ class FieldModelInstruction : public KernelCallInstruction{
          * in each of the four address specified.
          *
          * @param[in,out] code_gen Code generator to append lines.
+         * @param[in] engine Engine, used to resolve the entity name.
          */
-        void ProcessAXYZI(CodeGenerator* code_gen);
+        void ProcessAXYZI(CodeGenerator* code_gen, const FieldEngine& engine);
 
         /**
          * Processes a LADER opcode.
@@ -76,6 +76,7 @@ public:
     QCheckBox *chk_no_timidity;
     QHBoxLayout *horizontalLayout_91;
     QCheckBox *chk_keep_original;
+    QCheckBox *chk_no_cache;
     QSpacerItem *verticalSpacer;
     QPushButton *btn_data_run;
     QProgressBar *data_progress_bar;
@@ -332,6 +333,11 @@ public:
 
         horizontalLayout_91->addWidget(chk_keep_original);
 
+        chk_no_cache = new QCheckBox(advancedOptions);
+        chk_no_cache->setObjectName(QString::fromUtf8("chk_no_cache"));
+
+        horizontalLayout_91->addWidget(chk_no_cache);
+
 
         verticalLayout_5->addLayout(horizontalLayout_91);
 
@@ -566,6 +572,10 @@ public:
         chk_keep_original->setToolTip(QCoreApplication::translate("MainWindow", "<html><head/><body><b>Don't delete original data after installation.</b><br><br>The installer extracts some original data from the installation disk, such as MIDI sounds, TEX images, and some LGP archives. If checked, this data will not be deleted when the installation is complete.<br><br>This data is never used by V-Gears, and there is usually no need to check this.</body></html>", nullptr));
 #endif // QT_CONFIG(tooltip)
         chk_keep_original->setText(QCoreApplication::translate("MainWindow", "Preserve original data", nullptr));
+#if QT_CONFIG(tooltip)
+        chk_no_cache->setToolTip(QCoreApplication::translate("MainWindow", "<html><head/><body><b>Convert everything again.</b><br><br>The installer remembers what was converted in previous installations to the same folder, and skips the parts whose original data hasn't changed. If checked, everything will be converted again.</body></html>", nullptr));
+#endif // QT_CONFIG(tooltip)
+        chk_no_cache->setText(QCoreApplication::translate("MainWindow", "Ignore previous installations", nullptr));
         btn_data_run->setText(QCoreApplication::translate("MainWindow", "Install data", nullptr));
         label_percent->setText(QString());
         label_progress->setText(QString());
@@ -13,6 +13,7 @@
  * GNU General Public License for more details.
  */
 
+#include <chrono>
 #include <OgreRoot.h>
 #include <OgreConfigFile.h>
 #include <OgreArchiveManager.h>
@@ -31,9 +32,12 @@
 #include "core/Console.h"
 #include "core/DebugDraw.h"
 #include "core/EntityManager.h"
+#include "core/FieldIndex.h"
+#include "core/FieldPreloader.h"
 #include "core/GameFrameListener.h"
 #include "core/InputManager.h"
 #include "core/Logger.h"
+#include "core/ResourceGroupLoader.h"
 #include "core/SavemapHandler.h"
 #include "core/ScriptManager.h"
 #include "core/Timer.h"
@@ -54,6 +58,7 @@
  * @return 0 on sucess, an error code on error.
  */
 int main(int argc, char *argv[]){
+    const auto start = std::chrono::steady_clock::now();
     try{
         VGears::Application app(argc, argv);
         // Re-finalize singleton registration after object construction is complete
@@ -82,47 +87,36 @@ int main(int argc, char *argv[]){
         // auto fontManager = std::make_unique<Ogre::FontManager>();
         //VGears::MapFileManager* worldManager = new VGears::MapFileManager();
 
-        // Initialize resources.
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/system/", "FileSystem"
+        // Initialize resources. Only the groups needed for the first screen are initialized
+        // before rendering starts, the rest are initialized in the background.
+        auto resource_group_loader = std::make_unique<ResourceGroupLoader>(start);
+        resource_group_loader->AddLocation(
+          "./data/system/", "FileSystem", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+          false, false
         );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/audio/", "FileSystem", "AUDIO"
+        resource_group_loader->AddLocation("./data/audio/", "FileSystem", "AUDIO", false, true);
+        resource_group_loader->AddLocation("./data/fields/", "FileSystem", "FIELDS", true, true);
+        resource_group_loader->AddLocation("./data/fonts/", "FileSystem", "FONTS", false, false);
+        resource_group_loader->AddLocation(
+          "./data/gamedata/", "FileSystem", "GAMEDATA", false, false
         );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/fields/", "FileSystem", "FIELDS", true
+        resource_group_loader->AddLocation("./data/images/", "FileSystem", "IMAGES", true, false);
+        resource_group_loader->AddLocation(
+          "./data/models/fields/", "FileSystem", "FIELD_MODELS", false, true
         );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/fonts/", "FileSystem", "FONTS"
+        resource_group_loader->AddLocation(
+          "./data/models/battle/", "FileSystem", "BATTLE_MODELS", true, true
         );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/gamedata/", "FileSystem", "GAMEDATA"
+        resource_group_loader->AddLocation(
+          "./data/screens/", "FileSystem", "SCREENS", false, false
         );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/images/", "FileSystem", "IMAGES", true
+        resource_group_loader->AddLocation(
+          "./data/scripts/", "FileSystem", "SCRIPTS", false, false
         );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/models/fields/", "FileSystem", "FIELD_MODELS"
-        );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/models/battle/", "FileSystem", "BATTLE_MODELS", true
-        );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/screens/", "FileSystem", "SCREENS"
-        );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/scripts/", "FileSystem", "SCRIPTS"
-        );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/system/", "FileSystem", "SYSTEM"
-        );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/texts/", "FileSystem", "TEXTS"
-        );
-        Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
-          "./data/wm", "FileSystem", "WORLD_MAP"
-        );
-        Ogre::ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
+        resource_group_loader->AddLocation("./data/system/", "FileSystem", "SYSTEM", false, false);
+        resource_group_loader->AddLocation("./data/texts/", "FileSystem", "TEXTS", false, false);
+        resource_group_loader->AddLocation("./data/wm", "FileSystem", "WORLD_MAP", false, true);
+        resource_group_loader->Start();
 
         // Initialize it before console because it may use it
         auto config_var_manager = std::make_unique<ConfigVarHandler>();
@@ -143,6 +137,8 @@ int main(int argc, char *argv[]){
         auto ui_manager = std::make_unique<UiManager>();
         auto dialogs_manager = std::make_unique<DialogsManager>();
         auto entity_manager = std::make_unique<EntityManager>();
+        auto field_index = std::make_unique<FieldIndex>();
+        auto field_preloader = std::make_unique<FieldPreloader>();
         auto battle_manager = std::make_unique<BattleManager>();
         auto console = std::make_unique<Console>();
         auto worldMapModule = std::make_unique<VGears::WorldmapModule>();
@@ -153,6 +149,7 @@ int main(int argc, char *argv[]){
         // Set base listener for usual game modules.
         auto frame_listener = std::make_unique<GameFrameListener>(window);
         root->addFrameListener(frame_listener.get());
+        root->addFrameListener(resource_group_loader.get());
 
         // Execute the configuration file to locad values.
         ConfigFile config;
@@ -169,6 +166,7 @@ int main(int argc, char *argv[]){
         // System modules
         // Thes must be removed first cause this can fire events to console.
         root->removeFrameListener(frame_listener.get());
+        root->removeFrameListener(resource_group_loader.get());
 
         // Must be destroyed before the script manager.
         entity_manager.reset();
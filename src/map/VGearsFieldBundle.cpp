@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include <OgreException.h>
+#include <OgreLogManager.h>
+extern "C"{
+    #include "lua.h"
+    #include <lauxlib.h>
+}
+#include "map/VGearsBackground2DFileXMLSerializer.h"
+#include "map/VGearsFieldBundle.h"
+#include "map/VGearsFieldBundleSerializer.h"
+#include "map/VGearsFieldBundleXMLSerializer.h"
+#include "map/VGearsWalkmeshFileXMLSerializer.h"
+
+namespace VGears{
+
+    const String FieldBundle::EXTENSION(".vgf");
+
+    FieldBundle::Record::Record():
+      type(RecordType::WALKMESH),
+      position(Ogre::Vector3::ZERO),
+      point2(Ogre::Vector3::ZERO),
+      scale(Ogre::Vector3::UNIT_SCALE),
+      orientation(Ogre::Quaternion::IDENTITY),
+      angle(0),
+      index(0),
+      track(0),
+      enabled(false)
+    {}
+
+    FieldBundle::FieldBundle(){}
+
+    FieldBundle::~FieldBundle(){}
+
+    String FieldBundle::GetBundleName(const String& map_file){
+        const size_t slash = map_file.find_last_of("/\\");
+        const size_t dot = map_file.find_last_of('.');
+        if (dot == String::npos || (slash != String::npos && dot < slash))
+            return map_file + EXTENSION;
+        return map_file.substr(0, dot) + EXTENSION;
+    }
+
+    void FieldBundle::Compile(const String& directory, const String& map_file){
+        FieldBundle bundle;
+        bundle.Import(directory, map_file);
+        // Written to a temporary file first, so an interrupted compilation doesn't leave a
+        // truncated bundle behind.
+        const String path(directory + GetBundleName(map_file));
+        const String temp_path(path + ".tmp");
+        {
+            std::ofstream out(temp_path, std::ofstream::binary | std::ofstream::trunc);
+            if (!out.is_open()){
+                OGRE_EXCEPT(
+                  Ogre::Exception::ERR_CANNOT_WRITE_TO_FILE, "can't write " + temp_path,
+                  "FieldBundle::Compile"
+                );
+            }
+            FieldBundleSerializer serializer;
+            serializer.ExportFieldBundle(out, bundle);
+        }
+        boost::system::error_code error;
+        boost::filesystem::rename(temp_path, path, error);
+        if (error){
+            std::remove(temp_path.c_str());
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_CANNOT_WRITE_TO_FILE, "can't write " + path,
+              "FieldBundle::Compile"
+            );
+        }
+    }
+
+    bool FieldBundle::Open(const String& directory, const String& map_file){
+        const String path(directory + GetBundleName(map_file));
+        boost::system::error_code error;
+        if (!boost::filesystem::is_regular_file(path, error)) return false;
+        *this = FieldBundle();
+        try{
+            Ogre::DataStreamPtr stream(ReadFile(path));
+            FieldBundleSerializer serializer;
+            serializer.ImportFieldBundle(stream, this);
+        }
+        catch (const Ogre::Exception& ex){
+            Ogre::LogManager::getSingleton().stream()
+              << "Can't read field bundle " << path << ": " << ex.getDescription();
+            return false;
+        }
+        if (!IsUpToDate(directory)){
+            Ogre::LogManager::getSingleton().stream()
+              << "Field bundle " << path << " is outdated, loading " << map_file << " instead";
+            return false;
+        }
+        return true;
+    }
+
+    void FieldBundle::Import(const String& directory, const String& map_file){
+        *this = FieldBundle();
+        {
+            Ogre::DataStreamPtr stream(ReadFile(directory + map_file));
+            FieldBundleXMLSerializer serializer;
+            serializer.ImportMapFile(stream, this);
+            AddSource(directory, map_file);
+        }
+        for (const Record& record : records_){
+            const String& name(record.file_name);
+            if (record.type == RecordType::WALKMESH && walkmeshes_.count(name) == 0){
+                Ogre::DataStreamPtr stream(ReadFile(directory + name));
+                WalkmeshFilePtr walkmesh(CreateWalkmesh(name));
+                WalkmeshFileXMLSerializer serializer;
+                serializer.ImportWalkmeshFile(stream, walkmesh.get());
+                walkmeshes_[name] = walkmesh;
+                AddSource(directory, name);
+            }
+            else if (record.type == RecordType::BACKGROUND_2D && backgrounds_.count(name) == 0){
+                Ogre::DataStreamPtr stream(ReadFile(directory + name));
+                Background2DFilePtr background(CreateBackground(name));
+                Background2DFileXMLSerializer serializer;
+                serializer.ImportBackground2DFile(stream, background.get());
+                backgrounds_[name] = background;
+                AddSource(directory, name);
+            }
+            else if (record.type == RecordType::TEXTS && texts_.count(name) == 0){
+                texts_[name] = ReadFile(directory + name)->getAsString();
+                AddSource(directory, name);
+            }
+            else if (record.type == RecordType::SCRIPT && scripts_.count(name) == 0){
+                const String source(ReadFile(directory + name)->getAsString());
+                FindGateways(source, gateways_);
+                // Same chunk name ScriptManager::RunFile would give it, for error messages.
+                scripts_[name] = CompileScript(source, "@./data/fields/" + name);
+                AddSource(directory, name);
+            }
+        }
+    }
+
+    bool FieldBundle::IsUpToDate(const String& directory) const{
+        for (const Source& source : sources_){
+            const boost::filesystem::path path(directory + source.file_name);
+            boost::system::error_code error;
+            if (!boost::filesystem::is_regular_file(path, error)) return false;
+            if (boost::filesystem::file_size(path, error) != source.size || error) return false;
+            if (boost::filesystem::last_write_time(path, error) != source.time || error)
+                return false;
+        }
+        return true;
+    }
+
+    FieldBundle::RecordList& FieldBundle::GetRecords(){return records_;}
+
+    const FieldBundle::RecordList& FieldBundle::GetRecords() const{return records_;}
+
+    FieldBundle::SourceList& FieldBundle::GetSources(){return sources_;}
+
+    const FieldBundle::SourceList& FieldBundle::GetSources() const{return sources_;}
+
+    std::map<String, WalkmeshFilePtr>& FieldBundle::GetWalkmeshes(){return walkmeshes_;}
+
+    const std::map<String, WalkmeshFilePtr>& FieldBundle::GetWalkmeshes() const{
+        return walkmeshes_;
+    }
+
+    std::map<String, Background2DFilePtr>& FieldBundle::GetBackgrounds(){return backgrounds_;}
+
+    const std::map<String, Background2DFilePtr>& FieldBundle::GetBackgrounds() const{
+        return backgrounds_;
+    }
+
+    std::map<String, String>& FieldBundle::GetTexts(){return texts_;}
+
+    const std::map<String, String>& FieldBundle::GetTexts() const{return texts_;}
+
+    std::map<String, String>& FieldBundle::GetScripts(){return scripts_;}
+
+    const std::map<String, String>& FieldBundle::GetScripts() const{return scripts_;}
+
+    std::vector<String>& FieldBundle::GetGateways(){return gateways_;}
+
+    const std::vector<String>& FieldBundle::GetGateways() const{return gateways_;}
+
+    WalkmeshFilePtr FieldBundle::CreateWalkmesh(const String& name){
+        WalkmeshFilePtr walkmesh(new WalkmeshFile(nullptr, name, 0, ""));
+        walkmesh->setToLoaded();
+        return walkmesh;
+    }
+
+    Background2DFilePtr FieldBundle::CreateBackground(const String& name){
+        Background2DFilePtr background(new Background2DFile(nullptr, name, 0, ""));
+        background->setToLoaded();
+        return background;
+    }
+
+    String FieldBundle::CompileScript(const String& source, const String& chunk_name){
+        lua_State* state = luaL_newstate();
+        String bytecode;
+        if (luaL_loadbuffer(state, source.data(), source.size(), chunk_name.c_str()) != 0){
+            Ogre::LogManager::getSingleton().stream()
+              << "Can't precompile " << chunk_name << ": " << lua_tostring(state, -1);
+            bytecode = source;
+        }
+        else if (lua_dump(state, WriteChunk, &bytecode) != 0) bytecode = source;
+        lua_close(state);
+        return bytecode;
+    }
+
+    void FieldBundle::FindGateways(const String& source, std::vector<String>& gateways){
+        static const String CALL("load_field_map_request");
+        for (
+          size_t pos = source.find(CALL); pos != String::npos; pos = source.find(CALL, pos + 1)
+        ){
+            const size_t line_start = source.find_last_of('\n', pos);
+            const size_t comment = source.find("--", line_start == String::npos ? 0 : line_start);
+            if (comment < pos) continue;
+            const size_t quote = source.find_first_not_of(" \t(", pos + CALL.size());
+            if (quote == String::npos) break;
+            if (source[quote] != '"' && source[quote] != '\'') continue;
+            const size_t end = source.find(source[quote], quote + 1);
+            if (end == String::npos) break;
+            const String name(source.substr(quote + 1, end - quote - 1));
+            if (name.empty() || name.find_first_of("\n\\") != String::npos) continue;
+            if (std::find(gateways.begin(), gateways.end(), name) == gateways.end())
+                gateways.push_back(name);
+        }
+    }
+
+    int FieldBundle::WriteChunk(lua_State* state, const void* data, size_t size, void* bytecode){
+        static_cast<String*>(bytecode)->append(static_cast<const char*>(data), size);
+        return 0;
+    }
+
+    Ogre::DataStreamPtr FieldBundle::ReadFile(const String& path){
+        std::ifstream file(path, std::ifstream::binary | std::ifstream::ate);
+        if (!file.is_open()){
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_FILE_NOT_FOUND, "can't open " + path, "FieldBundle::ReadFile"
+            );
+        }
+        const size_t size(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        Ogre::MemoryDataStream* data(new Ogre::MemoryDataStream(path, size));
+        file.read(reinterpret_cast<char*>(data->getPtr()), size);
+        return Ogre::DataStreamPtr(data);
+    }
+
+    void FieldBundle::AddSource(const String& directory, const String& file_name){
+        const boost::filesystem::path path(directory + file_name);
+        Source source;
+        source.file_name = file_name;
+        source.size = boost::filesystem::file_size(path);
+        source.time = boost::filesystem::last_write_time(path);
+        sources_.push_back(source);
+    }
+
+}
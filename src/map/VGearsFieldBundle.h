@@ -0,0 +1,479 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <vector>
+#include <OgreDataStream.h>
+#include <OgreQuaternion.h>
+#include <OgreVector3.h>
+#include "common/TypeDefine.h"
+#include "map/VGearsBackground2DFile.h"
+#include "map/VGearsWalkmeshFile.h"
+
+struct lua_State;
+
+namespace VGears{
+
+    /**
+     * A field map, precompiled into a single binary file.
+     *
+     * The bundle contains the contents of the map XML file, as an ordered list of records, and
+     * the files it references: walkmesh, background, texts and scripts. Loading a field from a
+     * bundle takes a single file read, and walkmesh and background data don't need to be parsed
+     * from XML.
+     *
+     * Bundles are generated from the XML files, by the installer or offline, and saved next to
+     * the map XML file with the {@see EXTENSION} extension. The bundle remembers the size and
+     * modification time of every file it was compiled from, so a bundle is ignored if any of
+     * them has been edited since.
+     */
+    class FieldBundle{
+
+        public:
+
+            /**
+             * Extension of bundle files.
+             */
+            static const String EXTENSION;
+
+            /**
+             * Types of map records.
+             *
+             * Each one corresponds to a tag in the map XML file.
+             */
+            enum class RecordType : uint8{
+
+                /**
+                 * Walkmesh file. Uses {@see Record::file_name}.
+                 */
+                WALKMESH = 0,
+
+                /**
+                 * Player movement rotation. Uses {@see Record::angle}.
+                 */
+                MOVEMENT_ROTATION = 1,
+
+                /**
+                 * Background file. Uses {@see Record::file_name}.
+                 */
+                BACKGROUND_2D = 2,
+
+                /**
+                 * Texts file. Uses {@see Record::file_name}.
+                 */
+                TEXTS = 3,
+
+                /**
+                 * Entity model. Uses every field but {@see Record::point2} and
+                 * {@see Record::enabled}.
+                 */
+                ENTITY_MODEL = 4,
+
+                /**
+                 * Entity trigger. Uses {@see Record::name}, {@see Record::position},
+                 * {@see Record::point2} and {@see Record::enabled}.
+                 */
+                ENTITY_TRIGGER = 5,
+
+                /**
+                 * Entity point. Uses {@see Record::name}, {@see Record::position} and
+                 * {@see Record::angle}.
+                 */
+                ENTITY_POINT = 6,
+
+                /**
+                 * Script entity. Uses {@see Record::name}.
+                 */
+                ENTITY_SCRIPT = 7,
+
+                /**
+                 * Script file. Uses {@see Record::file_name}.
+                 */
+                SCRIPT = 8,
+
+                /**
+                 * Music track. Uses {@see Record::index} as the map track ID and
+                 * {@see Record::track} as the game track ID.
+                 */
+                TRACK = 9
+            };
+
+            /**
+             * A map record.
+             *
+             * Which fields are used depends on the record type.
+             */
+            struct Record{
+
+                /**
+                 * Constructor.
+                 */
+                Record();
+
+                /**
+                 * Record type.
+                 */
+                RecordType type;
+
+                /**
+                 * Entity name.
+                 */
+                String name;
+
+                /**
+                 * Referenced file, relative to the fields directory. For entity models, the
+                 * model file.
+                 */
+                String file_name;
+
+                /**
+                 * Entity position. For triggers, the first point.
+                 */
+                Ogre::Vector3 position;
+
+                /**
+                 * Second point of a trigger.
+                 */
+                Ogre::Vector3 point2;
+
+                /**
+                 * Model scale.
+                 */
+                Ogre::Vector3 scale;
+
+                /**
+                 * Model root orientation.
+                 */
+                Ogre::Quaternion orientation;
+
+                /**
+                 * Model direction, point rotation or movement rotation, in degrees.
+                 */
+                Ogre::Real angle;
+
+                /**
+                 * Model index, or map track ID.
+                 */
+                int index;
+
+                /**
+                 * Game track ID.
+                 */
+                int track;
+
+                /**
+                 * Whether a trigger is enabled.
+                 */
+                bool enabled;
+            };
+
+            typedef std::vector<Record> RecordList;
+
+            /**
+             * A file the bundle was compiled from.
+             */
+            struct Source{
+
+                /**
+                 * Path, relative to the fields directory.
+                 */
+                String file_name;
+
+                /**
+                 * Size of the file, in bytes.
+                 */
+                std::uint64_t size;
+
+                /**
+                 * Last modification time.
+                 */
+                std::time_t time;
+            };
+
+            typedef std::vector<Source> SourceList;
+
+            /**
+             * Constructor.
+             */
+            FieldBundle();
+
+            /**
+             * Destructor.
+             */
+            virtual ~FieldBundle();
+
+            /**
+             * Retrieves the name of the bundle for a map file.
+             *
+             * @param[in] map_file Path to the map XML file.
+             * @return Path to the bundle file, the same one with the bundle extension.
+             */
+            static String GetBundleName(const String& map_file);
+
+            /**
+             * Generates the bundle for a map.
+             *
+             * Reads the map XML file and every file it references, and writes them to the
+             * bundle file.
+             *
+             * @param[in] directory The fields directory, with a trailing slash. Every path in the
+             * map file is relative to it.
+             * @param[in] map_file Path to the map XML file, relative to the directory.
+             * @throws Ogre::Exception If the map file, or a file it references, can't be read.
+             */
+            static void Compile(const String& directory, const String& map_file);
+
+            /**
+             * Reads the bundle for a map.
+             *
+             * @param[in] directory The fields directory, with a trailing slash.
+             * @param[in] map_file Path to the map XML file, relative to the directory.
+             * @return True if the bundle has been read. False if there is no bundle, it's not
+             * valid, or it's older than any of the files it was compiled from.
+             */
+            bool Open(const String& directory, const String& map_file);
+
+            /**
+             * Reads the map XML file and every file it references.
+             *
+             * @param[in] directory The fields directory, with a trailing slash.
+             * @param[in] map_file Path to the map XML file, relative to the directory.
+             * @throws Ogre::Exception If the map file, or a file it references, can't be read.
+             */
+            void Import(const String& directory, const String& map_file);
+
+            /**
+             * Checks if every source file is unchanged.
+             *
+             * @param[in] directory The fields directory, with a trailing slash.
+             * @return True if all the source files still have the recorded size and time.
+             */
+            bool IsUpToDate(const String& directory) const;
+
+            /**
+             * Retrieves the map records, in the order of the map file.
+             *
+             * @return The list of records.
+             */
+            RecordList& GetRecords();
+
+            /**
+             * Retrieves the map records, in the order of the map file.
+             *
+             * @return The list of records.
+             */
+            const RecordList& GetRecords() const;
+
+            /**
+             * Retrieves the files the bundle was compiled from.
+             *
+             * @return The list of source files.
+             */
+            SourceList& GetSources();
+
+            /**
+             * Retrieves the files the bundle was compiled from.
+             *
+             * @return The list of source files.
+             */
+            const SourceList& GetSources() const;
+
+            /**
+             * Retrieves the embedded walkmeshes, by file name.
+             *
+             * The walkmeshes are already loaded, and don't belong to any resource manager.
+             *
+             * @return The walkmeshes.
+             */
+            std::map<String, WalkmeshFilePtr>& GetWalkmeshes();
+
+            /**
+             * Retrieves the embedded walkmeshes, by file name.
+             *
+             * @return The walkmeshes.
+             */
+            const std::map<String, WalkmeshFilePtr>& GetWalkmeshes() const;
+
+            /**
+             * Retrieves the embedded backgrounds, by file name.
+             *
+             * The backgrounds are already loaded, and don't belong to any resource manager.
+             *
+             * @return The backgrounds.
+             */
+            std::map<String, Background2DFilePtr>& GetBackgrounds();
+
+            /**
+             * Retrieves the embedded backgrounds, by file name.
+             *
+             * @return The backgrounds.
+             */
+            const std::map<String, Background2DFilePtr>& GetBackgrounds() const;
+
+            /**
+             * Retrieves the embedded text files, by file name.
+             *
+             * Texts are kept as XML, because the text manager uses the XML nodes directly.
+             *
+             * @return The text files contents.
+             */
+            std::map<String, String>& GetTexts();
+
+            /**
+             * Retrieves the embedded text files, by file name.
+             *
+             * @return The text files contents.
+             */
+            const std::map<String, String>& GetTexts() const;
+
+            /**
+             * Retrieves the embedded scripts, by file name.
+             *
+             * Each script is a Lua chunk, precompiled to bytecode if it could be compiled, or as
+             * source otherwise.
+             *
+             * @return The scripts.
+             */
+            std::map<String, String>& GetScripts();
+
+            /**
+             * Retrieves the embedded scripts, by file name.
+             *
+             * @return The scripts.
+             */
+            const std::map<String, String>& GetScripts() const;
+
+            /**
+             * Retrieves the names of the fields the gateways of this field lead to.
+             *
+             * @return The destination field names, without duplicates.
+             */
+            std::vector<String>& GetGateways();
+
+            /**
+             * Retrieves the names of the fields the gateways of this field lead to.
+             *
+             * @return The destination field names, without duplicates.
+             */
+            const std::vector<String>& GetGateways() const;
+
+            /**
+             * Creates an empty, loaded walkmesh not managed by any resource manager.
+             *
+             * @param[in] name Name of the walkmesh.
+             * @return The new walkmesh.
+             */
+            static WalkmeshFilePtr CreateWalkmesh(const String& name);
+
+            /**
+             * Creates an empty, loaded background not managed by any resource manager.
+             *
+             * @param[in] name Name of the background.
+             * @return The new background.
+             */
+            static Background2DFilePtr CreateBackground(const String& name);
+
+            /**
+             * Precompiles a Lua script to bytecode.
+             *
+             * @param[in] source The script source.
+             * @param[in] chunk_name Name of the chunk, used in error messages.
+             * @return The bytecode, or the source itself if it can't be compiled, so the error
+             * is reported when the script is run.
+             */
+            static String CompileScript(const String& source, const String& chunk_name);
+
+            /**
+             * Finds the fields a field script can jump to.
+             *
+             * Looks for calls to load_field_map_request with a literal field name, which is how
+             * gateways and map jumps are scripted. Commented out calls are ignored.
+             *
+             * @param[in] source The script source code.
+             * @param[in,out] gateways Destination field names found are added here, unless they
+             * are already in it.
+             */
+            static void FindGateways(const String& source, std::vector<String>& gateways);
+
+        private:
+
+            /**
+             * Appends a piece of a dumped Lua chunk to a string.
+             *
+             * @param[in] state The Lua state dumping the chunk.
+             * @param[in] data The piece of the chunk.
+             * @param[in] size Size of the piece, in bytes.
+             * @param[out] bytecode The string to append to.
+             * @return Always 0, to continue dumping.
+             */
+            static int WriteChunk(lua_State* state, const void* data, size_t size, void* bytecode);
+
+            /**
+             * Reads a file into a stream.
+             *
+             * @param[in] path Path to the file.
+             * @return The file contents.
+             * @throws Ogre::Exception If the file can't be read.
+             */
+            static Ogre::DataStreamPtr ReadFile(const String& path);
+
+            /**
+             * Adds a file to the list of sources.
+             *
+             * @param[in] directory The fields directory, with a trailing slash.
+             * @param[in] file_name Path to the file, relative to the directory.
+             */
+            void AddSource(const String& directory, const String& file_name);
+
+            /**
+             * Map records.
+             */
+            RecordList records_;
+
+            /**
+             * Source files.
+             */
+            SourceList sources_;
+
+            /**
+             * Embedded walkmeshes.
+             */
+            std::map<String, WalkmeshFilePtr> walkmeshes_;
+
+            /**
+             * Embedded backgrounds.
+             */
+            std::map<String, Background2DFilePtr> backgrounds_;
+
+            /**
+             * Embedded text files.
+             */
+            std::map<String, String> texts_;
+
+            /**
+             * Embedded scripts.
+             */
+            std::map<String, String> scripts_;
+
+            /**
+             * Gateway destination field names.
+             */
+            std::vector<String> gateways_;
+    };
+}
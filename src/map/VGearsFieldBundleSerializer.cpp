@@ -0,0 +1,482 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <cstring>
+#include <sstream>
+#include <OgreException.h>
+#include <OgreLogManager.h>
+#include "map/VGearsFieldBundleSerializer.h"
+
+namespace VGears{
+
+    const String FieldBundleSerializer::MAGIC("VGFB");
+
+    const uint32 FieldBundleSerializer::VERSION(2);
+
+    FieldBundleSerializer::FieldBundleSerializer() : Serializer(){}
+
+    FieldBundleSerializer::~FieldBundleSerializer(){}
+
+    void FieldBundleSerializer::ImportFieldBundle(
+      Ogre::DataStreamPtr &stream, FieldBundle *dest
+    ){
+        std::vector<Section> sections;
+        ReadFileHeader(stream, sections);
+        for (const Section &section : sections){
+            stream->seek(section.offset);
+            switch (section.type){
+                case SectionType::SOURCES:
+                    ReadVector(stream, dest->GetSources());
+                    break;
+                case SectionType::MAP:
+                    ReadVector(stream, dest->GetRecords());
+                    break;
+                case SectionType::WALKMESH:
+                    {
+                        WalkmeshFilePtr walkmesh(FieldBundle::CreateWalkmesh(section.name));
+                        ReadVector(stream, walkmesh->GetTriangles());
+                        dest->GetWalkmeshes()[section.name] = walkmesh;
+                    }
+                    break;
+                case SectionType::BACKGROUND_2D:
+                    {
+                        Background2DFilePtr background(FieldBundle::CreateBackground(section.name));
+                        ReadBackground(stream, *background);
+                        dest->GetBackgrounds()[section.name] = background;
+                    }
+                    break;
+                case SectionType::TEXTS:
+                case SectionType::SCRIPT:
+                    {
+                        String data(section.size, '\0');
+                        stream->read(&data[0], section.size);
+                        if (section.type == SectionType::TEXTS)
+                            dest->GetTexts()[section.name] = data;
+                        else dest->GetScripts()[section.name] = data;
+                    }
+                    break;
+                case SectionType::GATEWAYS:
+                    {
+                        uint32 count;
+                        ReadUInt32(stream, count);
+                        dest->GetGateways().resize(count);
+                        for (String &gateway : dest->GetGateways()) ReadString(stream, gateway);
+                    }
+                    break;
+                default:
+                    Ogre::LogManager::getSingleton().stream()
+                      << "Unknown field bundle section type "
+                      << static_cast<int>(section.type) << ", skipped";
+            }
+        }
+    }
+
+    void FieldBundleSerializer::ExportFieldBundle(std::ostream &out, const FieldBundle &bundle){
+        // Sections are written to memory first, their sizes are needed for the table of
+        // contents.
+        std::vector<Section> sections;
+        std::vector<String> data;
+        std::ostringstream section_out;
+
+        WriteUInt32(section_out, static_cast<uint32>(bundle.GetSources().size()));
+        for (const FieldBundle::Source &source : bundle.GetSources()){
+            WriteString(section_out, source.file_name);
+            WriteUInt64(section_out, source.size);
+            WriteUInt64(section_out, static_cast<std::uint64_t>(source.time));
+        }
+        sections.push_back(Section{SectionType::SOURCES, "", 0, 0});
+        data.push_back(section_out.str());
+
+        section_out.str("");
+        WriteUInt32(section_out, static_cast<uint32>(bundle.GetRecords().size()));
+        for (const FieldBundle::Record &record : bundle.GetRecords())
+            WriteRecord(section_out, record);
+        sections.push_back(Section{SectionType::MAP, "", 0, 0});
+        data.push_back(section_out.str());
+
+        section_out.str("");
+        WriteUInt32(section_out, static_cast<uint32>(bundle.GetGateways().size()));
+        for (const String &gateway : bundle.GetGateways()) WriteString(section_out, gateway);
+        sections.push_back(Section{SectionType::GATEWAYS, "", 0, 0});
+        data.push_back(section_out.str());
+
+        for (const auto &walkmesh : bundle.GetWalkmeshes()){
+            section_out.str("");
+            WriteWalkmesh(section_out, *walkmesh.second);
+            sections.push_back(Section{SectionType::WALKMESH, walkmesh.first, 0, 0});
+            data.push_back(section_out.str());
+        }
+        for (const auto &background : bundle.GetBackgrounds()){
+            section_out.str("");
+            WriteBackground(section_out, *background.second);
+            sections.push_back(Section{SectionType::BACKGROUND_2D, background.first, 0, 0});
+            data.push_back(section_out.str());
+        }
+        for (const auto &texts : bundle.GetTexts()){
+            sections.push_back(Section{SectionType::TEXTS, texts.first, 0, 0});
+            data.push_back(texts.second);
+        }
+        for (const auto &script : bundle.GetScripts()){
+            sections.push_back(Section{SectionType::SCRIPT, script.first, 0, 0});
+            data.push_back(script.second);
+        }
+
+        // Header, table of contents and data.
+        uint32 offset = static_cast<uint32>(MAGIC.size()) + 4 + 4;
+        for (const Section &section : sections)
+            offset += static_cast<uint32>(1 + 2 + section.name.size() + 4 + 4);
+        for (size_t s = 0; s < sections.size(); s ++){
+            sections[s].offset = offset;
+            sections[s].size = static_cast<uint32>(data[s].size());
+            offset += sections[s].size;
+        }
+        out.write(MAGIC.data(), MAGIC.size());
+        WriteUInt32(out, VERSION);
+        WriteUInt32(out, static_cast<uint32>(sections.size()));
+        for (const Section &section : sections){
+            WriteUInt8(out, static_cast<uint8>(section.type));
+            WriteString(out, section.name);
+            WriteUInt32(out, section.offset);
+            WriteUInt32(out, section.size);
+        }
+        for (const String &section_data : data) out.write(section_data.data(), section_data.size());
+    }
+
+    void FieldBundleSerializer::ReadFileHeader(
+      Ogre::DataStreamPtr &stream, std::vector<Section> &sections
+    ){
+        String magic(MAGIC.size(), '\0');
+        stream->read(&magic[0], magic.size());
+        if (magic != MAGIC){
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_INVALIDPARAMS, "not a field bundle, wrong magic string",
+              "FieldBundleSerializer::ReadFileHeader"
+            );
+        }
+        uint32 version;
+        ReadUInt32(stream, version);
+        if (version != VERSION){
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_INVALIDPARAMS,
+              "field bundle version " + std::to_string(version) + " is not supported",
+              "FieldBundleSerializer::ReadFileHeader"
+            );
+        }
+        uint32 count;
+        ReadUInt32(stream, count);
+        sections.resize(count);
+        for (Section &section : sections){
+            uint8 type;
+            ReadUInt8(stream, type);
+            section.type = static_cast<SectionType>(type);
+            ReadString(stream, section.name);
+            ReadUInt32(stream, section.offset);
+            ReadUInt32(stream, section.size);
+            if (section.offset + section.size > stream->size()){
+                OGRE_EXCEPT(
+                  Ogre::Exception::ERR_INVALIDPARAMS,
+                  "field bundle section " + section.name + " is out of bounds",
+                  "FieldBundleSerializer::ReadFileHeader"
+                );
+            }
+        }
+    }
+
+    void FieldBundleSerializer::ReadString(Ogre::DataStreamPtr &stream, String &dest){
+        uint16 length;
+        ReadUInt16(stream, length);
+        dest.assign(length, '\0');
+        if (length > 0) stream->read(&dest[0], length);
+    }
+
+    void FieldBundleSerializer::readObject(
+      Ogre::DataStreamPtr &stream, FieldBundle::Record &dest
+    ){
+        uint8 type;
+        ReadUInt8(stream, type);
+        dest.type = static_cast<FieldBundle::RecordType>(type);
+        switch (dest.type){
+            case FieldBundle::RecordType::WALKMESH:
+            case FieldBundle::RecordType::BACKGROUND_2D:
+            case FieldBundle::RecordType::TEXTS:
+            case FieldBundle::RecordType::SCRIPT:
+                ReadString(stream, dest.file_name);
+                break;
+            case FieldBundle::RecordType::MOVEMENT_ROTATION:
+                ReadFloat(stream, dest.angle);
+                break;
+            case FieldBundle::RecordType::ENTITY_MODEL:
+                {
+                    ReadString(stream, dest.name);
+                    ReadString(stream, dest.file_name);
+                    readObject(stream, dest.position);
+                    ReadFloat(stream, dest.angle);
+                    readObject(stream, dest.scale);
+                    readObject(stream, dest.orientation);
+                    sint32 index;
+                    ReadSInt32(stream, index);
+                    dest.index = index;
+                }
+                break;
+            case FieldBundle::RecordType::ENTITY_TRIGGER:
+                ReadString(stream, dest.name);
+                readObject(stream, dest.position);
+                readObject(stream, dest.point2);
+                Read1ByteBool(stream, dest.enabled);
+                break;
+            case FieldBundle::RecordType::ENTITY_POINT:
+                ReadString(stream, dest.name);
+                readObject(stream, dest.position);
+                ReadFloat(stream, dest.angle);
+                break;
+            case FieldBundle::RecordType::ENTITY_SCRIPT:
+                ReadString(stream, dest.name);
+                break;
+            case FieldBundle::RecordType::TRACK:
+                {
+                    sint32 value;
+                    ReadSInt32(stream, value);
+                    dest.index = value;
+                    ReadSInt32(stream, value);
+                    dest.track = value;
+                }
+                break;
+            default:
+                OGRE_EXCEPT(
+                  Ogre::Exception::ERR_INVALIDPARAMS,
+                  "unknown field bundle record type " + std::to_string(type),
+                  "FieldBundleSerializer::readObject"
+                );
+        }
+    }
+
+    void FieldBundleSerializer::readObject(
+      Ogre::DataStreamPtr &stream, FieldBundle::Source &dest
+    ){
+        ReadString(stream, dest.file_name);
+        uint32 low, high;
+        ReadUInt32(stream, low);
+        ReadUInt32(stream, high);
+        dest.size = (static_cast<std::uint64_t>(high) << 32) | low;
+        ReadUInt32(stream, low);
+        ReadUInt32(stream, high);
+        dest.time = static_cast<std::time_t>((static_cast<std::uint64_t>(high) << 32) | low);
+    }
+
+    void FieldBundleSerializer::readObject(
+      Ogre::DataStreamPtr &stream, WalkmeshFile::Triangle &dest
+    ){
+        readObject(stream, dest.a);
+        readObject(stream, dest.b);
+        readObject(stream, dest.c);
+        for (int side = 0; side < 3; side ++){
+            sint32 access;
+            ReadSInt32(stream, access);
+            dest.access_side[side] = access;
+        }
+    }
+
+    void FieldBundleSerializer::readObject(Ogre::DataStreamPtr &stream, Tile &dest){
+        sint32 value;
+        ReadSInt32(stream, value);
+        dest.width = value;
+        ReadSInt32(stream, value);
+        dest.height = value;
+        readObject(stream, dest.destination);
+        readObject(stream, dest.uv);
+        ReadFloat(stream, dest.depth);
+        uint8 blending;
+        ReadUInt8(stream, blending);
+        dest.blending = static_cast<Blending>(blending);
+        uint32 count;
+        ReadUInt32(stream, count);
+        dest.animations.clear();
+        for (uint32 i = 0; i < count; i ++){
+            String name;
+            ReadString(stream, name);
+            Animation &animation(dest.animations[name]);
+            ReadFloat(stream, animation.length);
+            ReadVector(stream, animation.key_frames);
+        }
+    }
+
+    void FieldBundleSerializer::readObject(Ogre::DataStreamPtr &stream, KeyFrame &dest){
+        ReadFloat(stream, dest.time);
+        readObject(stream, dest.uv);
+    }
+
+    void FieldBundleSerializer::readObject(Ogre::DataStreamPtr &stream, Ogre::Vector4 &dest){
+        float tmp[4];
+        readFloats(stream, tmp, 4);
+        dest = Ogre::Vector4(tmp[0], tmp[1], tmp[2], tmp[3]);
+    }
+
+    void FieldBundleSerializer::readObject(Ogre::DataStreamPtr &stream, Ogre::Quaternion &dest){
+        float tmp[4];
+        readFloats(stream, tmp, 4);
+        dest = Ogre::Quaternion(tmp[0], tmp[1], tmp[2], tmp[3]);
+    }
+
+    void FieldBundleSerializer::ReadBackground(
+      Ogre::DataStreamPtr &stream, Background2DFile &dest
+    ){
+        String texture_name;
+        ReadString(stream, texture_name);
+        dest.SetTextureName(texture_name);
+        Ogre::Vector2 clip;
+        readObject(stream, clip);
+        dest.SetClip(clip);
+        Ogre::Vector4 range;
+        readObject(stream, range);
+        dest.SetRange(range);
+        Ogre::Vector3 position;
+        readObject(stream, position);
+        dest.SetPosition(position);
+        Ogre::Quaternion orientation;
+        readObject(stream, orientation);
+        dest.SetOrientation(orientation);
+        float fov;
+        ReadFloat(stream, fov);
+        dest.SetFov(Ogre::Radian(fov));
+        ReadVector(stream, dest.GetTiles());
+    }
+
+    void FieldBundleSerializer::WriteUInt8(std::ostream &out, const uint8 value){
+        out.put(static_cast<char>(value));
+    }
+
+    void FieldBundleSerializer::WriteUInt16(std::ostream &out, const uint16 value){
+        out.put(static_cast<char>(value & 0xFF));
+        out.put(static_cast<char>((value >> 8) & 0xFF));
+    }
+
+    void FieldBundleSerializer::WriteUInt32(std::ostream &out, const uint32 value){
+        for (int i = 0; i < 4; i ++) out.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+
+    void FieldBundleSerializer::WriteUInt64(std::ostream &out, const std::uint64_t value){
+        WriteUInt32(out, static_cast<uint32>(value & 0xFFFFFFFF));
+        WriteUInt32(out, static_cast<uint32>(value >> 32));
+    }
+
+    void FieldBundleSerializer::WriteFloat(std::ostream &out, const float value){
+        uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        WriteUInt32(out, bits);
+    }
+
+    void FieldBundleSerializer::WriteString(std::ostream &out, const String &value){
+        if (value.size() > 0xFFFF){
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_INVALIDPARAMS, "string too long for a field bundle: " + value,
+              "FieldBundleSerializer::WriteString"
+            );
+        }
+        WriteUInt16(out, static_cast<uint16>(value.size()));
+        out.write(value.data(), value.size());
+    }
+
+    void FieldBundleSerializer::WriteRecord(
+      std::ostream &out, const FieldBundle::Record &record
+    ){
+        WriteUInt8(out, static_cast<uint8>(record.type));
+        switch (record.type){
+            case FieldBundle::RecordType::WALKMESH:
+            case FieldBundle::RecordType::BACKGROUND_2D:
+            case FieldBundle::RecordType::TEXTS:
+            case FieldBundle::RecordType::SCRIPT:
+                WriteString(out, record.file_name);
+                break;
+            case FieldBundle::RecordType::MOVEMENT_ROTATION:
+                WriteFloat(out, record.angle);
+                break;
+            case FieldBundle::RecordType::ENTITY_MODEL:
+                WriteString(out, record.name);
+                WriteString(out, record.file_name);
+                for (int i = 0; i < 3; i ++) WriteFloat(out, record.position[i]);
+                WriteFloat(out, record.angle);
+                for (int i = 0; i < 3; i ++) WriteFloat(out, record.scale[i]);
+                for (int i = 0; i < 4; i ++) WriteFloat(out, record.orientation[i]);
+                WriteUInt32(out, static_cast<uint32>(record.index));
+                break;
+            case FieldBundle::RecordType::ENTITY_TRIGGER:
+                WriteString(out, record.name);
+                for (int i = 0; i < 3; i ++) WriteFloat(out, record.position[i]);
+                for (int i = 0; i < 3; i ++) WriteFloat(out, record.point2[i]);
+                WriteUInt8(out, record.enabled ? 1 : 0);
+                break;
+            case FieldBundle::RecordType::ENTITY_POINT:
+                WriteString(out, record.name);
+                for (int i = 0; i < 3; i ++) WriteFloat(out, record.position[i]);
+                WriteFloat(out, record.angle);
+                break;
+            case FieldBundle::RecordType::ENTITY_SCRIPT:
+                WriteString(out, record.name);
+                break;
+            case FieldBundle::RecordType::TRACK:
+                WriteUInt32(out, static_cast<uint32>(record.index));
+                WriteUInt32(out, static_cast<uint32>(record.track));
+                break;
+        }
+    }
+
+    void FieldBundleSerializer::WriteWalkmesh(std::ostream &out, WalkmeshFile &walkmesh){
+        WalkmeshFile::TriangleList &triangles(walkmesh.GetTriangles());
+        WriteUInt32(out, static_cast<uint32>(triangles.size()));
+        for (const WalkmeshFile::Triangle &triangle : triangles){
+            for (int i = 0; i < 3; i ++) WriteFloat(out, triangle.a[i]);
+            for (int i = 0; i < 3; i ++) WriteFloat(out, triangle.b[i]);
+            for (int i = 0; i < 3; i ++) WriteFloat(out, triangle.c[i]);
+            for (int side = 0; side < 3; side ++)
+                WriteUInt32(out, static_cast<uint32>(triangle.access_side[side]));
+        }
+    }
+
+    void FieldBundleSerializer::WriteBackground(
+      std::ostream &out, Background2DFile &background
+    ){
+        WriteString(out, background.GetTextureName());
+        const Ogre::Vector2 clip(background.GetClip());
+        for (int i = 0; i < 2; i ++) WriteFloat(out, clip[i]);
+        const Ogre::Vector4 range(background.GetRange());
+        for (int i = 0; i < 4; i ++) WriteFloat(out, range[i]);
+        const Ogre::Vector3 position(background.GetPosition());
+        for (int i = 0; i < 3; i ++) WriteFloat(out, position[i]);
+        const Ogre::Quaternion orientation(background.GetOrientation());
+        for (int i = 0; i < 4; i ++) WriteFloat(out, orientation[i]);
+        WriteFloat(out, background.GetFov().valueRadians());
+        const Background2DFile::TileList &tiles(background.GetTiles());
+        WriteUInt32(out, static_cast<uint32>(tiles.size()));
+        for (const Tile &tile : tiles){
+            WriteUInt32(out, static_cast<uint32>(tile.width));
+            WriteUInt32(out, static_cast<uint32>(tile.height));
+            for (int i = 0; i < 2; i ++) WriteFloat(out, tile.destination[i]);
+            for (int i = 0; i < 4; i ++) WriteFloat(out, tile.uv[i]);
+            WriteFloat(out, tile.depth);
+            WriteUInt8(out, static_cast<uint8>(tile.blending));
+            WriteUInt32(out, static_cast<uint32>(tile.animations.size()));
+            for (const auto &animation : tile.animations){
+                WriteString(out, animation.first);
+                WriteFloat(out, animation.second.length);
+                WriteUInt32(out, static_cast<uint32>(animation.second.key_frames.size()));
+                for (const KeyFrame &key_frame : animation.second.key_frames){
+                    WriteFloat(out, key_frame.time);
+                    for (int i = 0; i < 4; i ++) WriteFloat(out, key_frame.uv[i]);
+                }
+            }
+        }
+    }
+
+}
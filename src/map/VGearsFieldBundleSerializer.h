@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "common/TypeDefine.h"
+#include "data/VGearsSerializer.h"
+#include "map/VGearsFieldBundle.h"
+
+namespace VGears{
+
+    /**
+     * Handles the serialization of field bundles.
+     *
+     * A bundle starts with a header: the magic string, the format version and the number of
+     * sections. The header is followed by the table of contents, with the type, name, offset
+     * and size of every section, and then by the sections data. All values are little endian.
+     * Strings are stored as a 16 bit length followed by the characters.
+     */
+    class FieldBundleSerializer : public Serializer{
+
+        public:
+
+            /**
+             * Constructor.
+             */
+            FieldBundleSerializer();
+
+            /**
+             * Destructor.
+             */
+            virtual ~FieldBundleSerializer();
+
+            /**
+             * Imports a field bundle.
+             *
+             * Sections of unknown types are skipped.
+             *
+             * @param[in] stream The contents of the bundle file.
+             * @param[out] dest The formed bundle.
+             * @throws Ogre::Exception If the stream is not a bundle, or it was written with a
+             * different version of the format.
+             */
+            virtual void ImportFieldBundle(Ogre::DataStreamPtr &stream, FieldBundle *dest);
+
+            /**
+             * Exports a field bundle.
+             *
+             * @param[out] out The stream to write the bundle to.
+             * @param[in] bundle The bundle to write.
+             */
+            virtual void ExportFieldBundle(std::ostream &out, const FieldBundle &bundle);
+
+            /**
+             * Types of sections.
+             */
+            enum class SectionType : uint8{
+
+                /**
+                 * List of source files. Name is empty.
+                 */
+                SOURCES = 0,
+
+                /**
+                 * Map records. Name is empty.
+                 */
+                MAP = 1,
+
+                /**
+                 * A walkmesh. Name is the walkmesh file name.
+                 */
+                WALKMESH = 2,
+
+                /**
+                 * A background. Name is the background file name.
+                 */
+                BACKGROUND_2D = 3,
+
+                /**
+                 * A texts XML file. Name is the texts file name.
+                 */
+                TEXTS = 4,
+
+                /**
+                 * A Lua chunk. Name is the script file name.
+                 */
+                SCRIPT = 5,
+
+                /**
+                 * Names of the fields the gateways lead to. Name is empty.
+                 */
+                GATEWAYS = 6
+            };
+
+            /**
+             * An entry in the table of contents.
+             */
+            struct Section{
+
+                /**
+                 * Section type.
+                 */
+                SectionType type;
+
+                /**
+                 * Section name.
+                 */
+                String name;
+
+                /**
+                 * Offset of the section data, from the start of the file.
+                 */
+                uint32 offset;
+
+                /**
+                 * Size of the section data.
+                 */
+                uint32 size;
+            };
+
+        protected:
+
+            /**
+             * Bundle files start with this string.
+             */
+            static const String MAGIC;
+
+            /**
+             * Version of the format. Bundles with any other version are rejected.
+             */
+            static const uint32 VERSION;
+
+            /**
+             * Reads the header and the table of contents.
+             *
+             * @param[in] stream The contents of the bundle file.
+             * @param[out] sections The table of contents.
+             */
+            virtual void ReadFileHeader(
+              Ogre::DataStreamPtr &stream, std::vector<Section> &sections
+            );
+
+            /**
+             * Reads a string.
+             *
+             * @param[in] stream Input data.
+             * @param[out] dest The string.
+             */
+            virtual void ReadString(Ogre::DataStreamPtr &stream, String &dest);
+
+            /**
+             * Reads an object as a map record.
+             *
+             * @param[in] stream Input data.
+             * @param[out] dest The formed record.
+             */
+            virtual void readObject(Ogre::DataStreamPtr &stream, FieldBundle::Record &dest);
+
+            /**
+             * Reads an object as a source file.
+             *
+             * @param[in] stream Input data.
+             * @param[out] dest The formed source file entry.
+             */
+            virtual void readObject(Ogre::DataStreamPtr &stream, FieldBundle::Source &dest);
+
+            /**
+             * Reads an object as a walkmesh triangle.
+             *
+             * @param[in] stream Input data.
+             * @param[out] dest The formed triangle.
+             */
+            virtual void readObject(Ogre::DataStreamPtr &stream, WalkmeshFile::Triangle &dest);
+
+            /**
+             * Reads an object as a background tile.
+             *
+             * @param[in] stream Input data.
+             * @param[out] dest The formed tile.
+             */
+            virtual void readObject(Ogre::DataStreamPtr &stream, Tile &dest);
+
+            /**
+             * Reads an object as a background animation keyframe.
+             *
+             * @param[in] stream Input data.
+             * @param[out] dest The formed keyframe.
+             */
+            virtual void readObject(Ogre::DataStreamPtr &stream, KeyFrame &dest);
+
+            /**
+             * Reads an object as a four dimensional vector.
+             *
+             * @param[in] stream Input data.
+             * @param[out] dest The formed vector.
+             */
+            virtual void readObject(Ogre::DataStreamPtr &stream, Ogre::Vector4 &dest);
+
+            /**
+             * Reads an object as a quaternion.
+             *
+             * @param[in] stream Input data.
+             * @param[out] dest The formed quaternion.
+             */
+            virtual void readObject(Ogre::DataStreamPtr &stream, Ogre::Quaternion &dest);
+
+            using Serializer::readObject;
+
+            /**
+             * Reads a background.
+             *
+             * @param[in] stream Input data.
+             * @param[out] dest The background to fill.
+             */
+            virtual void ReadBackground(Ogre::DataStreamPtr &stream, Background2DFile &dest);
+
+            /**
+             * Reads a stream as a vector, preceded by its 32 bit size.
+             *
+             * @param[in] stream The input stream.
+             * @param[out] dest The vector data will be loaded here.
+             */
+            template<typename ValueType> void ReadVector(
+              Ogre::DataStreamPtr &stream, std::vector<ValueType> &dest
+            ){
+                uint32 count;
+                ReadUInt32(stream, count);
+                dest.clear();
+                dest.reserve(count);
+                for (uint32 i = 0; i < count; i ++){
+                    ValueType in_tmp;
+                    readObject(stream, in_tmp);
+                    dest.push_back(in_tmp);
+                }
+            }
+
+            /**
+             * Writes an 8 bit unsigned integer.
+             *
+             * @param[out] out The output stream.
+             * @param[in] value The value to write.
+             */
+            static void WriteUInt8(std::ostream &out, const uint8 value);
+
+            /**
+             * Writes a 16 bit unsigned integer.
+             *
+             * @param[out] out The output stream.
+             * @param[in] value The value to write.
+             */
+            static void WriteUInt16(std::ostream &out, const uint16 value);
+
+            /**
+             * Writes a 32 bit unsigned integer.
+             *
+             * @param[out] out The output stream.
+             * @param[in] value The value to write.
+             */
+            static void WriteUInt32(std::ostream &out, const uint32 value);
+
+            /**
+             * Writes a 64 bit unsigned integer.
+             *
+             * @param[out] out The output stream.
+             * @param[in] value The value to write.
+             */
+            static void WriteUInt64(std::ostream &out, const std::uint64_t value);
+
+            /**
+             * Writes a float.
+             *
+             * @param[out] out The output stream.
+             * @param[in] value The value to write.
+             */
+            static void WriteFloat(std::ostream &out, const float value);
+
+            /**
+             * Writes a string, preceded by its length.
+             *
+             * @param[out] out The output stream.
+             * @param[in] value The string to write.
+             */
+            static void WriteString(std::ostream &out, const String &value);
+
+            /**
+             * Writes a map record.
+             *
+             * @param[out] out The output stream.
+             * @param[in] record The record to write.
+             */
+            static void WriteRecord(std::ostream &out, const FieldBundle::Record &record);
+
+            /**
+             * Writes a walkmesh.
+             *
+             * @param[out] out The output stream.
+             * @param[in] walkmesh The walkmesh to write.
+             */
+            static void WriteWalkmesh(std::ostream &out, WalkmeshFile &walkmesh);
+
+            /**
+             * Writes a background.
+             *
+             * @param[out] out The output stream.
+             * @param[in] background The background to write.
+             */
+            static void WriteBackground(std::ostream &out, Background2DFile &background);
+    };
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <OgreException.h>
+#include <OgreLogManager.h>
+#include "map/VGearsFieldBundleXMLSerializer.h"
+
+namespace VGears{
+
+    FieldBundleXMLSerializer::FieldBundleXMLSerializer() : XMLSerializer(){}
+
+    FieldBundleXMLSerializer::~FieldBundleXMLSerializer(){}
+
+    void FieldBundleXMLSerializer::ImportMapFile(Ogre::DataStreamPtr &stream, FieldBundle *dest){
+        TiXmlDocument document;
+        Parse(stream, document);
+        ReadMap(document.RootElement(), dest);
+    }
+
+    void FieldBundleXMLSerializer::ReadMap(TiXmlNode *node, FieldBundle *dest){
+        ReadHeader(node);
+        for (TiXmlNode* child = node->FirstChild(); child != nullptr; child = child->NextSibling())
+            if (child->Type() == TiXmlNode::TINYXML_ELEMENT) readObject(*child, dest);
+    }
+
+    void FieldBundleXMLSerializer::ReadHeader(TiXmlNode *node){
+        if (node == nullptr || node->ValueStr() != "map"){
+            OGRE_EXCEPT(
+              Ogre::Exception::ERR_INVALIDPARAMS, "not a valid map file, no <map> in root",
+              "FieldBundleXMLSerializer::ReadHeader"
+            );
+        }
+    }
+
+    void FieldBundleXMLSerializer::readObject(TiXmlNode &node, FieldBundle *dest){
+        const String &tag(node.ValueStr());
+        FieldBundle::Record record;
+        if (tag == "walkmesh" || tag == "background2d" || tag == "texts" || tag == "script"){
+            if (tag == "walkmesh") record.type = FieldBundle::RecordType::WALKMESH;
+            else if (tag == "background2d") record.type = FieldBundle::RecordType::BACKGROUND_2D;
+            else if (tag == "texts") record.type = FieldBundle::RecordType::TEXTS;
+            else record.type = FieldBundle::RecordType::SCRIPT;
+            ReadAttribute(node, "file_name", record.file_name);
+            if (record.file_name.empty()) return;
+        }
+        else if (tag == "movement_rotation"){
+            record.type = FieldBundle::RecordType::MOVEMENT_ROTATION;
+            ReadAttribute(node, "degree", record.angle);
+        }
+        else if (tag == "entity_model"){
+            record.type = FieldBundle::RecordType::ENTITY_MODEL;
+            if (!ReadRequiredAttribute(node, "name", record.name)) return;
+            if (!ReadRequiredAttribute(node, "file_name", record.file_name)) return;
+            ReadAttribute(node, "position", record.position);
+            ReadAttribute(node, "direction", record.angle);
+            ReadAttribute(node, "scale", record.scale, Ogre::Vector3::UNIT_SCALE);
+            ReadAttribute(node, "root_orientation", record.orientation);
+            ReadAttribute(node, "index", record.index);
+        }
+        else if (tag == "entity_trigger"){
+            record.type = FieldBundle::RecordType::ENTITY_TRIGGER;
+            if (!ReadRequiredAttribute(node, "name", record.name)) return;
+            ReadAttribute(node, "point1", record.position);
+            ReadAttribute(node, "point2", record.point2);
+            ReadAttribute(node, "enabled", record.enabled);
+        }
+        else if (tag == "entity_point"){
+            record.type = FieldBundle::RecordType::ENTITY_POINT;
+            if (!ReadRequiredAttribute(node, "name", record.name)) return;
+            ReadAttribute(node, "position", record.position);
+            ReadAttribute(node, "rotation", record.angle);
+        }
+        else if (tag == "entity_script"){
+            record.type = FieldBundle::RecordType::ENTITY_SCRIPT;
+            if (!ReadRequiredAttribute(node, "name", record.name)) return;
+        }
+        else if (tag == "tracks"){
+            record.type = FieldBundle::RecordType::TRACK;
+            for (TiXmlNode* track = node.FirstChild(); track; track = track->NextSibling()){
+                if (track->Type() != TiXmlNode::TINYXML_ELEMENT) continue;
+                ReadAttribute(*track, "id", record.index);
+                ReadAttribute(*track, "track_id", record.track);
+                dest->GetRecords().push_back(record);
+            }
+            return;
+        }
+        else return;
+        dest->GetRecords().push_back(record);
+    }
+
+    bool FieldBundleXMLSerializer::ReadRequiredAttribute(
+      TiXmlNode &node, const String &attribute, String &dest
+    ){
+        ReadAttribute(node, attribute, dest);
+        if (!dest.empty()) return true;
+        Ogre::LogManager::getSingleton().stream()
+          << "There is no " << attribute << " specified for <" << node.ValueStr() << "> tag.";
+        return false;
+    }
+
+}
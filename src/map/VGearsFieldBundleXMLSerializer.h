@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "common/TypeDefine.h"
+#include "data/VGearsXMLSerializer.h"
+#include "map/VGearsFieldBundle.h"
+
+namespace VGears{
+
+    /**
+     * Reads map XML files into field bundle records.
+     *
+     * Only the map file itself is read. The files it references are not opened.
+     */
+    class FieldBundleXMLSerializer : public XMLSerializer{
+
+        public:
+
+            /**
+             * Constructor.
+             */
+            FieldBundleXMLSerializer();
+
+            /**
+             * Destructor.
+             */
+            virtual ~FieldBundleXMLSerializer();
+
+            /**
+             * Imports a map XML file.
+             *
+             * @param[in] stream The contents of the map file.
+             * @param[out] dest The bundle to add the map records to.
+             * @throws Ogre::Exception If the file is not a map file.
+             */
+            virtual void ImportMapFile(Ogre::DataStreamPtr &stream, FieldBundle *dest);
+
+            /**
+             * Reads the map records from an already parsed map XML file.
+             *
+             * Tags without a required attribute are reported and skipped.
+             *
+             * @param[in] node The root node of the map file.
+             * @param[out] dest The bundle to add the map records to.
+             * @throws Ogre::Exception If the node is not a map node.
+             */
+            virtual void ReadMap(TiXmlNode *node, FieldBundle *dest);
+
+        protected:
+
+            /**
+             * Checks that a node is the root of a map file.
+             *
+             * @param[in] node The XML node to check.
+             * @throws Ogre::Exception If the node is not a map node.
+             */
+            virtual void ReadHeader(TiXmlNode *node);
+
+            /**
+             * Reads an XML node as a map record.
+             *
+             * @param[in] node The XML node to read.
+             * @param[out] dest The bundle to add the records to. Track lists add one record per
+             * track.
+             */
+            virtual void readObject(TiXmlNode &node, FieldBundle *dest);
+
+            /**
+             * Reads a required attribute.
+             *
+             * Logs an error if the attribute is missing or empty.
+             *
+             * @param[in] node The XML node to read.
+             * @param[in] attribute The name of the attribute.
+             * @param[out] dest The attribute value.
+             * @return True if the attribute is set, false otherwise.
+             */
+            bool ReadRequiredAttribute(TiXmlNode &node, const String &attribute, String &dest);
+    };
+}
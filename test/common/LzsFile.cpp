@@ -13,14 +13,54 @@
  * GNU General Public License for more details.
  */
 
+#include <random>
+#include <string>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include "common/LzsFile.h"
 
-#pragma message("Unimplemented test file: " __FILE__)
-
-BOOST_AUTO_TEST_CASE(TestLzsFile){
-    // TODO
-    BOOST_WARN_MESSAGE(false, "Unimplemented test file: LzsFile");
-    BOOST_CHECK(0 == 0);
+BOOST_AUTO_TEST_CASE(TestLzsFileRoundTrip){
+    std::mt19937 random(7);
+    std::vector<std::vector<VGears::uint8>> inputs;
+    inputs.push_back(std::vector<VGears::uint8>());
+    inputs.push_back(std::vector<VGears::uint8>(1, 0x42));
+    // Long runs, to test overlapping references and the maximum reference length.
+    inputs.push_back(std::vector<VGears::uint8>(10000, 0));
+    // Repeated text, with references across the whole window.
+    std::vector<VGears::uint8> text;
+    const std::string words[] = {"field ", "script ", "walkmesh ", "entity ", "background "};
+    while (text.size() < 20000)
+        for (char c : words[random() % 5]) text.push_back(static_cast<VGears::uint8>(c));
+    inputs.push_back(text);
+    // Incompressible data.
+    std::vector<VGears::uint8> noise(5000);
+    for (VGears::uint8& byte : noise) byte = static_cast<VGears::uint8>(random());
+    inputs.push_back(noise);
+    for (const auto& input : inputs){
+        for (
+          LzsBuffer::CompressionMode mode
+            : {LzsBuffer::CompressionMode::GREEDY, LzsBuffer::CompressionMode::HASH_CHAIN}
+        ){
+            std::vector<VGears::uint8> compressed = LzsBuffer::Compress(input, mode);
+            BOOST_REQUIRE(compressed.size() >= 4);
+            VGears::uint32 header = compressed[0] | (compressed[1] << 8)
+              | (compressed[2] << 16) | (compressed[3] << 24);
+            BOOST_CHECK(header == compressed.size() - 4);
+            BOOST_CHECK(LzsBuffer::Decompress(compressed) == input);
+        }
+    }
 }
 
+BOOST_AUTO_TEST_CASE(TestLzsFileCompressionModes){
+    std::mt19937 random(11);
+    std::vector<VGears::uint8> data;
+    const std::string words[] = {"cloud ", "tifa ", "barret ", "aeris ", "red ", "cid "};
+    while (data.size() < 50000)
+        for (char c : words[random() % 6]) data.push_back(static_cast<VGears::uint8>(c));
+    std::vector<VGears::uint8> greedy
+      = LzsBuffer::Compress(data, LzsBuffer::CompressionMode::GREEDY);
+    std::vector<VGears::uint8> hash_chain
+      = LzsBuffer::Compress(data, LzsBuffer::CompressionMode::HASH_CHAIN);
+    BOOST_CHECK(greedy.size() < data.size());
+    BOOST_CHECK(hash_chain.size() <= greedy.size());
+}
@@ -13,14 +13,91 @@
  * GNU General Public License for more details.
  */
 
+#include <random>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include "core/UiAnimation.h"
 
-#pragma message("Unimplemented test file: " __FILE__)
+/**
+ * Samples keyframes by scanning all of them, as UiAnimation used to.
+ *
+ * @param[in] data The keyframes, in the order they were added.
+ * @param[in] time Animation time to sample at.
+ * @param[in] length Animation length.
+ * @return The interpolated value.
+ */
+template <typename KeyFrame> static decltype(KeyFrame::value) LinearGetValue(
+  const std::vector<KeyFrame>& data, const float time, const float length
+){
+    decltype(KeyFrame::value) min_value = data[0].value;
+    decltype(KeyFrame::value) max_value = min_value;
+    float min = 0;
+    float max = length;
+    for (unsigned int i = 0; i < data.size(); ++ i){
+        if (data[i].time < time && data[i].time > min){
+            min_value = data[i].value;
+            min = data[i].time;
+        }
+        if (data[i].time >= time && data[i].time <= max){
+            max_value = data[i].value;
+            max = data[i].time;
+        }
+    }
+    if (time == 0) return min_value;
+    return min_value + (max_value - min_value) * ((time - min) / (max - min));
+}
 
-BOOST_AUTO_TEST_CASE(TestUiAnimation){
-    // TODO
-    BOOST_WARN_MESSAGE(false, "Unimplemented test file: UiAnimation");
-    BOOST_CHECK(0 == 0);
+BOOST_AUTO_TEST_CASE(TestUiKeyFrameTrackInterpolation){
+    UiKeyFrameTrack<UiKeyFrameFloat> track;
+    BOOST_CHECK(track.IsEmpty());
+    // Added out of order.
+    track.AddKeyFrame(UiKeyFrameFloat{1, 10});
+    track.AddKeyFrame(UiKeyFrameFloat{0, 0});
+    track.AddKeyFrame(UiKeyFrameFloat{2, 30});
+    BOOST_CHECK(!track.IsEmpty());
+    // Intentional, as in the linear scan: a keyframe at time 0 is never the previous one, so
+    // before the first keyframe after 0 the value of the first keyframe added is held.
+    BOOST_CHECK(track.GetValue(0, 2) == 10);
+    BOOST_CHECK(track.GetValue(0.5f, 2) == 10);
+    BOOST_CHECK(track.GetValue(1, 2) == 10);
+    BOOST_CHECK(track.GetValue(1.5f, 2) == 20);
+    BOOST_CHECK(track.GetValue(1.75f, 2) == 25);
+    BOOST_CHECK(track.GetValue(2, 2) == 30);
+    // Going back in time.
+    BOOST_CHECK(track.GetValue(1.5f, 2) == 20);
+    BOOST_CHECK(track.GetValue(0.5f, 2) == 10);
 }
 
+BOOST_AUTO_TEST_CASE(TestUiKeyFrameTrackEquivalence){
+    // Compare with the linear scan, with keyframes added in any order, repeated times, times
+    // after the animation length, and samples both playing forward and jumping around.
+    std::mt19937 random(1);
+    for (int a = 0; a < 500; ++ a){
+        const float length = (random() % 8) / 2.0f + 0.5f;
+        std::vector<UiKeyFrameFloat> floats;
+        std::vector<UiKeyFrameVector2> vectors;
+        UiKeyFrameTrack<UiKeyFrameFloat> float_track;
+        UiKeyFrameTrack<UiKeyFrameVector2> vector_track;
+        const int count = 1 + random() % 8;
+        for (int k = 0; k < count; ++ k){
+            const float time = (random() % 12) / 4.0f;
+            floats.push_back(UiKeyFrameFloat{time, static_cast<float>(random() % 100)});
+            float_track.AddKeyFrame(floats.back());
+            vectors.push_back(
+              UiKeyFrameVector2{
+                time,
+                Ogre::Vector2(static_cast<float>(random() % 50), static_cast<float>(random() % 50))
+              }
+            );
+            vector_track.AddKeyFrame(vectors.back());
+        }
+        for (int s = 0; s < 40; ++ s){
+            const float time
+              = s < 20 ? s * length / 19 : (random() % 101) / 100.0f * length;
+            BOOST_CHECK(float_track.GetValue(time, length) == LinearGetValue(floats, time, length));
+            BOOST_CHECK(
+              vector_track.GetValue(time, length) == LinearGetValue(vectors, time, length)
+            );
+        }
+    }
+}
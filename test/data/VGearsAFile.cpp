@@ -16,11 +16,105 @@
 #include <boost/test/unit_test.hpp>
 #include "data/VGearsAFile.h"
 
-#pragma message("Unimplemented test file: " __FILE__)
+/**
+ * Number of bones in the test animation.
+ */
+static const VGears::uint32 BONE_COUNT = 3;
+
+/**
+ * Number of frames in the test animation.
+ */
+static const size_t FRAME_COUNT = 10;
+
+/**
+ * Tolerance when comparing rotations.
+ *
+ * Quantization error is below 0.003 degrees, but Ogre::Quaternion::equals computes the angle in
+ * single precision, and can't resolve much less than 0.05 degrees.
+ */
+static const Ogre::Radian TOLERANCE(Ogre::Degree(0.1f));
+
+/**
+ * Converts Euler angles to a quaternion, as AFile used to set them in key frames.
+ *
+ * @param[in] rotation Euler angles, in degrees.
+ * @return The rotation.
+ */
+static Ogre::Quaternion ToQuaternion(const Ogre::Vector3& rotation){
+    Ogre::Quaternion quaternion;
+    Ogre::Matrix3 matrix;
+    matrix.FromEulerAnglesZXY(
+      Ogre::Radian(Ogre::Degree(-rotation.y)), Ogre::Radian(Ogre::Degree(-rotation.x)),
+      Ogre::Radian(Ogre::Degree(-rotation.z))
+    );
+    quaternion.FromRotationMatrix(matrix);
+    return quaternion;
+}
 
-BOOST_AUTO_TEST_CASE(TestVGearsAFile){
-    // TODO
-    BOOST_WARN_MESSAGE(false, "Unimplemented test file: VGearsAFile");
-    BOOST_CHECK(0 == 0);
+/**
+ * Builds the frames of the test animation.
+ *
+ * The root translation and the rotation of bones 0 and 2 don't change. The root rotation and the
+ * rotation of bone 1 change in every frame.
+ *
+ * @return The frames.
+ */
+static VGears::AFile::FrameList BuildFrames(){
+    VGears::AFile::FrameList frames(FRAME_COUNT);
+    for (size_t f = 0; f < FRAME_COUNT; f ++){
+        frames[f].root_translation = Ogre::Vector3(1, 2, 3);
+        frames[f].root_rotation = Ogre::Vector3(f * 10.0f, 0, -90);
+        frames[f].bone_rotations.push_back(Ogre::Vector3(45, 0, 0));
+        frames[f].bone_rotations.push_back(Ogre::Vector3(0, -f * 15.5f, 370));
+        frames[f].bone_rotations.push_back(Ogre::Vector3(0, 0, 0));
+    }
+    return frames;
 }
 
+BOOST_AUTO_TEST_CASE(TestVGearsAFileQuantize){
+    const Ogre::Vector3 rotations[] = {
+      Ogre::Vector3(0, 0, 0), Ogre::Vector3(90, -45, 180), Ogre::Vector3(-720.5f, 359.9f, 12.3f)
+    };
+    for (const Ogre::Vector3& rotation : rotations){
+        const Ogre::Quaternion expected = ToQuaternion(rotation);
+        const Ogre::Quaternion actual
+          = VGears::AFile::ToQuaternion(VGears::AFile::Quantize(rotation));
+        BOOST_CHECK(expected.equals(actual, TOLERANCE));
+    }
+    BOOST_CHECK(
+      VGears::AFile::Quantize(Ogre::Vector3(-90, 360, 0))
+      == VGears::AFile::Quantize(Ogre::Vector3(270, 0, 0))
+    );
+}
+
+BOOST_AUTO_TEST_CASE(TestVGearsAFileSetFrames){
+    VGears::AFile a_file(nullptr, "test.a", 0, "General");
+    const VGears::AFile::FrameList frames = BuildFrames();
+    a_file.SetBoneCount(BONE_COUNT);
+    a_file.SetFrames(frames);
+    BOOST_CHECK_EQUAL(a_file.GetBoneCount(), BONE_COUNT);
+    BOOST_CHECK_EQUAL(a_file.GetFrameCount(), FRAME_COUNT);
+    BOOST_CHECK(!a_file.IsBoneAnimated(0));
+    BOOST_CHECK(a_file.IsBoneAnimated(1));
+    BOOST_CHECK(!a_file.IsBoneAnimated(2));
+
+    // A translation, the root rotation and bone 1 for each frame, one rotation for the others.
+    BOOST_CHECK_EQUAL(
+      a_file.CalculateSize(),
+      sizeof(Ogre::Vector3) + sizeof(VGears::AFile::QuantizedRotation) * (FRAME_COUNT * 2 + 2)
+    );
+
+    for (size_t f = 0; f < FRAME_COUNT; f ++){
+        BOOST_CHECK(a_file.GetRootTranslation(f) == frames[f].root_translation);
+        BOOST_CHECK(
+          a_file.GetRootRotation(f).equals(ToQuaternion(frames[f].root_rotation), TOLERANCE)
+        );
+        for (VGears::uint32 b = 0; b < BONE_COUNT; b ++){
+            BOOST_CHECK(
+              a_file.GetBoneRotation(b, f).equals(
+                ToQuaternion(frames[f].bone_rotations[b]), TOLERANCE
+              )
+            );
+        }
+    }
+}
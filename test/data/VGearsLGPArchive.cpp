@@ -13,14 +13,107 @@
  * GNU General Public License for more details.
  */
 
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
 #include <boost/test/unit_test.hpp>
+#include <OgreLogManager.h>
 #include "data/VGearsLGPArchive.h"
+#include "data/VGearsLGPArchiveSerializer.h"
 
-#pragma message("Unimplemented test file: " __FILE__)
+/**
+ * Reads a whole file from an archive.
+ *
+ * @param[in] archive The archive.
+ * @param[in] name Name of the file.
+ * @return The contents of the file.
+ */
+static std::string ReadArchiveFile(const VGears::LGPArchive& archive, const std::string& name){
+    Ogre::DataStreamPtr stream(archive.open(name));
+    if (stream == nullptr) return "<missing>";
+    std::string contents(stream->size(), '\0');
+    stream->read(&contents[0], contents.size());
+    return contents;
+}
+
+BOOST_AUTO_TEST_CASE(TestVGearsLGPArchiveWrite){
+    std::unique_ptr<Ogre::LogManager> log_manager;
+    if (Ogre::LogManager::getSingletonPtr() == nullptr){
+        log_manager.reset(new Ogre::LogManager());
+        log_manager->createLog("test.log", true, false, true);
+    }
+    const std::string path("test_archive.lgp");
+    std::map<std::string, std::string> files = {
+      {"aaab.tex", "first"},
+      {"aaac.rsd", std::string(1000, 'x')},
+      {"fields/md1_1.xml", "<map/>"},
+      {"models/md1_1.xml", "<model/>"},
+      {"0123_-.bin", std::string("\0\1\2", 3)}
+    };
+    std::vector<std::string> names;
+    for (const auto& file : files) names.push_back(file.first);
+    VGears::LGPArchiveSerializer::SortByLocality(names);
+    {
+        std::ofstream out(path, std::ofstream::binary);
+        VGears::LGPArchiveSerializer serializer;
+        serializer.ExportLGPArchive(out, names, [&files](const Ogre::String& name){
+            std::string& data = files[name];
+            return Ogre::DataStreamPtr(
+              new Ogre::MemoryDataStream(&data[0], data.size(), false, true)
+            );
+        });
+    }
 
-BOOST_AUTO_TEST_CASE(TestVGearsLGPArchive){
-    // TODO
-    BOOST_WARN_MESSAGE(false, "Unimplemented test file: VGearsLGPArchive");
-    BOOST_CHECK(0 == 0);
+    // Read it back, including files with the same name in different directories.
+    {
+        VGears::LGPArchive archive(path, "LGP");
+        archive.load();
+        BOOST_CHECK(archive.GetFiles().size() == files.size());
+        for (const auto& file : files){
+            BOOST_CHECK(archive.exists(file.first));
+            BOOST_CHECK(ReadArchiveFile(archive, file.first) == file.second);
+        }
+    }
+
+    // Add, replace and remove files.
+    {
+        VGears::LGPArchive archive(path, "LGP", false);
+        archive.load();
+        Ogre::DataStreamPtr created(archive.create("new.txt"));
+        created->write("new file", 8);
+        created->close();
+        created = archive.create("aaab.tex");
+        created->write("replaced", 8);
+        created->close();
+        archive.remove("aaac.rsd");
+        BOOST_CHECK(ReadArchiveFile(archive, "new.txt") == "new file");
+        BOOST_CHECK(ReadArchiveFile(archive, "aaab.tex") == "replaced");
+        BOOST_CHECK(!archive.exists("aaac.rsd"));
+        BOOST_CHECK(ReadArchiveFile(archive, "fields/md1_1.xml") == "<map/>");
+        BOOST_CHECK(archive.GetFiles().size() == files.size());
+    }
+    std::remove(path.c_str());
+
+    // Names that don't fit in the table of contents are rejected.
+    std::ofstream out(path, std::ofstream::binary);
+    VGears::LGPArchiveSerializer serializer;
+    BOOST_CHECK_THROW(
+      serializer.ExportLGPArchive(
+        out, {"a_name_too_long_for_lgp.txt"},
+        [](const Ogre::String&){return Ogre::DataStreamPtr();}
+      ),
+      Ogre::Exception
+    );
+    out.close();
+    std::remove(path.c_str());
 }
 
+BOOST_AUTO_TEST_CASE(TestVGearsLGPArchiveLookup){
+    BOOST_CHECK(VGears::LGPArchiveSerializer::GetLookupIndex("aa") == 1);
+    BOOST_CHECK(VGears::LGPArchiveSerializer::GetLookupIndex("a.") == 0);
+    BOOST_CHECK(VGears::LGPArchiveSerializer::GetLookupIndex("Ba") == 31);
+    BOOST_CHECK(VGears::LGPArchiveSerializer::GetLookupIndex("1_") == 1 * 30 + 10 + 1);
+    BOOST_CHECK(VGears::LGPArchiveSerializer::GetLookupIndex("!a") == -1);
+}
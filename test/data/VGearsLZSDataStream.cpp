@@ -13,14 +13,61 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
+#include <random>
+#include <vector>
 #include <boost/test/unit_test.hpp>
+#include "common/LzsFile.h"
 #include "data/VGearsLZSDataStream.h"
 
-#pragma message("Unimplemented test file: " __FILE__)
-
-BOOST_AUTO_TEST_CASE(TestVGearsLZSDataStream){
-    // TODO
-    BOOST_WARN_MESSAGE(false, "Unimplemented test file: VGearsLZSDataStream");
-    BOOST_CHECK(0 == 0);
+BOOST_AUTO_TEST_CASE(TestVGearsLZSDataStreamRoundTrip){
+    std::mt19937 random(3);
+    std::vector<VGears::uint8> data(30000);
+    // Small alphabet with some noise, so there are both literals and references.
+    for (VGears::uint8& byte : data)
+        byte = static_cast<VGears::uint8>(random() % 4 == 0 ? random() : random() % 6);
+    std::vector<VGears::uint8> compressed = LzsBuffer::Compress(data);
+    Ogre::DataStreamPtr compressed_stream(
+      new Ogre::MemoryDataStream(compressed.data(), compressed.size(), false, true)
+    );
+    VGears::LZSDataStream stream(compressed_stream);
+    std::vector<VGears::uint8> decompressed(data.size());
+    // Read in uneven chunks, to cross the ring buffer boundaries.
+    size_t total = 0;
+    while (!stream.eof() && total < decompressed.size()){
+        total += stream.read(
+          decompressed.data() + total, std::min<size_t>(777, decompressed.size() - total)
+        );
+    }
+    BOOST_CHECK(total == data.size());
+    BOOST_CHECK(stream.tell() == data.size());
+    BOOST_CHECK(stream.eof());
+    BOOST_CHECK(decompressed == data);
 }
 
+BOOST_AUTO_TEST_CASE(TestVGearsLZSDataStreamSeek){
+    std::mt19937 random(5);
+    // Big enough to have several checkpoints.
+    std::vector<VGears::uint8> data(300000);
+    for (VGears::uint8& byte : data)
+        byte = static_cast<VGears::uint8>(random() % 4 == 0 ? random() : random() % 6);
+    std::vector<VGears::uint8> compressed = LzsBuffer::Compress(data);
+    Ogre::DataStreamPtr compressed_stream(
+      new Ogre::MemoryDataStream(compressed.data(), compressed.size(), false, true)
+    );
+    VGears::LZSDataStream stream(compressed_stream);
+    for (int i = 0; i < 200; i ++){
+        const size_t position = random() % data.size();
+        const size_t count = random() % 2000;
+        // Alternate between seek and skip, forwards and backwards.
+        if (i % 2 == 0) stream.seek(position);
+        else stream.skip(static_cast<long>(position) - static_cast<long>(stream.tell()));
+        BOOST_REQUIRE(stream.tell() == position);
+        std::vector<VGears::uint8> read(count);
+        const size_t read_count = stream.read(read.data(), count);
+        BOOST_REQUIRE(read_count == std::min(count, data.size() - position));
+        BOOST_CHECK(std::equal(read.begin(), read.begin() + read_count, data.begin() + position));
+    }
+    stream.seek(data.size());
+    BOOST_CHECK(stream.eof());
+}
@@ -13,14 +13,190 @@
  * GNU General Public License for more details.
  */
 
+#include <set>
+#include <vector>
 #include <boost/test/unit_test.hpp>
+#include "data/VGearsHRCFile.h"
 #include "data/VGearsPFile.h"
 
-#pragma message("Unimplemented test file: " __FILE__)
+/**
+ * Size of the test grid, in squares on each side.
+ */
+static const int GRID_SIZE = 4;
+
+/**
+ * Number of vertices on each side of the test grid.
+ */
+static const int GRID_VERTICES = GRID_SIZE + 1;
+
+/**
+ * A polygon corner, expanded as PFile used to add it to meshes.
+ */
+struct Corner{
+
+    /**
+     * Corner position.
+     */
+    Ogre::Vector3 position;
 
-BOOST_AUTO_TEST_CASE(TestVGearsPFile){
-    // TODO
-    BOOST_WARN_MESSAGE(false, "Unimplemented test file: VGearsPFile");
-    BOOST_CHECK(0 == 0);
+    /**
+     * Corner normal.
+     */
+    Ogre::Vector3 normal;
+
+    /**
+     * Corner colour.
+     */
+    Ogre::ColourValue colour;
+
+    /**
+     * Corner texture coordinate.
+     */
+    Ogre::Vector2 texture_coordinate;
+};
+
+/**
+ * Fills a P file with a textured grid, as a single group.
+ *
+ * The grid vertices are stored twice. Odd squares use the second copy. Polygons, vertices and
+ * texture coordinates of the group don't start at 0.
+ *
+ * @param[out] p_file The file to fill.
+ * @param[in] seam If true, the second copy of the vertices has different texture coordinates.
+ * If false, both copies are identical.
+ * @return The group.
+ */
+static VGears::PFile::Group BuildGrid(VGears::PFile& p_file, const bool seam){
+    VGears::PFile::Group group = {};
+    group.polygon_start_index = 1;
+    group.vertex_start_index = 2;
+    group.texture_coordinate_start_index = 3;
+    group.has_texture = 1;
+    p_file.GetPolygonDefinitions().push_back(VGears::PFile::PolygonDefinition());
+    for (int i = 0; i < 2; i ++) p_file.GetVertices().push_back(Ogre::Vector3(-1, -1, -1));
+    for (int i = 0; i < 2; i ++) p_file.GetVertexColors().push_back(Ogre::ColourValue::Black);
+    for (int i = 0; i < 3; i ++) p_file.GetTextureCoordinates().push_back(Ogre::Vector2(-1, -1));
+    for (int copy = 0; copy < 2; copy ++){
+        for (int y = 0; y < GRID_VERTICES; y ++){
+            for (int x = 0; x < GRID_VERTICES; x ++){
+                p_file.GetVertices().push_back(Ogre::Vector3(x * 10.0f, y * 10.0f, x * y));
+                p_file.GetVertexColors().push_back(Ogre::ColourValue(x / 4.0f, y / 4.0f, 0.5f));
+                p_file.GetTextureCoordinates().push_back(
+                  Ogre::Vector2(x / 4.0f, y / 4.0f + (seam ? copy : 0))
+                );
+                if (copy == 0) p_file.GetNormals().push_back(Ogre::Vector3(0, 0, 1));
+            }
+        }
+    }
+    for (int y = 0; y < GRID_SIZE; y ++){
+        for (int x = 0; x < GRID_SIZE; x ++){
+            const int base = (x + y) % 2 == 0 ? 0 : GRID_VERTICES * GRID_VERTICES;
+            const VGears::uint16 v00 = base + y * GRID_VERTICES + x;
+            const VGears::uint16 v10 = v00 + 1;
+            const VGears::uint16 v01 = v00 + GRID_VERTICES;
+            const VGears::uint16 v11 = v01 + 1;
+            VGears::PFile::PolygonDefinition polygon = {};
+            polygon.vertex[0] = v00;
+            polygon.vertex[1] = v10;
+            polygon.vertex[2] = v11;
+            for (int i = 0; i < 3; i ++) polygon.normal[i] = polygon.vertex[i] % 25;
+            p_file.GetPolygonDefinitions().push_back(polygon);
+            polygon.vertex[1] = v11;
+            polygon.vertex[2] = v01;
+            for (int i = 0; i < 3; i ++) polygon.normal[i] = polygon.vertex[i] % 25;
+            // One normal out of range, to use the default one.
+            if (x == 0 && y == 0) polygon.normal[0] = 1000;
+            p_file.GetPolygonDefinitions().push_back(polygon);
+        }
+    }
+    group.num_polygons = GRID_SIZE * GRID_SIZE * 2;
+    return group;
 }
 
+/**
+ * Expands the polygons of a group to one vertex per corner, as PFile used to.
+ *
+ * @param[in] p_file The P file.
+ * @param[in] group The group.
+ * @param[in] offset Position of the bone.
+ * @return The polygon corners, three per polygon.
+ */
+static std::vector<Corner> ExpandGroup(
+  VGears::PFile& p_file, const VGears::PFile::Group& group, const Ogre::Vector3& offset
+){
+    const Ogre::Quaternion rotation(Ogre::Radian(Ogre::Degree(180)), Ogre::Vector3::UNIT_X);
+    std::vector<Corner> corners;
+    const size_t polygon_end = group.polygon_start_index + group.num_polygons;
+    for (size_t p = group.polygon_start_index; p < polygon_end; p ++){
+        const VGears::PFile::PolygonDefinition& polygon(p_file.GetPolygonDefinitions()[p]);
+        for (int i = 3; i --;){
+            const VGears::uint32 v = group.vertex_start_index + polygon.vertex[i];
+            const VGears::uint32 n = polygon.normal[i];
+            const VGears::uint32 t = group.texture_coordinate_start_index + polygon.vertex[i];
+            Corner corner;
+            corner.position =
+              (rotation * (p_file.GetVertices()[v] / VGears::HRCFile::DOWN_SCALER)) + offset;
+            corner.colour = p_file.GetVertexColors()[v];
+            if (n < p_file.GetNormals().size()) corner.normal = rotation * p_file.GetNormals()[n];
+            else corner.normal = rotation * Ogre::Vector3(1.0f, 1.0f, 1.0f);
+            corner.texture_coordinate = p_file.GetTextureCoordinates()[t];
+            corners.push_back(corner);
+        }
+    }
+    return corners;
+}
+
+/**
+ * Checks that the welded geometry of a group draws the same triangles as the expanded one.
+ *
+ * @param[in] p_file The P file.
+ * @param[in] group The group.
+ * @param[in] geometry The welded group geometry.
+ * @param[in] offset Position of the bone.
+ */
+static void CheckTriangles(
+  VGears::PFile& p_file, const VGears::PFile::Group& group,
+  const VGears::PFile::GroupGeometry& geometry, const Ogre::Vector3& offset
+){
+    const std::vector<Corner> corners(ExpandGroup(p_file, group, offset));
+    BOOST_REQUIRE(geometry.indices.size() == corners.size());
+    BOOST_REQUIRE(geometry.normals.size() == geometry.positions.size());
+    BOOST_REQUIRE(geometry.colours.size() == geometry.positions.size());
+    BOOST_REQUIRE(geometry.texture_coordinates.size() == geometry.positions.size());
+    for (size_t c = 0; c < corners.size(); c ++){
+        const VGears::uint32 index = geometry.indices[c];
+        BOOST_REQUIRE(index < geometry.positions.size());
+        BOOST_CHECK(geometry.positions[index].positionEquals(corners[c].position, 1e-5f));
+        BOOST_CHECK(geometry.normals[index].positionEquals(corners[c].normal, 1e-5f));
+        BOOST_CHECK(geometry.colours[index] == corners[c].colour);
+        BOOST_CHECK(geometry.texture_coordinates[index] == corners[c].texture_coordinate);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestVGearsPFileWeldIdenticalVertices){
+    VGears::PFile p_file(nullptr, "test.p", 0, "General");
+    const VGears::PFile::Group group(BuildGrid(p_file, false));
+    const Ogre::Vector3 offset(0, 0, 2.5f);
+    VGears::PFile::GroupGeometry geometry;
+    p_file.BuildGroupGeometry(group, offset, geometry);
+    CheckTriangles(p_file, group, geometry, offset);
+    // Both copies of the grid are welded. Only the corner with the default normal is apart.
+    BOOST_CHECK(group.num_polygons * 3 == 96);
+    BOOST_CHECK(geometry.positions.size() == GRID_VERTICES * GRID_VERTICES + 1);
+}
+
+BOOST_AUTO_TEST_CASE(TestVGearsPFileKeepSeams){
+    VGears::PFile p_file(nullptr, "test.p", 0, "General");
+    const VGears::PFile::Group group(BuildGrid(p_file, true));
+    const Ogre::Vector3 offset(1, 2, 3);
+    VGears::PFile::GroupGeometry geometry;
+    p_file.BuildGroupGeometry(group, offset, geometry);
+    CheckTriangles(p_file, group, geometry, offset);
+    // Copies have different texture coordinates, so only corners of the same copy are welded.
+    std::set<VGears::uint16> used;
+    const size_t polygon_end = group.polygon_start_index + group.num_polygons;
+    for (size_t p = group.polygon_start_index; p < polygon_end; p ++)
+        for (int i = 0; i < 3; i ++) used.insert(p_file.GetPolygonDefinitions()[p].vertex[i]);
+    BOOST_CHECK(geometry.positions.size() == used.size() + 1);
+    BOOST_CHECK(geometry.positions.size() < group.num_polygons * 3);
+}
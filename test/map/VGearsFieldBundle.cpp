@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2022 The V-Gears Team
+ *
+ * This file is part of V-Gears
+ *
+ * V-Gears is free software: you can redistribute it and/or modify it under
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, version 3.0 (GPLv3) of the License.
+ *
+ * V-Gears is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ */
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <OgreLogManager.h>
+#include "core/XmlMapFile.h"
+#include "map/VGearsFieldBundle.h"
+
+/**
+ * Writes a text file.
+ *
+ * @param[in] path Path to the file.
+ * @param[in] content Contents of the file.
+ */
+static void WriteTextFile(const boost::filesystem::path& path, const std::string& content){
+    std::ofstream file(path.string(), std::ofstream::binary | std::ofstream::trunc);
+    file << content;
+}
+
+BOOST_AUTO_TEST_CASE(TestVGearsFieldBundleName){
+    BOOST_CHECK(VGears::FieldBundle::GetBundleName("md1_1/map.xml") == "md1_1/map.vgf");
+    BOOST_CHECK(VGears::FieldBundle::GetBundleName("wm0.xml") == "wm0.vgf");
+    BOOST_CHECK(VGears::FieldBundle::GetBundleName("md1.1/map") == "md1.1/map.vgf");
+}
+
+BOOST_AUTO_TEST_CASE(TestVGearsFieldBundleCompile){
+    std::unique_ptr<Ogre::LogManager> log_manager;
+    if (Ogre::LogManager::getSingletonPtr() == nullptr){
+        log_manager.reset(new Ogre::LogManager());
+        log_manager->createLog("v-gears-tests.log", true, false, true);
+    }
+    const boost::filesystem::path root(
+      boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()
+    );
+    boost::filesystem::create_directories(root / "test");
+    const std::string directory(root.string() + "/");
+    WriteTextFile(
+      root / "test/map.xml",
+      "<map>\n"
+      "    <walkmesh file_name=\"test/wm.xml\" />\n"
+      "    <movement_rotation degree=\"90\" />\n"
+      "    <background2d file_name=\"test/bg.xml\" />\n"
+      "    <texts file_name=\"test/text.xml\" />\n"
+      "    <entity_model name=\"cloud\" file_name=\"models/cloud.mesh\""
+      " position=\"1 2 3\" direction=\"45\" index=\"2\" />\n"
+      "    <entity_trigger name=\"gateway\" point1=\"1 1 0\" point2=\"2 2 0\" enabled=\"true\" />\n"
+      "    <entity_point name=\"spawn\" position=\"4 5 6\" rotation=\"180\" />\n"
+      "    <entity_model name=\"\" file_name=\"models/ignored.mesh\" />\n"
+      "    <entity_script name=\"director\" />\n"
+      "    <script file_name=\"test/script.lua\" />\n"
+      "    <tracks>\n"
+      "        <track id=\"0\" track_id=\"12\" />\n"
+      "        <track id=\"1\" track_id=\"34\" />\n"
+      "    </tracks>\n"
+      "</map>\n"
+    );
+    WriteTextFile(
+      root / "test/wm.xml",
+      "<walkmesh>\n"
+      "    <triangle a=\"0 0 0\" b=\"1 0 0\" c=\"0 1 0\" a_b=\"-1\" b_c=\"1\" c_a=\"-1\" />\n"
+      "    <triangle a=\"1 0 0\" b=\"1 1 0\" c=\"0 1 0\" a_b=\"-1\" b_c=\"-1\" c_a=\"0\" />\n"
+      "</walkmesh>\n"
+    );
+    WriteTextFile(
+      root / "test/bg.xml",
+      "<background2d image=\"test/tiles.png\" position=\"0 0 10\" fov=\"30\">\n"
+      "    <tile width=\"16\" height=\"16\" destination=\"-8 -8\" uv=\"0 0 0.5 0.5\""
+      " depth=\"0.25\" blending=\"add\">\n"
+      "        <animation name=\"flicker\" length=\"2\">\n"
+      "            <keyframe time=\"0\" uv=\"0 0 0.5 0.5\" />\n"
+      "            <keyframe time=\"1\" uv=\"0.5 0.5 1 1\" />\n"
+      "        </animation>\n"
+      "    </tile>\n"
+      "</background2d>\n"
+    );
+    const std::string texts("<texts>\n    <text name=\"hello\">Hello</text>\n</texts>\n");
+    WriteTextFile(root / "test/text.xml", texts);
+    const std::string script("EntityContainer = {}\nload_field_map_request(\"md1_2\", \"\")\n");
+    WriteTextFile(root / "test/script.lua", script);
+
+    VGears::FieldBundle::Compile(directory, "test/map.xml");
+    BOOST_CHECK(boost::filesystem::is_regular_file(root / "test/map.vgf"));
+    BOOST_CHECK(!boost::filesystem::exists(root / "test/map.vgf.tmp"));
+
+    VGears::FieldBundle bundle;
+    BOOST_REQUIRE(bundle.Open(directory, "test/map.xml"));
+    // The entity model without name is skipped, each track is a record.
+    const VGears::FieldBundle::RecordList& records(bundle.GetRecords());
+    BOOST_REQUIRE(records.size() == 11);
+    BOOST_CHECK(records[0].type == VGears::FieldBundle::RecordType::WALKMESH);
+    BOOST_CHECK(records[1].type == VGears::FieldBundle::RecordType::MOVEMENT_ROTATION);
+    BOOST_CHECK(records[1].angle == 90);
+    BOOST_CHECK(records[4].type == VGears::FieldBundle::RecordType::ENTITY_MODEL);
+    BOOST_CHECK(records[4].name == "cloud");
+    BOOST_CHECK(records[4].file_name == "models/cloud.mesh");
+    BOOST_CHECK(records[4].position == Ogre::Vector3(1, 2, 3));
+    BOOST_CHECK(records[4].angle == 45);
+    BOOST_CHECK(records[4].scale == Ogre::Vector3::UNIT_SCALE);
+    BOOST_CHECK(records[4].index == 2);
+    BOOST_CHECK(records[5].type == VGears::FieldBundle::RecordType::ENTITY_TRIGGER);
+    BOOST_CHECK(records[5].point2 == Ogre::Vector3(2, 2, 0));
+    BOOST_CHECK(records[5].enabled);
+    BOOST_CHECK(records[6].type == VGears::FieldBundle::RecordType::ENTITY_POINT);
+    BOOST_CHECK(records[6].angle == 180);
+    BOOST_CHECK(records[7].type == VGears::FieldBundle::RecordType::ENTITY_SCRIPT);
+    BOOST_CHECK(records[8].type == VGears::FieldBundle::RecordType::SCRIPT);
+    BOOST_CHECK(records[10].type == VGears::FieldBundle::RecordType::TRACK);
+    BOOST_CHECK(records[10].index == 1);
+    BOOST_CHECK(records[10].track == 34);
+    BOOST_CHECK(bundle.GetSources().size() == 5);
+
+    const VGears::WalkmeshFilePtr walkmesh(bundle.GetWalkmeshes().at("test/wm.xml"));
+    BOOST_REQUIRE(walkmesh->GetTriangles().size() == 2);
+    BOOST_CHECK(walkmesh->GetTriangles()[0].b == Ogre::Vector3(1, 0, 0));
+    BOOST_CHECK(walkmesh->GetTriangles()[0].access_side[1] == 1);
+    BOOST_CHECK(walkmesh->GetTriangles()[1].access_side[2] == 0);
+
+    const VGears::Background2DFilePtr background(bundle.GetBackgrounds().at("test/bg.xml"));
+    BOOST_CHECK(background->GetTextureName() == "test/tiles.png");
+    BOOST_CHECK(background->GetPosition() == Ogre::Vector3(0, 0, 10));
+    BOOST_CHECK(Ogre::Math::RealEqual(background->GetFov().valueDegrees(), 30, 0.001f));
+    BOOST_REQUIRE(background->GetTiles().size() == 1);
+    const VGears::Tile& tile(background->GetTiles()[0]);
+    BOOST_CHECK(tile.width == 16);
+    BOOST_CHECK(tile.destination == Ogre::Vector2(-8, -8));
+    BOOST_CHECK(tile.depth == 0.25f);
+    BOOST_CHECK(tile.blending == VGears::B_ADD);
+    BOOST_REQUIRE(tile.animations.count("flicker") == 1);
+    BOOST_REQUIRE(tile.animations.at("flicker").key_frames.size() == 2);
+    BOOST_CHECK(tile.animations.at("flicker").key_frames[1].uv == Ogre::Vector4(0.5, 0.5, 1, 1));
+
+    BOOST_CHECK(bundle.GetTexts().at("test/text.xml") == texts);
+    // Scripts are stored as LuaJIT bytecode, which starts with "\x1bLJ".
+    BOOST_CHECK(bundle.GetScripts().at("test/script.lua").compare(0, 3, "\x1bLJ") == 0);
+    BOOST_REQUIRE(bundle.GetGateways().size() == 1);
+    BOOST_CHECK(bundle.GetGateways()[0] == "md1_2");
+
+    // Editing any source file invalidates the bundle.
+    WriteTextFile(root / "test/text.xml", "<texts>\n</texts>\n");
+    BOOST_CHECK(!bundle.Open(directory, "test/map.xml"));
+
+    boost::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(TestVGearsFieldBundleCompileScript){
+    std::unique_ptr<Ogre::LogManager> log_manager;
+    if (Ogre::LogManager::getSingletonPtr() == nullptr){
+        log_manager.reset(new Ogre::LogManager());
+        log_manager->createLog("v-gears-tests.log", true, false, true);
+    }
+    // Scripts that don't compile are kept as source, so the error is reported when run.
+    const std::string broken("function (");
+    BOOST_CHECK(VGears::FieldBundle::CompileScript(broken, "@broken.lua") == broken);
+}
+
+BOOST_AUTO_TEST_CASE(TestVGearsFieldBundleFindGateways){
+    std::vector<std::string> gateways{"md1_1"};
+    VGears::FieldBundle::FindGateways(
+      "load_field_map_request = function(map_name, point_name)\n"
+      "        load_field_map_request(\"md1_2\", \"gateway0\")\n"
+      "        load_field_map_request( 'nmkin_1', \"\")\n"
+      "        -- load_field_map_request(\"startmap\", \"\")\n"
+      "        load_field_map_request(\"md1_1\", \"\")\n"
+      "        load_field_map_request(\"md1_2\", \"gateway1\")\n"
+      "        load_field_map_request(map_name, \"\")\n",
+      gateways
+    );
+    BOOST_REQUIRE(gateways.size() == 3);
+    BOOST_CHECK(gateways[1] == "md1_2");
+    BOOST_CHECK(gateways[2] == "nmkin_1");
+}
+
+BOOST_AUTO_TEST_CASE(TestVGearsFieldBundleReadScripts){
+    const boost::filesystem::path root(
+      boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()
+    );
+    boost::filesystem::create_directories(root / "test");
+    const std::string directory(root.string() + "/");
+    const std::string script("load_field_map_request(\"md1_2\", \"\")\n");
+    WriteTextFile(root / "test/script.lua", script);
+    WriteTextFile(root / "test/compiled.lua", "load_field_map_request(\"nmkin_1\", \"\")\n");
+    WriteTextFile(root / "test/compiled.luac", "\x1bLJ");
+    boost::filesystem::last_write_time(
+      root / "test/compiled.luac",
+      boost::filesystem::last_write_time(root / "test/compiled.lua") + 1
+    );
+
+    VGears::FieldBundle bundle;
+    VGears::FieldBundle::Record record;
+    record.type = VGears::FieldBundle::RecordType::SCRIPT;
+    record.file_name = "test/script.lua";
+    bundle.GetRecords().push_back(record);
+    record.file_name = "test/compiled.lua";
+    bundle.GetRecords().push_back(record);
+    record.file_name = "test/missing.lua";
+    bundle.GetRecords().push_back(record);
+    XmlMapFile::ReadScripts(directory, bundle);
+
+    // Every script is scanned, the fields to preload are the gateway destinations.
+    BOOST_REQUIRE(bundle.GetGateways().size() == 2);
+    BOOST_CHECK(bundle.GetGateways()[0] == "md1_2");
+    BOOST_CHECK(bundle.GetGateways()[1] == "nmkin_1");
+    // The text is kept to be run, unless the precompiled script is run instead.
+    BOOST_REQUIRE(bundle.GetScripts().size() == 1);
+    BOOST_CHECK(bundle.GetScripts().at("test/script.lua") == script);
+
+    boost::filesystem::remove_all(root);
+}